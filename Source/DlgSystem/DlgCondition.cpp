@@ -7,19 +7,68 @@
 #include "Nodes/DlgNode.h"
 #include "NYReflectionHelper.h"
 #include "Kismet/GameplayStatics.h"
+#include "HAL/PlatformTime.h"
 #include "DlgDialogueParticipant.h"
+#include "DlgNativeParticipant.h"
 #include "DlgHelper.h"
 #include "Logging/DlgLogger.h"
+#include "DlgStats.h"
+
+namespace DlgConditionParticipantValue
+{
+	static EDlgParticipantValueType GetValueType(EDlgConditionType ConditionType)
+	{
+		switch (ConditionType)
+		{
+			case EDlgConditionType::BoolCall:
+				return EDlgParticipantValueType::Bool;
+			case EDlgConditionType::IntCall:
+				return EDlgParticipantValueType::Int;
+			case EDlgConditionType::FloatCall:
+				return EDlgParticipantValueType::Float;
+			case EDlgConditionType::NameCall:
+				return EDlgParticipantValueType::Name;
+			default:
+				check(ConditionType == EDlgConditionType::EventCall);
+				return EDlgParticipantValueType::Condition;
+		}
+	}
+}
 
 bool FDlgCondition::EvaluateArray(const UDlgContext& Context, const TArray<FDlgCondition>& ConditionsArray, const FGameplayTag& DefaultParticipantTag)
 {
+	DLG_SCOPE_CYCLE_COUNTER(EvaluateConditions);
 	bool bHasAnyWeak = false;
 	bool bHasSuccessfulWeak = false;
 
+	TArray<const UObject*, TInlineAllocator<8>> Participants;
+	bool bHasNativeParticipant = false;
 	for (const FDlgCondition& Condition : ConditionsArray)
 	{
 		const FGameplayTag ParticipantTag = UBSDlgFunctions::IsValidParticipantTag(Condition.ParticipantTag)? Condition.ParticipantTag : DefaultParticipantTag;
-		const bool bSatisfied = Condition.IsConditionMet(Context, Context.GetParticipant(ParticipantTag));
+		const UObject* Participant = Context.GetParticipant(ParticipantTag);
+		Participants.Add(Participant);
+		bHasNativeParticipant = bHasNativeParticipant || Cast<const IDlgNativeParticipant>(Participant) != nullptr;
+	}
+
+	// Read the values of the native participants up front, with one call per participant
+	TArray<int32, TInlineAllocator<8>> NativeValueIndices;
+	FDlgParticipantValueBatch NativeValues;
+	if (bHasNativeParticipant)
+	{
+		for (int32 Index = 0; Index < ConditionsArray.Num(); Index++)
+		{
+			NativeValueIndices.Add(ConditionsArray[Index].AddParticipantValue(NativeValues, Participants[Index]));
+		}
+		NativeValues.Read(Context);
+	}
+
+	for (int32 Index = 0; Index < ConditionsArray.Num(); Index++)
+	{
+		const FDlgCondition& Condition = ConditionsArray[Index];
+		const bool bHasNativeValue = NativeValueIndices.IsValidIndex(Index) && NativeValueIndices[Index] != INDEX_NONE;
+		const FDlgParticipantValue* NativeValue = bHasNativeValue ? &NativeValues.GetValue(NativeValueIndices[Index]) : nullptr;
+		const bool bSatisfied = EvaluateSingle(Context, Condition, Participants[Index], NativeValue);
 		if (Condition.Strength == EDlgConditionStrength::Weak)
 		{
 			bHasAnyWeak = true;
@@ -35,8 +84,30 @@ bool FDlgCondition::EvaluateArray(const UDlgContext& Context, const TArray<FDlgC
 	return bHasSuccessfulWeak || !bHasAnyWeak;
 }
 
-bool FDlgCondition::IsConditionMet(const UDlgContext& Context, const UObject* Participant) const
+bool FDlgCondition::EvaluateSingle(
+	const UDlgContext& Context,
+	const FDlgCondition& Condition,
+	const UObject* Participant,
+	const FDlgParticipantValue* NativeValue
+)
+{
+#if WITH_GAMEPLAY_DEBUGGER
+	const double StartTime = FDlgContextStepDebugInfo::bEnabled ? FPlatformTime::Seconds() : 0.0;
+#endif
+	const bool bSatisfied = Condition.IsConditionMet(Context, Participant, NativeValue);
+	DLG_CONTEXT_TRACE(Context, AddCondition(Context.GetActiveNodeIndex(), Condition, bSatisfied));
+#if WITH_GAMEPLAY_DEBUGGER
+	if (FDlgContextStepDebugInfo::bEnabled)
+	{
+		Context.RecordConditionDebugInfo(Condition, FPlatformTime::Seconds() - StartTime);
+	}
+#endif
+	return bSatisfied;
+}
+
+bool FDlgCondition::IsConditionMet(const UDlgContext& Context, const UObject* Participant, const FDlgParticipantValue* NativeValue) const
 {
+	DLG_INC_COUNTER(ConditionsEvaluated);
 	bool bHasParticipant = true;
 	if (IsParticipantInvolved())
 	{
@@ -48,13 +119,15 @@ bool FDlgCondition::IsConditionMet(const UDlgContext& Context, const UObject* Pa
 	{
 		if (CustomCondition == nullptr)
 		{
-			FDlgLogger::Get().Errorf(
+			DLG_LOG_ERROR_RATE_LIMITED(
 				TEXT("Custom Condition is empty (not valid). IsConditionMet returning false.\nContext:\n\t%s, Participant = %s"),
 				*Context.GetContextString(), Participant ? *Participant->GetPathName() : TEXT("INVALID")
 			);
 			return false;
 		}
 
+		DLG_TRACE_SCOPE(DlgCondition_Custom);
+		DLG_INC_COUNTER(ParticipantCalls);
 		return CustomCondition->IsConditionMet(&Context, Participant);
 	}
 
@@ -66,39 +139,74 @@ bool FDlgCondition::IsConditionMet(const UDlgContext& Context, const UObject* Pa
 	switch (ConditionType)
 	{
 		case EDlgConditionType::EventCall:
-			return IDlgDialogueParticipant::Execute_CheckCondition(Participant, &Context, CallbackName) == bBoolValue;
+			{
+				DLG_TRACE_SCOPE(DlgCondition_EventCall);
+				const bool bResult = ReadParticipantValue(Context, Participant, NativeValue).bBoolValue;
+				DLG_CONTEXT_TRACE(Context, SetObservedValues(bResult, bBoolValue));
+				return bResult == bBoolValue;
+			}
 
 		case EDlgConditionType::BoolCall:
-			return CheckBool(Context, IDlgDialogueParticipant::Execute_GetBoolValue(Participant, CallbackName));
+			{
+				DLG_TRACE_SCOPE(DlgCondition_BoolCall);
+				return CheckBool(Context, ReadParticipantValue(Context, Participant, NativeValue).bBoolValue);
+			}
 
 		case EDlgConditionType::FloatCall:
-			return CheckFloat(Context, static_cast<double>(IDlgDialogueParticipant::Execute_GetFloatValue(Participant, CallbackName)));
+			{
+				DLG_TRACE_SCOPE(DlgCondition_FloatCall);
+				return CheckFloat(Context, static_cast<double>(ReadParticipantValue(Context, Participant, NativeValue).FloatValue));
+			}
 
 		case EDlgConditionType::IntCall:
-			return CheckInt(Context, IDlgDialogueParticipant::Execute_GetIntValue(Participant, CallbackName));
+			{
+				DLG_TRACE_SCOPE(DlgCondition_IntCall);
+				return CheckInt(Context, ReadParticipantValue(Context, Participant, NativeValue).IntValue);
+			}
 
 		case EDlgConditionType::NameCall:
-			return CheckName(Context, IDlgDialogueParticipant::Execute_GetNameValue(Participant, CallbackName));
+			{
+				DLG_TRACE_SCOPE(DlgCondition_NameCall);
+				return CheckName(Context, ReadParticipantValue(Context, Participant, NativeValue).NameValue);
+			}
 
 
 		case EDlgConditionType::ClassBoolVariable:
-			return CheckBool(Context, FNYReflectionHelper::GetVariable<FBoolProperty, bool>(Participant, CallbackName));
+			{
+				DLG_TRACE_SCOPE(DlgCondition_ClassBoolVariable);
+				return CheckBool(Context, FNYReflectionHelper::GetVariable<FBoolProperty, bool>(Participant, CallbackName));
+			}
 
 		case EDlgConditionType::ClassFloatVariable:
-			return CheckFloat(Context, FNYReflectionHelper::GetVariable<FDoubleProperty, double>(Participant, CallbackName));
+			{
+				DLG_TRACE_SCOPE(DlgCondition_ClassFloatVariable);
+				return CheckFloat(Context, FNYReflectionHelper::GetVariable<FDoubleProperty, double>(Participant, CallbackName));
+			}
 
 		case EDlgConditionType::ClassIntVariable:
-			return CheckInt(Context, FNYReflectionHelper::GetVariable<FIntProperty, int32>(Participant, CallbackName));
+			{
+				DLG_TRACE_SCOPE(DlgCondition_ClassIntVariable);
+				return CheckInt(Context, FNYReflectionHelper::GetVariable<FIntProperty, int32>(Participant, CallbackName));
+			}
 
 		case EDlgConditionType::ClassNameVariable:
-			return CheckName(Context, FNYReflectionHelper::GetVariable<FNameProperty, FName>(Participant, CallbackName));
+			{
+				DLG_TRACE_SCOPE(DlgCondition_ClassNameVariable);
+				return CheckName(Context, FNYReflectionHelper::GetVariable<FNameProperty, FName>(Participant, CallbackName));
+			}
 
 
 		case EDlgConditionType::WasNodeVisited:
-			return Context.IsNodeVisited(IntValue, GUID, !bLongTermMemory) == bBoolValue;
+			{
+				DLG_TRACE_SCOPE(DlgCondition_WasNodeVisited);
+				const bool bVisited = Context.IsNodeVisited(IntValue, GUID, !bLongTermMemory);
+				DLG_CONTEXT_TRACE(Context, SetObservedValues(bVisited, bBoolValue));
+				return bVisited == bBoolValue;
+			}
 
 		case EDlgConditionType::HasSatisfiedChild:
 			{
+				DLG_TRACE_SCOPE(DlgCondition_HasSatisfiedChild);
 				// Use the GUID if it is valid as it is more reliable
 				const UDlgNode* Node = GUID.IsValid() ? Context.GetNodeFromGUID(GUID) : Context.GetNodeFromIndex(IntValue);
 				return Node != nullptr ? Node->HasAnySatisfiedChild(Context, {}) == bBoolValue : false;
@@ -123,7 +231,7 @@ bool FDlgCondition::CheckFloat(const UDlgContext& Context, double Value) const
 
 		if (CompareType == EDlgCompare::ToVariable)
 		{
-			ValueToCheckAgainst = static_cast<double>(IDlgDialogueParticipant::Execute_GetFloatValue(OtherParticipant, OtherVariableName));
+			ValueToCheckAgainst = static_cast<double>(Context.ReadParticipantValue(OtherParticipant, EDlgParticipantValueType::Float, OtherVariableName).FloatValue);
 		}
 		else
 		{
@@ -131,6 +239,7 @@ bool FDlgCondition::CheckFloat(const UDlgContext& Context, double Value) const
 		}
 	}
 
+	DLG_CONTEXT_TRACE(Context, SetObservedValues(Value, ValueToCheckAgainst));
 	switch (Operation)
 	{
 		case EDlgOperation::Equal:
@@ -152,7 +261,7 @@ bool FDlgCondition::CheckFloat(const UDlgContext& Context, double Value) const
 			return !FMath::IsNearlyEqual(Value, ValueToCheckAgainst);
 
 		default:
-			FDlgLogger::Get().Errorf(
+			DLG_LOG_ERROR_RATE_LIMITED(
 				TEXT("Invalid Operation in float based condition.\nContext:\n\t%s"),
 				*Context.GetContextString()
 			);
@@ -173,7 +282,7 @@ bool FDlgCondition::CheckInt(const UDlgContext& Context, int32 Value) const
 
 		if (CompareType == EDlgCompare::ToVariable)
 		{
-			ValueToCheckAgainst = IDlgDialogueParticipant::Execute_GetIntValue(OtherParticipant, OtherVariableName);
+			ValueToCheckAgainst = Context.ReadParticipantValue(OtherParticipant, EDlgParticipantValueType::Int, OtherVariableName).IntValue;
 		}
 		else
 		{
@@ -181,6 +290,7 @@ bool FDlgCondition::CheckInt(const UDlgContext& Context, int32 Value) const
 		}
 	}
 
+	DLG_CONTEXT_TRACE(Context, SetObservedValues(Value, ValueToCheckAgainst));
 	switch (Operation)
 	{
 		case EDlgOperation::Equal:
@@ -202,7 +312,7 @@ bool FDlgCondition::CheckInt(const UDlgContext& Context, int32 Value) const
 			return Value != ValueToCheckAgainst;
 
 		default:
-			FDlgLogger::Get().Errorf(
+			DLG_LOG_ERROR_RATE_LIMITED(
 				TEXT("Invalid Operation in int based condition.\nContext:\n\t%s"),
 				*Context.GetContextString()
 			);
@@ -224,7 +334,7 @@ bool FDlgCondition::CheckBool(const UDlgContext& Context, bool bValue) const
 		bool bValueToCheckAgainst;
 		if (CompareType == EDlgCompare::ToVariable)
 		{
-			bValueToCheckAgainst = IDlgDialogueParticipant::Execute_GetBoolValue(OtherParticipant, OtherVariableName);
+			bValueToCheckAgainst = Context.ReadParticipantValue(OtherParticipant, EDlgParticipantValueType::Bool, OtherVariableName).bBoolValue;
 		}
 		else
 		{
@@ -233,6 +343,11 @@ bool FDlgCondition::CheckBool(const UDlgContext& Context, bool bValue) const
 
 		// Check if value matches other variable
 		bResult = bValue == bValueToCheckAgainst;
+		DLG_CONTEXT_TRACE(Context, SetObservedValues(bValue, bValueToCheckAgainst));
+	}
+	else
+	{
+		DLG_CONTEXT_TRACE(Context, SetObservedValues(bValue, bBoolValue));
 	}
 
 	return bResult == bBoolValue;
@@ -251,7 +366,7 @@ bool FDlgCondition::CheckName(const UDlgContext& Context, FName Value) const
 
 		if (CompareType == EDlgCompare::ToVariable)
 		{
-			ValueToCheckAgainst = IDlgDialogueParticipant::Execute_GetNameValue(OtherParticipant, OtherVariableName);
+			ValueToCheckAgainst = Context.ReadParticipantValue(OtherParticipant, EDlgParticipantValueType::Name, OtherVariableName).NameValue;
 		}
 		else
 		{
@@ -259,10 +374,32 @@ bool FDlgCondition::CheckName(const UDlgContext& Context, FName Value) const
 		}
 	}
 
+	DLG_CONTEXT_TRACE(Context, SetObservedNames(Value, ValueToCheckAgainst));
 	const bool bResult = ValueToCheckAgainst == Value;
 	return bResult == bBoolValue;
 }
 
+int32 FDlgCondition::AddParticipantValue(FDlgParticipantValueBatch& Batch, const UObject* Participant) const
+{
+	// Invalid participants are left to IsConditionMet, it logs them.
+	// CheckCondition often does more than read a value, it is only called if the condition is evaluated.
+	if (!HasDialogueValue(ConditionType) || !IsValid(Participant))
+	{
+		return INDEX_NONE;
+	}
+	return Batch.Add(Participant, DlgConditionParticipantValue::GetValueType(ConditionType), CallbackName);
+}
+
+FDlgParticipantValue FDlgCondition::ReadParticipantValue(const UDlgContext& Context, const UObject* Participant, const FDlgParticipantValue* NativeValue) const
+{
+	if (NativeValue != nullptr)
+	{
+		return *NativeValue;
+	}
+
+	return Context.ReadParticipantValue(Participant, DlgConditionParticipantValue::GetValueType(ConditionType), CallbackName);
+}
+
 bool FDlgCondition::ValidateIsParticipantValid(const UDlgContext& Context, const FString& ContextString, const UObject* Participant) const
 {
 	if (IsValid(Participant))
@@ -270,7 +407,7 @@ bool FDlgCondition::ValidateIsParticipantValid(const UDlgContext& Context, const
 		return true;
 	}
 
-	FDlgLogger::Get().Errorf(
+	DLG_LOG_ERROR_RATE_LIMITED(
 		TEXT("%s FAILED because the PARTICIPANT is INVALID.\nContext:\n\t%s, ConditionType = %s"),
 		*ContextString, *Context.GetContextString(), *ConditionTypeToString(ConditionType)
 	);
@@ -10,6 +10,8 @@
 class IDlgDialogueParticipant;
 class UDlgContext;
 class UDlgDialogue;
+struct FDlgParticipantValue;
+struct FDlgParticipantValueBatch;
 
 // Defines the way the condition is interpreted inside a condition array
 UENUM(BlueprintType)
@@ -132,8 +134,23 @@ public:
 	// Own methods
 	//
 
+	// Evaluates the conditions in authoring order, for the cached cost ordered version see FDlgConditionProgram
 	static bool EvaluateArray(const UDlgContext& Context, const TArray<FDlgCondition>& ConditionsArray, const FGameplayTag& DefaultParticipantTag = FGameplayTag::EmptyTag);
-	bool IsConditionMet(const UDlgContext& Context, const UObject* Participant) const;
+
+	// IsConditionMet for one condition of a condition array, also records it in the context trace and the gameplay debugger
+	static bool EvaluateSingle(
+		const UDlgContext& Context,
+		const FDlgCondition& Condition,
+		const UObject* Participant,
+		const FDlgParticipantValue* NativeValue = nullptr
+	);
+
+	// NativeValue is the participant value already read by a FDlgParticipantValueBatch, nullptr if it is read here
+	bool IsConditionMet(const UDlgContext& Context, const UObject* Participant, const FDlgParticipantValue* NativeValue = nullptr) const;
+
+	// Adds the participant value this condition reads to Batch, EventCall is never added
+	// @return the index of the value in Batch or INDEX_NONE if there is no value or Participant is not a IDlgNativeParticipant
+	int32 AddParticipantValue(FDlgParticipantValueBatch& Batch, const UObject* Participant) const;
 
 	// returns true if ParticipantName has to belong to match with a valid Participant in order for the condition type to work */
 	bool IsParticipantInvolved() const;
@@ -214,6 +231,9 @@ protected:
 	bool CheckBool(const UDlgContext& Context, bool bValue) const;
 	bool CheckName(const UDlgContext& Context, FName Value) const;
 
+	// Value of the participant interface condition types (HasParticipantInterfaceValue)
+	FDlgParticipantValue ReadParticipantValue(const UDlgContext& Context, const UObject* Participant, const FDlgParticipantValue* NativeValue) const;
+
 	// Checks Participant, prints warning if it is nullptr
 	bool ValidateIsParticipantValid(const UDlgContext& Context, const FString& ContextString, const UObject* Participant) const;
 
@@ -0,0 +1,282 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#include "DlgConditionProgram.h"
+
+#include "Algo/StableSort.h"
+
+#include "DlgCondition.h"
+#include "DlgConditionCustom.h"
+#include "DlgContext.h"
+#include "DlgHelper.h"
+#include "DlgNativeParticipant.h"
+#include "DlgStats.h"
+
+namespace DlgConditionProgram
+{
+	// Only the value conditions look at the other participant, the rest ignore CompareType
+	static bool UsesOtherParticipant(const FDlgCondition& Condition)
+	{
+		return Condition.CompareType != EDlgCompare::ToConst
+			&& (FDlgCondition::HasDialogueValue(Condition.ConditionType) || FDlgCondition::HasClassVariable(Condition.ConditionType));
+	}
+
+	static int32 FindOrAddSlot(TArray<FGameplayTag, TInlineAllocator<2>>& ParticipantTags, const FGameplayTag& ParticipantTag)
+	{
+		const int32 Slot = ParticipantTags.IndexOfByKey(ParticipantTag);
+		return Slot != INDEX_NONE ? Slot : ParticipantTags.Add(ParticipantTag);
+	}
+}
+
+TSharedRef<const FDlgConditionProgram> FDlgConditionProgram::Compile(const TArray<FDlgCondition>& Conditions, const FGameplayTag& DefaultParticipantTag)
+{
+	using namespace DlgConditionProgram;
+
+	TSharedRef<FDlgConditionProgram> Program = MakeShared<FDlgConditionProgram>();
+	Program->SourceData = Conditions.GetData();
+	Program->SourceNum = Conditions.Num();
+	Program->DefaultParticipantTag = DefaultParticipantTag;
+
+	for (int32 ConditionIndex = 0; ConditionIndex < Conditions.Num(); ConditionIndex++)
+	{
+		const FDlgCondition& Condition = Conditions[ConditionIndex];
+		const FGameplayTag ParticipantTag = UBSDlgFunctions::IsValidParticipantTag(Condition.ParticipantTag) ? Condition.ParticipantTag : DefaultParticipantTag;
+
+		FDlgConditionInstruction Instruction;
+		Instruction.ConditionIndex = ConditionIndex;
+		Instruction.ParticipantSlot = FindOrAddSlot(Program->ParticipantTags, ParticipantTag);
+		Instruction.Cost = EstimateCost(Condition);
+
+		// Same as FDlgCondition::IsParticipantInvolved, without dereferencing an empty custom condition
+		const bool bParticipantInvolved = Condition.ConditionType == EDlgConditionType::Custom
+			? Condition.CustomCondition != nullptr && Condition.CustomCondition->IsParticipantInvolved()
+			: Condition.IsParticipantInvolved();
+		if (bParticipantInvolved)
+		{
+			Program->RequiredParticipantSlots.AddUnique(Instruction.ParticipantSlot);
+			if (UsesOtherParticipant(Condition))
+			{
+				Program->RequiredParticipantSlots.AddUnique(FindOrAddSlot(Program->ParticipantTags, Condition.OtherParticipantTag));
+			}
+		}
+
+		if (Condition.Strength == EDlgConditionStrength::Weak)
+		{
+			Program->WeakInstructions.Add(Instruction);
+		}
+		else
+		{
+			Program->StrongInstructions.Add(Instruction);
+		}
+	}
+
+	// Stable, so the same cost keeps the authoring order
+	auto ByCost = [](const FDlgConditionInstruction& A, const FDlgConditionInstruction& B) { return A.Cost < B.Cost; };
+	Algo::StableSort(Program->StrongInstructions, ByCost);
+	Algo::StableSort(Program->WeakInstructions, ByCost);
+
+	return Program;
+}
+
+bool FDlgConditionProgram::EvaluateCached(
+	TSharedPtr<const FDlgConditionProgram>& CachedProgram,
+	const UDlgContext& Context,
+	const TArray<FDlgCondition>& Conditions,
+	const FGameplayTag& DefaultParticipantTag
+)
+{
+	if (Conditions.Num() == 0)
+	{
+		return true;
+	}
+
+	if (!CachedProgram.IsValid() || !CachedProgram->IsCompiledFrom(Conditions, DefaultParticipantTag))
+	{
+		// Never modify a program in place, copied edges share it
+		CachedProgram = Compile(Conditions, DefaultParticipantTag);
+	}
+	return CachedProgram->Evaluate(Context, Conditions);
+}
+
+bool FDlgConditionProgram::Evaluate(const UDlgContext& Context, const TArray<FDlgCondition>& Conditions) const
+{
+	check(IsCompiledFrom(Conditions, DefaultParticipantTag));
+
+	TArray<const UObject*, TInlineAllocator<4>> Participants;
+	Participants.Reserve(ParticipantTags.Num());
+	for (const FGameplayTag& ParticipantTag : ParticipantTags)
+	{
+		Participants.Add(Context.GetParticipant(ParticipantTag));
+	}
+
+	// Let the conditions log the invalid participants in the same order as before
+	for (const int32 Slot : RequiredParticipantSlots)
+	{
+		if (!IsValid(Participants[Slot]))
+		{
+			return FDlgCondition::EvaluateArray(Context, Conditions, DefaultParticipantTag);
+		}
+	}
+
+	DLG_SCOPE_CYCLE_COUNTER(EvaluateConditions);
+
+	// The values of the native participants are read for a whole group, with one call per participant
+	const bool bHasNativeParticipant = Participants.ContainsByPredicate([](const UObject* Participant)
+	{
+		return Cast<const IDlgNativeParticipant>(Participant) != nullptr;
+	});
+	FDlgParticipantValueBatch NativeValues;
+	TArray<int32, TInlineAllocator<8>> NativeValueIndices;
+	auto ReadNativeValues = [&](const TArray<FDlgConditionInstruction>& Instructions)
+	{
+		NativeValues.Reset();
+		NativeValueIndices.Reset();
+		if (!bHasNativeParticipant)
+		{
+			return;
+		}
+		for (const FDlgConditionInstruction& Instruction : Instructions)
+		{
+			NativeValueIndices.Add(Conditions[Instruction.ConditionIndex].AddParticipantValue(NativeValues, Participants[Instruction.ParticipantSlot]));
+		}
+		NativeValues.Read(Context);
+	};
+	auto EvaluateInstruction = [&](const TArray<FDlgConditionInstruction>& Instructions, int32 Index)
+	{
+		const FDlgConditionInstruction& Instruction = Instructions[Index];
+		const bool bHasNativeValue = NativeValueIndices.IsValidIndex(Index) && NativeValueIndices[Index] != INDEX_NONE;
+		return FDlgCondition::EvaluateSingle(
+			Context,
+			Conditions[Instruction.ConditionIndex],
+			Participants[Instruction.ParticipantSlot],
+			bHasNativeValue ? &NativeValues.GetValue(NativeValueIndices[Index]) : nullptr
+		);
+	};
+
+	ReadNativeValues(StrongInstructions);
+	for (int32 Index = 0; Index < StrongInstructions.Num(); Index++)
+	{
+		if (!EvaluateInstruction(StrongInstructions, Index))
+		{
+			return false;
+		}
+	}
+
+	if (WeakInstructions.Num() == 0)
+	{
+		return true;
+	}
+	ReadNativeValues(WeakInstructions);
+	for (int32 Index = 0; Index < WeakInstructions.Num(); Index++)
+	{
+		if (EvaluateInstruction(WeakInstructions, Index))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+EDlgConditionConstant FDlgConditionProgram::FoldConstants(
+	TArray<FDlgCondition>& Conditions,
+	TFunctionRef<EDlgConditionConstant(const FDlgCondition&)> GetConstant
+)
+{
+	TArray<EDlgConditionConstant> Constants;
+	Constants.Reserve(Conditions.Num());
+	int32 NeverSatisfiedIndex = INDEX_NONE;
+	int32 NeverSatisfiedWeakIndex = INDEX_NONE;
+	int32 NumWeak = 0;
+	int32 NumUnknownWeak = 0;
+	bool bHasAlwaysSatisfiedWeak = false;
+	for (int32 Index = 0; Index < Conditions.Num(); Index++)
+	{
+		const EDlgConditionConstant Constant = GetConstant(Conditions[Index]);
+		Constants.Add(Constant);
+		if (Conditions[Index].Strength == EDlgConditionStrength::Weak)
+		{
+			NumWeak++;
+			NumUnknownWeak += Constant == EDlgConditionConstant::Unknown ? 1 : 0;
+			bHasAlwaysSatisfiedWeak |= Constant == EDlgConditionConstant::AlwaysTrue;
+			if (Constant == EDlgConditionConstant::AlwaysFalse && NeverSatisfiedWeakIndex == INDEX_NONE)
+			{
+				NeverSatisfiedWeakIndex = Index;
+			}
+		}
+		else if (Constant == EDlgConditionConstant::AlwaysFalse && NeverSatisfiedIndex == INDEX_NONE)
+		{
+			NeverSatisfiedIndex = Index;
+		}
+	}
+
+	// None of the weak conditions can be satisfied
+	if (NeverSatisfiedIndex == INDEX_NONE && NumWeak > 0 && NumUnknownWeak == 0 && !bHasAlwaysSatisfiedWeak)
+	{
+		NeverSatisfiedIndex = NeverSatisfiedWeakIndex;
+	}
+	if (NeverSatisfiedIndex != INDEX_NONE)
+	{
+		const FDlgCondition NeverSatisfied = Conditions[NeverSatisfiedIndex];
+		Conditions = { NeverSatisfied };
+		return EDlgConditionConstant::AlwaysFalse;
+	}
+
+	TArray<FDlgCondition> Folded;
+	for (int32 Index = 0; Index < Conditions.Num(); Index++)
+	{
+		const bool bWeak = Conditions[Index].Strength == EDlgConditionStrength::Weak;
+		if (Constants[Index] == EDlgConditionConstant::Unknown && !(bWeak && bHasAlwaysSatisfiedWeak))
+		{
+			Folded.Add(Conditions[Index]);
+		}
+	}
+	Conditions = MoveTemp(Folded);
+
+	return Conditions.Num() == 0 ? EDlgConditionConstant::AlwaysTrue : EDlgConditionConstant::Unknown;
+}
+
+int32 FDlgConditionProgram::EstimateCost(const FDlgCondition& Condition)
+{
+	// Memory lookups first, reflection next, then the interface and blueprint calls, recursion last
+	int32 Cost = 0;
+	switch (Condition.ConditionType)
+	{
+		case EDlgConditionType::WasNodeVisited:
+			return 1;
+
+		case EDlgConditionType::HasSatisfiedChild:
+			return 64;
+
+		case EDlgConditionType::Custom:
+			return 16;
+
+		case EDlgConditionType::ClassBoolVariable:
+		case EDlgConditionType::ClassFloatVariable:
+		case EDlgConditionType::ClassIntVariable:
+		case EDlgConditionType::ClassNameVariable:
+			Cost = 2;
+			break;
+
+		default:
+			// EventCall and the participant interface values
+			Cost = 4;
+			break;
+	}
+
+	if (!DlgConditionProgram::UsesOtherParticipant(Condition))
+	{
+		return Cost;
+	}
+	switch (Condition.CompareType)
+	{
+		case EDlgCompare::ToVariable:
+			Cost += 4;
+			break;
+
+		case EDlgCompare::ToClassVariable:
+			Cost += 2;
+			break;
+
+		default:
+			break;
+	}
+	return Cost;
+}
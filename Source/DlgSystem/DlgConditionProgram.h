@@ -0,0 +1,102 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+
+class UDlgContext;
+struct FDlgCondition;
+
+// Result of a condition (or condition array) known without a context, see FDlgConditionProgram::FoldConstants
+enum class EDlgConditionConstant : uint8
+{
+	Unknown,
+	AlwaysTrue,
+	AlwaysFalse
+};
+
+// One condition of a compiled condition array
+struct DLGSYSTEM_API FDlgConditionInstruction
+{
+	// Index of the condition in the source array, the operands (constants, names, custom condition) are read from there
+	int32 ConditionIndex = INDEX_NONE;
+
+	// Index in FDlgConditionProgram::ParticipantTags of the participant passed to IsConditionMet
+	int32 ParticipantSlot = INDEX_NONE;
+
+	// Estimated cost, see FDlgConditionProgram::EstimateCost
+	int32 Cost = 0;
+};
+
+/**
+ * A condition array (FDlgEdge::Conditions, UDlgNode::EnterConditions) compiled for evaluation.
+ *
+ * The strong conditions must all be satisfied and the weak conditions need only one satisfied, so the order inside each
+ * group does not change the result. Each group is sorted by the estimated cost of the conditions (the authoring order is kept
+ * for the same cost) and the evaluation stops at the first failing strong and at the first satisfied weak condition.
+ * The participant tags are resolved once per evaluation instead of once per condition and the values of the participants implementing
+ * IDlgNativeParticipant are read with one call per participant for each group.
+ *
+ * The result is the same as FDlgCondition::EvaluateArray, if a participant needed by any condition is not set the array is
+ * evaluated by EvaluateArray instead so the invalid participant errors are logged exactly like before.
+ */
+struct DLGSYSTEM_API FDlgConditionProgram
+{
+public:
+	static TSharedRef<const FDlgConditionProgram> Compile(const TArray<FDlgCondition>& Conditions, const FGameplayTag& DefaultParticipantTag);
+
+	// Evaluates Conditions with the program cached in CachedProgram, compiles it first if it is not set or out of date.
+	// The owner of the array must reset CachedProgram when it modifies the conditions in place.
+	static bool EvaluateCached(
+		TSharedPtr<const FDlgConditionProgram>& CachedProgram,
+		const UDlgContext& Context,
+		const TArray<FDlgCondition>& Conditions,
+		const FGameplayTag& DefaultParticipantTag = FGameplayTag::EmptyTag
+	);
+
+	// Conditions must be the array this program was compiled from
+	bool Evaluate(const UDlgContext& Context, const TArray<FDlgCondition>& Conditions) const;
+
+	// Cheap check that catches the array being reallocated, resized or the default participant changing.
+	// Does NOT catch conditions modified in place.
+	bool IsCompiledFrom(const TArray<FDlgCondition>& Conditions, const FGameplayTag& InDefaultParticipantTag) const
+	{
+		return SourceData == Conditions.GetData()
+			&& SourceNum == Conditions.Num()
+			&& DefaultParticipantTag == InDefaultParticipantTag;
+	}
+
+	// Relative cost of evaluating the condition, the cheapest runs first
+	static int32 EstimateCost(const FDlgCondition& Condition);
+
+	/**
+	 * Removes the conditions that can not change the result of the array: the always satisfied strong conditions,
+	 * every weak condition if one of them is always satisfied and the never satisfied weak conditions if there are other weak ones.
+	 * If the array is never satisfied only the condition deciding that is kept.
+	 *
+	 * @param GetConstant	the constant result of a single condition
+	 * @return the constant result of the whole array, AlwaysTrue if it ends up empty
+	 */
+	static EDlgConditionConstant FoldConstants(TArray<FDlgCondition>& Conditions, TFunctionRef<EDlgConditionConstant(const FDlgCondition&)> GetConstant);
+
+	const TArray<FDlgConditionInstruction>& GetStrongInstructions() const { return StrongInstructions; }
+	const TArray<FDlgConditionInstruction>& GetWeakInstructions() const { return WeakInstructions; }
+
+protected:
+	// All must be satisfied, sorted by cost
+	TArray<FDlgConditionInstruction> StrongInstructions;
+
+	// At least one must be satisfied (if there is any), sorted by cost
+	TArray<FDlgConditionInstruction> WeakInstructions;
+
+	// Unique participants used by the conditions
+	TArray<FGameplayTag, TInlineAllocator<2>> ParticipantTags;
+
+	// Slots that must have a valid participant, otherwise a condition would log an error
+	TArray<int32, TInlineAllocator<2>> RequiredParticipantSlots;
+
+	// What this was compiled from
+	const FDlgCondition* SourceData = nullptr;
+	int32 SourceNum = 0;
+	FGameplayTag DefaultParticipantTag;
+};
@@ -3,7 +3,13 @@
 
 #include "Net/UnrealNetwork.h"
 #include "Engine/Texture2D.h"
+#include "Sound/SoundWave.h"
 #include "Engine/Blueprint.h"
+#include "HAL/PlatformTime.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonWriter.h"
+#include "Serialization/JsonSerializer.h"
+#include "Misc/FileHelper.h"
 
 #include "DlgConstants.h"
 #include "Nodes/DlgNode.h"
@@ -12,6 +18,23 @@
 #include "DlgDialogueParticipant.h"
 #include "DlgMemory.h"
 #include "Logging/DlgLogger.h"
+#include "DlgStats.h"
+#include "DlgManager.h"
+#include "DlgSystemSettings.h"
+
+#if WITH_GAMEPLAY_DEBUGGER
+bool FDlgContextStepDebugInfo::bEnabled = false;
+#endif
+
+// One step of the context, keeps the participant values and measures the step for the gameplay debugger
+struct FDlgContextStepScope
+{
+	FDlgContextStepScope(UDlgContext& InContext) : Context(InContext) { Context.BeginStep(); }
+	~FDlgContextStepScope() { Context.EndStep(); }
+
+	UDlgContext& Context;
+};
+#define DLG_CONTEXT_STEP_SCOPE() FDlgContextStepScope DlgContextStepScope(*this)
 
 
 UDlgContext::UDlgContext(const FObjectInitializer& ObjectInitializer)
@@ -20,11 +43,31 @@ UDlgContext::UDlgContext(const FObjectInitializer& ObjectInitializer)
 	//UObject.bReplicates = true;
 }
 
+void UDlgContext::PostInitProperties()
+{
+	Super::PostInitProperties();
+	UDlgManager::RegisterActiveContext(this);
+
+#if DLG_WITH_CONTEXT_TRACE
+	if (FDlgContextTrace::GetCapacityForNewContexts() > 0 && !HasAnyFlags(RF_ClassDefaultObject | RF_ArchetypeObject))
+	{
+		EnableTrace(FDlgContextTrace::GetCapacityForNewContexts());
+	}
+#endif
+}
+
+void UDlgContext::BeginDestroy()
+{
+	UDlgManager::UnregisterActiveContext(this);
+	Super::BeginDestroy();
+}
+
 void UDlgContext::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 	DOREPLIFETIME(ThisClass, Dialogue);
 	DOREPLIFETIME(ThisClass, SerializedParticipants);
+	DOREPLIFETIME(ThisClass, RandomSeed);
 }
 
 void UDlgContext::SerializeParticipants()
@@ -48,8 +91,23 @@ void UDlgContext::OnRep_SerializedParticipants()
 	}
 }
 
+void UDlgContext::OnRep_RandomSeed()
+{
+	bHasRandomSeed = true;
+	RandomStream.Initialize(RandomSeed);
+}
+
+void UDlgContext::SetRandomSeed(int32 InRandomSeed)
+{
+	RandomSeed = InRandomSeed;
+	OnRep_RandomSeed();
+}
+
 bool UDlgContext::ChooseOption(int32 OptionIndex)
 {
+	DLG_SCOPE_CYCLE_COUNTER(ChooseOption);
+	DLG_CONTEXT_STEP_SCOPE();
+	DLG_LLM_SCOPE();
 	check(Dialogue);
 	if (UDlgNode* Node = GetMutableActiveNode())
 	{
@@ -65,6 +123,7 @@ bool UDlgContext::ChooseOption(int32 OptionIndex)
 
 bool UDlgContext::ChooseSpeechSequenceOptionFromReplicated(int32 OptionIndex)
 {
+	DLG_CONTEXT_STEP_SCOPE();
 	check(Dialogue);
 	if (UDlgNode_SpeechSequence* Node = GetMutableActiveNodeAsSpeechSequence())
 	{
@@ -80,6 +139,7 @@ bool UDlgContext::ChooseSpeechSequenceOptionFromReplicated(int32 OptionIndex)
 
 bool UDlgContext::ChooseOptionFromAll(int32 Index)
 {
+	DLG_CONTEXT_STEP_SCOPE();
 	if (!AllChildren.IsValidIndex(Index))
 	{
 		LogErrorWithContext(FString::Printf(TEXT("ChooseOptionFromAll - INVALID given Index = %d"), Index));
@@ -101,6 +161,8 @@ bool UDlgContext::ChooseOptionFromAll(int32 Index)
 
 bool UDlgContext::ReevaluateOptions()
 {
+	DLG_SCOPE_CYCLE_COUNTER(ReevaluateOptions);
+	DLG_CONTEXT_STEP_SCOPE();
 	check(Dialogue);
 	UDlgNode* Node = GetMutableActiveNode();
 	if (!IsValid(Node))
@@ -218,7 +280,7 @@ const FText& UDlgContext::GetActiveNodeText() const
 		return FText::GetEmpty();
 	}
 
-	return Node->GetNodeText();
+	return Node->GetNodeTextForContext(*this);
 }
 
 FName UDlgContext::GetActiveNodeSpeakerState() const
@@ -230,7 +292,7 @@ FName UDlgContext::GetActiveNodeSpeakerState() const
 		return NAME_None;
 	}
 
-	return Node->GetSpeakerState();
+	return Node->GetSpeakerStateForContext(*this);
 }
 
 USoundWave* UDlgContext::GetActiveNodeVoiceSoundWave() const
@@ -242,7 +304,7 @@ USoundWave* UDlgContext::GetActiveNodeVoiceSoundWave() const
 		return nullptr;
 	}
 
-	return Node->GetNodeVoiceSoundWave();
+	return Cast<USoundWave>(Node->GetNodeVoiceSoundBaseForContext(*this));
 }
 
 USoundBase* UDlgContext::GetActiveNodeVoiceSoundBase() const
@@ -254,7 +316,7 @@ USoundBase* UDlgContext::GetActiveNodeVoiceSoundBase() const
 		return nullptr;
 	}
 
-	return Node->GetNodeVoiceSoundBase();
+	return Node->GetNodeVoiceSoundBaseForContext(*this);
 }
 
 UDialogueWave* UDlgContext::GetActiveNodeVoiceDialogueWave() const
@@ -266,7 +328,7 @@ UDialogueWave* UDlgContext::GetActiveNodeVoiceDialogueWave() const
 		return nullptr;
 	}
 
-	return Node->GetNodeVoiceDialogueWave();
+	return Node->GetNodeVoiceDialogueWaveForContext(*this);
 }
 
 UObject* UDlgContext::GetActiveNodeGenericData() const
@@ -278,7 +340,7 @@ UObject* UDlgContext::GetActiveNodeGenericData() const
 		return nullptr;
 	}
 
-	return Node->GetNodeGenericData();
+	return Node->GetNodeGenericDataForContext(*this);
 }
 
 UDlgNodeData* UDlgContext::GetActiveNodeData() const
@@ -290,7 +352,7 @@ UDlgNodeData* UDlgContext::GetActiveNodeData() const
 		return nullptr;
 	}
 
-	return Node->GetNodeData();
+	return Node->GetNodeDataForContext(*this);
 }
 
 UTexture2D* UDlgContext::GetActiveNodeParticipantIcon() const
@@ -302,7 +364,7 @@ UTexture2D* UDlgContext::GetActiveNodeParticipantIcon() const
 		return nullptr;
 	}
 
-	const FGameplayTag& SpeakerTag = Node->GetNodeParticipantTag();
+	const FGameplayTag SpeakerTag = Node->GetNodeParticipantTagForContext(*this);
 	auto* ObjectPtr = Participants.Find(SpeakerTag);
 	if (ObjectPtr == nullptr || !IsValid(*ObjectPtr))
 	{
@@ -313,7 +375,7 @@ UTexture2D* UDlgContext::GetActiveNodeParticipantIcon() const
 		return nullptr;
 	}
 
-	return IDlgDialogueParticipant::Execute_GetParticipantIcon(*ObjectPtr, SpeakerTag, Node->GetSpeakerState());
+	return IDlgDialogueParticipant::Execute_GetParticipantIcon(*ObjectPtr, SpeakerTag, Node->GetSpeakerStateForContext(*this));
 }
 
 UObject* UDlgContext::GetActiveNodeParticipant() const
@@ -325,8 +387,8 @@ UObject* UDlgContext::GetActiveNodeParticipant() const
 		return nullptr;
 	}
 
-	const FGameplayTag& SpeakerTag = Node->GetNodeParticipantTag();
-	auto* ObjectPtr = Participants.Find(Node->GetNodeParticipantTag());
+	const FGameplayTag SpeakerTag = Node->GetNodeParticipantTagForContext(*this);
+	auto* ObjectPtr = Participants.Find(SpeakerTag);
 	if (ObjectPtr == nullptr || !IsValid(*ObjectPtr))
 	{
 		LogErrorWithContext(FString::Printf(
@@ -348,7 +410,7 @@ FGameplayTag UDlgContext::GetActiveNodeParticipantTag() const
 		return FGameplayTag::EmptyTag;
 	}
 
-	return Node->GetNodeParticipantTag();
+	return Node->GetNodeParticipantTagForContext(*this);
 }
 
 FText UDlgContext::GetActiveNodeParticipantDisplayName() const
@@ -360,7 +422,7 @@ FText UDlgContext::GetActiveNodeParticipantDisplayName() const
 		return FText::GetEmpty();
 	}
 
-	const FGameplayTag& SpeakerTag = Node->GetNodeParticipantTag();
+	const FGameplayTag SpeakerTag = Node->GetNodeParticipantTagForContext(*this);
 	auto* ObjectPtr = Participants.Find(SpeakerTag);
 	if (ObjectPtr == nullptr || !IsValid(*ObjectPtr))
 	{
@@ -406,6 +468,29 @@ UObject* UDlgContext::GetParticipantFromName(const FDlgParticipantTag& Participa
 	return nullptr;
 }
 
+FDlgParticipantValue UDlgContext::ReadParticipantValue(const UObject* Participant, EDlgParticipantValueType Type, FName Name) const
+{
+	if (!ParticipantValueCache.bEnabled || Type == EDlgParticipantValueType::Condition)
+	{
+		DLG_INC_COUNTER(ParticipantCalls);
+		return IDlgNativeParticipant::ReadValue(*this, Participant, Type, Name);
+	}
+
+	const FDlgParticipantValueCache::FKey Key{ Participant, Type, Name };
+	if (const FDlgParticipantValue* CachedValue = ParticipantValueCache.Values.Find(Key))
+	{
+		return *CachedValue;
+	}
+
+	DLG_INC_COUNTER(ParticipantCalls);
+	const FDlgParticipantValue Value = IDlgNativeParticipant::ReadValue(*this, Participant, Type, Name);
+	if (!GetDefault<UDlgSystemSettings>()->VolatileParticipantValues.Contains(Name))
+	{
+		ParticipantValueCache.Values.Add(Key, Value);
+	}
+	return Value;
+}
+
 bool UDlgContext::IsValidNodeIndex(int32 NodeIndex) const
 {
 	return Dialogue ? Dialogue->IsValidNodeIndex(NodeIndex) : false;
@@ -500,6 +585,8 @@ bool UDlgContext::IsOptionConnectedToEndNode(int32 Index, bool bIndexSkipsUnsati
 
 bool UDlgContext::EnterNode(int32 NodeIndex, TSet<const UDlgNode*> NodesEnteredWithThisStep)
 {
+	DLG_SCOPE_CYCLE_COUNTER(EnterNode);
+	DLG_LLM_SCOPE();
 	check(Dialogue);
 	UDlgNode* Node = GetMutableNodeFromIndex(NodeIndex);
 	if (!IsValid(Node))
@@ -508,12 +595,19 @@ bool UDlgContext::EnterNode(int32 NodeIndex, TSet<const UDlgNode*> NodesEnteredW
 		return false;
 	}
 
-	ActiveNodeIndex = NodeIndex;
-	SetNodeVisited(NodeIndex, Node->GetGUID());
-
+	PassThroughNode(NodeIndex, *Node);
 	return Node->HandleNodeEnter(*this, NodesEnteredWithThisStep);
 }
 
+void UDlgContext::PassThroughNode(int32 NodeIndex, const UDlgNode& Node)
+{
+	ActiveNodeIndex = NodeIndex;
+	ActiveSpeechSequenceIndex = INDEX_NONE;
+	ActiveNodeConstructedTexts.Reset();
+	SetNodeVisited(NodeIndex, Node.GetGUID());
+	DLG_CONTEXT_TRACE(*this, AddEnterNode(NodeIndex));
+}
+
 UDlgContext* UDlgContext::CreateCopy() const
 {
 	UObject* FirstParticipant = nullptr;
@@ -534,10 +628,15 @@ UDlgContext* UDlgContext::CreateCopy() const
 	Context->Dialogue = Dialogue;
 	Context->SetParticipants(Participants);
 	Context->ActiveNodeIndex = ActiveNodeIndex;
+	Context->ActiveSpeechSequenceIndex = ActiveSpeechSequenceIndex;
+	Context->ActiveNodeConstructedTexts = ActiveNodeConstructedTexts;
 	Context->AvailableChildren = AvailableChildren;
 	Context->AllChildren = AllChildren;
 	Context->History = History;
 	Context->bDialogueEnded = bDialogueEnded;
+	Context->RandomSeed = RandomSeed;
+	Context->bHasRandomSeed = bHasRandomSeed;
+	Context->RandomStream = RandomStream;
 
 	return Context;
 }
@@ -657,7 +756,7 @@ bool UDlgContext::CanBeStarted(UDlgDialogue* InDialogue, const TMap<FGameplayTag
 	{
 		for (const FDlgEdge& ChildLink : StartNode->GetNodeChildren())
 		{
-			if (ChildLink.Evaluate(*Context, {}))
+			if (ChildLink.Evaluate(*Context, {}, StartNode))
 			{
 				// Simulate EnterNode
 				UDlgNode* Node = Context->GetMutableNodeFromIndex(ChildLink.TargetIndex);
@@ -674,12 +773,20 @@ bool UDlgContext::CanBeStarted(UDlgDialogue* InDialogue, const TMap<FGameplayTag
 
 bool UDlgContext::StartWithContext(const FString& ContextString, UDlgDialogue* InDialogue, const TMap<FGameplayTag, UObject*>& InParticipants)
 {
+	DLG_SCOPE_CYCLE_COUNTER(StartDialogue);
+	DLG_CONTEXT_STEP_SCOPE();
+	DLG_LLM_SCOPE();
+	DLG_INC_COUNTER(ContextsCreated);
 	const FString ContextMessage = ContextString.IsEmpty()
 		? TEXT("Start")
 		: FString::Printf(TEXT("%s - Start"), *ContextString);
 
 	Dialogue = InDialogue;
 	SetParticipants(InParticipants);
+	if (!bHasRandomSeed)
+	{
+		SetRandomSeed(FMath::Rand());
+	}
 	if (!ValidateParticipantsMapForDialogue(ContextMessage, Dialogue, Participants))
 	{
 		return false;
@@ -691,7 +798,7 @@ bool UDlgContext::StartWithContext(const FString& ContextString, UDlgDialogue* I
 	{
 		for (const FDlgEdge& ChildLink : StartNode->GetNodeChildren())
 		{
-			if (ChildLink.Evaluate(*this, {}))
+			if (ChildLink.Evaluate(*this, {}, StartNode))
 			{
 				if (EnterNode(ChildLink.TargetIndex, {}))
 				{
@@ -718,6 +825,7 @@ bool UDlgContext::StartWithContextFromNode(
 	bool bFireEnterEvents
 )
 {
+	DLG_CONTEXT_STEP_SCOPE();
 	const FString ContextMessage = ContextString.IsEmpty()
 		? TEXT("StartFromNode")
 		: FString::Printf(TEXT("%s - StartFromNode"), *ContextString);
@@ -725,6 +833,10 @@ bool UDlgContext::StartWithContextFromNode(
 	Dialogue = InDialogue;
 	SetParticipants(InParticipants);
 	History = StartHistory;
+	if (!bHasRandomSeed)
+	{
+		SetRandomSeed(FMath::Rand());
+	}
 	if (!ValidateParticipantsMapForDialogue(ContextMessage, Dialogue, Participants))
 	{
 		return false;
@@ -752,11 +864,151 @@ bool UDlgContext::StartWithContextFromNode(
 	}
 
 	ActiveNodeIndex = StartNodeIndex;
+	ActiveSpeechSequenceIndex = Node->IsA<UDlgNode_SpeechSequence>() ? 0 : INDEX_NONE;
+	ActiveNodeConstructedTexts.Reset();
 	SetNodeVisited(StartNodeIndex, Node->GetGUID());
 
 	return Node->ReevaluateChildren(*this, {});
 }
 
+void UDlgContext::EnableTrace(int32 Capacity)
+{
+#if DLG_WITH_CONTEXT_TRACE
+	if (!Trace.IsValid() || Trace->GetCapacity() != Capacity)
+	{
+		Trace = MakeUnique<FDlgContextTrace>(Capacity);
+	}
+#endif
+}
+
+FString UDlgContext::GetTraceAsJsonString() const
+{
+	if (!Trace.IsValid())
+	{
+		return FString();
+	}
+
+	TSharedRef<FJsonObject> Root = Trace->ToJsonObject();
+	Root->SetStringField(TEXT("Dialogue"), Dialogue ? Dialogue->GetPathName() : TEXT("INVALID"));
+	Root->SetNumberField(TEXT("ActiveNodeIndex"), ActiveNodeIndex);
+	Root->SetBoolField(TEXT("DialogueEnded"), bDialogueEnded);
+
+	TSharedRef<FJsonObject> ParticipantsObject = MakeShared<FJsonObject>();
+	for (const auto& KeyValue : Participants)
+	{
+		ParticipantsObject->SetStringField(KeyValue.Key.ToString(), KeyValue.Value ? KeyValue.Value->GetPathName() : TEXT("INVALID"));
+	}
+	Root->SetObjectField(TEXT("Participants"), ParticipantsObject);
+
+	FString JSON;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JSON);
+	FJsonSerializer::Serialize(Root, Writer);
+	return JSON;
+}
+
+bool UDlgContext::SaveTraceToFile(const FString& FilePath) const
+{
+	if (!Trace.IsValid())
+	{
+		LogErrorWithContext(FString::Printf(TEXT("SaveTraceToFile - FAILED to save to `%s` because the trace is not enabled"), *FilePath));
+		return false;
+	}
+
+	if (!FFileHelper::SaveStringToFile(GetTraceAsJsonString(), *FilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+	{
+		LogErrorWithContext(FString::Printf(TEXT("SaveTraceToFile - FAILED to write `%s`"), *FilePath));
+		return false;
+	}
+
+	return true;
+}
+
+void UDlgContext::BeginStep()
+{
+	ParticipantValueCache.StepDepth++;
+	if (ParticipantValueCache.StepDepth == 1)
+	{
+		ParticipantValueCache.Values.Reset();
+		ParticipantValueCache.bEnabled = GetDefault<UDlgSystemSettings>()->bCacheParticipantValuesPerStep;
+	}
+
+#if WITH_GAMEPLAY_DEBUGGER
+	BeginStepDebugInfo();
+#endif
+}
+
+void UDlgContext::EndStep()
+{
+#if WITH_GAMEPLAY_DEBUGGER
+	EndStepDebugInfo();
+#endif
+
+	ParticipantValueCache.StepDepth--;
+	if (ParticipantValueCache.StepDepth == 0)
+	{
+		// Values can change between the steps
+		ParticipantValueCache.Values.Reset();
+		ParticipantValueCache.bEnabled = false;
+	}
+}
+
+#if WITH_GAMEPLAY_DEBUGGER
+void UDlgContext::BeginStepDebugInfo()
+{
+	StepDebugInfo.StepDepth++;
+	if (StepDebugInfo.StepDepth > 1 || !FDlgContextStepDebugInfo::bEnabled)
+	{
+		return;
+	}
+
+	StepDebugInfo.StepStartTime = FPlatformTime::Seconds();
+	StepDebugInfo.NumConditionsEvaluated = 0;
+	StepDebugInfo.SlowConditions.Reset();
+}
+
+void UDlgContext::EndStepDebugInfo()
+{
+	StepDebugInfo.StepDepth--;
+	if (StepDebugInfo.StepDepth > 0 || !FDlgContextStepDebugInfo::bEnabled)
+	{
+		return;
+	}
+
+	StepDebugInfo.StepSeconds = FPlatformTime::Seconds() - StepDebugInfo.StepStartTime;
+}
+
+void UDlgContext::RecordConditionDebugInfo(const FDlgCondition& Condition, double Seconds) const
+{
+	StepDebugInfo.NumConditionsEvaluated++;
+	if (Seconds < FDlgContextStepDebugInfo::SlowConditionSeconds)
+	{
+		return;
+	}
+
+	// Keep the slowest ones, sorted descending
+	TArray<FDlgContextStepDebugInfo::FSlowCondition, TInlineAllocator<FDlgContextStepDebugInfo::MaxSlowConditions>>& SlowConditions = StepDebugInfo.SlowConditions;
+	int32 InsertIndex = 0;
+	while (InsertIndex < SlowConditions.Num() && SlowConditions[InsertIndex].Seconds >= Seconds)
+	{
+		InsertIndex++;
+	}
+	if (InsertIndex >= FDlgContextStepDebugInfo::MaxSlowConditions)
+	{
+		return;
+	}
+	if (SlowConditions.Num() == FDlgContextStepDebugInfo::MaxSlowConditions)
+	{
+		SlowConditions.RemoveAt(SlowConditions.Num() - 1);
+	}
+
+	FDlgContextStepDebugInfo::FSlowCondition SlowCondition;
+	SlowCondition.ConditionType = Condition.ConditionType;
+	SlowCondition.CallbackName = Condition.CallbackName;
+	SlowCondition.Seconds = Seconds;
+	SlowConditions.Insert(SlowCondition, InsertIndex);
+}
+#endif // WITH_GAMEPLAY_DEBUGGER
+
 FString UDlgContext::GetContextString() const
 {
 	FString ContextParticipants;
@@ -993,6 +1245,7 @@ bool UDlgContext::ConvertArrayOfParticipantsToMap(
 	bool bLog
 )
 {
+	DLG_SCOPE_CYCLE_COUNTER(GatherParticipants);
 	const FString ContextMessage = ContextString.IsEmpty()
 		? FString::Printf(TEXT("ConvertArrayOfParticipantsToMap"))
 		: FString::Printf(TEXT("%s - ConvertArrayOfParticipantsToMap"), *ContextString);
@@ -6,7 +6,10 @@
 #include "Nodes/DlgNode.h"
 #include "DlgMemory.h"
 #include "DlgParticipantTag.h"
+#include "DlgContextTrace.h"
+#include "DlgNativeParticipant.h"
 #include "GameplayTagContainer.h"
+#include "Math/RandomStream.h"
 
 #include "DlgContext.generated.h"
 
@@ -68,6 +71,66 @@ enum class EDlgValidateStatus : uint8
 	// DialogueDoesNotContainParticipant
 };
 
+#if WITH_GAMEPLAY_DEBUGGER
+// What happened in the last step (start, choose option, reevaluate options) of a context, displayed by the gameplay debugger
+struct DLGSYSTEM_API FDlgContextStepDebugInfo
+{
+	// Conditions slower than this are remembered as slow
+	static constexpr double SlowConditionSeconds = 0.0001;
+	static constexpr int32 MaxSlowConditions = 3;
+
+	// Only gathered while the gameplay debugger category is active, the timers are not free
+	static bool bEnabled;
+
+	struct FSlowCondition
+	{
+		EDlgConditionType ConditionType = EDlgConditionType::EventCall;
+		FName CallbackName;
+		double Seconds = 0.0;
+	};
+
+	// FPlatformTime::Seconds() when the last step started
+	double StepStartTime = 0.0;
+	double StepSeconds = 0.0;
+	int32 NumConditionsEvaluated = 0;
+
+	// Slowest first
+	TArray<FSlowCondition, TInlineAllocator<MaxSlowConditions>> SlowConditions;
+
+	// Steps can be nested (e.g. ChooseOptionFromAll calls ChooseOption), only the outermost one is measured
+	int32 StepDepth = 0;
+};
+#endif // WITH_GAMEPLAY_DEBUGGER
+
+// Dialogue values of the participants read during the outermost step of a context, see UDlgContext::ReadParticipantValue
+struct DLGSYSTEM_API FDlgParticipantValueCache
+{
+	struct FKey
+	{
+		const UObject* Participant = nullptr;
+		EDlgParticipantValueType Type = EDlgParticipantValueType::Int;
+		FName Name;
+
+		bool operator==(const FKey& Other) const
+		{
+			return Participant == Other.Participant && Type == Other.Type && Name == Other.Name;
+		}
+
+		friend uint32 GetTypeHash(const FKey& Key)
+		{
+			return HashCombine(HashCombine(PointerHash(Key.Participant), GetTypeHash(static_cast<uint8>(Key.Type))), GetTypeHash(Key.Name));
+		}
+	};
+
+	TMap<FKey, FDlgParticipantValue> Values;
+
+	// UDlgSystemSettings::bCacheParticipantValuesPerStep when the outermost step started, false outside of the steps
+	bool bEnabled = false;
+
+	// Steps can be nested (e.g. ChooseOptionFromAll calls ChooseOption), the values are kept until the outermost one ends
+	int32 StepDepth = 0;
+};
+
 /**
  *  Class representing an active dialogue, can be used to gain information and to control it
  *  Should be controlled from Player Character/Player controller
@@ -87,7 +150,8 @@ public:
 	// UObject Interface
 	//
 
-	void PostInitProperties() override { Super::PostInitProperties(); }
+	void PostInitProperties() override;
+	void BeginDestroy() override;
 
 	UDlgContext(const FObjectInitializer& ObjectInitializer);
 
@@ -103,6 +167,9 @@ public:
 	void OnRep_SerializedParticipants();
 	void SerializeParticipants();
 
+	UFUNCTION()
+	void OnRep_RandomSeed();
+
 	UE_DEPRECATED(4.22, "ChooseChild has been deprecated in Favour of ChooseOption")
 	UFUNCTION(BlueprintCallable, Category = "Dialogue|Control", meta = (DeprecatedFunction, DeprecationMessage = "ChooseChild has been deprecated in favour of ChooseOption"))
 	bool ChooseChild(int32 OptionIndex) { return ChooseOption(OptionIndex); }
@@ -301,12 +368,36 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Dialogue|Data")
 	UObject* GetParticipantFromName(const FDlgParticipantTag& Participant);
 
+	// Reads a dialogue value of Participant (see IDlgNativeParticipant::ReadValue), at most once per step of this context
+	// if UDlgSystemSettings::bCacheParticipantValuesPerStep is enabled. The named conditions (CheckCondition) are never cached.
+	FDlgParticipantValue ReadParticipantValue(const UObject* Participant, EDlgParticipantValueType Type, FName Name) const;
+
+	// Reads the participant values again from now on, called for every event fired by the dialogue
+	UFUNCTION(BlueprintCallable, Category = "Dialogue|Data")
+	void InvalidateParticipantValueCache() { ParticipantValueCache.Values.Reset(); }
+
+	// Called by every step of this context (start, choose option, reevaluate options), see FDlgParticipantValueCache::StepDepth
+	void BeginStep();
+	void EndStep();
+
 	UFUNCTION(BlueprintPure, Category = "Dialogue|ActiveNode")
 	int32 GetActiveNodeIndex() const { return ActiveNodeIndex; }
 
 	UFUNCTION(BlueprintPure, Category = "Dialogue|ActiveNode")
 	FGuid GetActiveNodeGUID() const { return GetNodeGUIDForIndex(ActiveNodeIndex); }
 
+	// Index of the active entry if the active node is a speech sequence, INDEX_NONE otherwise
+	UFUNCTION(BlueprintPure, Category = "Dialogue|ActiveNode")
+	int32 GetActiveSpeechSequenceIndex() const { return ActiveSpeechSequenceIndex; }
+	void SetActiveSpeechSequenceIndex(int32 NewIndex) { ActiveSpeechSequenceIndex = NewIndex; }
+
+	// Text of the active node (or of the entry EntryIndex of the active speech sequence) constructed for this context, nullptr if there is none
+	const FText* GetActiveNodeConstructedText(int32 EntryIndex = 0) const
+	{
+		return ActiveNodeConstructedTexts.IsValidIndex(EntryIndex) ? &ActiveNodeConstructedTexts[EntryIndex] : nullptr;
+	}
+	void SetActiveNodeConstructedTexts(TArray<FText>&& Texts) { ActiveNodeConstructedTexts = MoveTemp(Texts); }
+
 	UFUNCTION(BlueprintPure, Category = "Dialogue|ActiveNode", DisplayName = "Get Active Node")
 	UDlgNode* GetMutableActiveNode() const { return GetMutableNodeFromIndex(ActiveNodeIndex); }
 	const UDlgNode* GetActiveNode() const { return GetNodeFromIndex(ActiveNodeIndex); }
@@ -368,6 +459,10 @@ public:
 	// Conditions are not checked here - they are expected to be satisfied
 	bool EnterNode(int32 NodeIndex, TSet<const UDlgNode*> NodesEnteredWithThisStep);
 
+	// Does everything EnterNode does except calling HandleNodeEnter on the node: the node becomes the active node and is marked visited.
+	// Used by the proxy nodes to step through their resolved proxy chain.
+	void PassThroughNode(int32 NodeIndex, const UDlgNode& Node);
+
 	// Adds the node as visited in the current dialogue memory
 	virtual void SetNodeVisited(int32 NodeIndex, const FGuid& NodeGUID);
 
@@ -403,6 +498,61 @@ public:
 	// Gets the History of this context
 	const FDlgHistory& GetHistoryOfThisContext() const { return History; }
 
+	//
+	// Execution trace, a fixed size ring buffer of node enters, edge and condition results and events, see FDlgContextTrace.
+	// Compiled out of Shipping targets. New contexts are traced automatically after the Dlg.Trace.Enable console command.
+	//
+
+	// Starts recording the execution trace of this context, keeps the already recorded entries if the capacity did not change
+	UFUNCTION(BlueprintCallable, Category = "Dialogue|Debug")
+	void EnableTrace(int32 Capacity = 256);
+
+	// Stops recording and frees the execution trace
+	UFUNCTION(BlueprintCallable, Category = "Dialogue|Debug")
+	void DisableTrace() { Trace.Reset(); }
+
+	UFUNCTION(BlueprintPure, Category = "Dialogue|Debug")
+	bool IsTraceEnabled() const { return Trace.IsValid(); }
+
+	// The recorded execution trace as JSON, empty if the trace is not enabled
+	UFUNCTION(BlueprintCallable, Category = "Dialogue|Debug")
+	FString GetTraceAsJsonString() const;
+
+	// Saves GetTraceAsJsonString to FilePath
+	UFUNCTION(BlueprintCallable, Category = "Dialogue|Debug")
+	bool SaveTraceToFile(const FString& FilePath) const;
+
+	// nullptr if the trace is not enabled, used by DLG_CONTEXT_TRACE
+	FDlgContextTrace* GetTrace() const { return Trace.Get(); }
+
+#if WITH_GAMEPLAY_DEBUGGER
+	const FDlgContextStepDebugInfo& GetStepDebugInfo() const { return StepDebugInfo; }
+
+	// Called by the outermost step of this context, see FDlgContextStepDebugInfo
+	void BeginStepDebugInfo();
+	void EndStepDebugInfo();
+
+	// Called by FDlgCondition::EvaluateArray for every evaluated condition while a step is measured
+	void RecordConditionDebugInfo(const FDlgCondition& Condition, double Seconds) const;
+#endif
+
+	//
+	// Randomness, every random decision of this context (e.g. the random selector nodes) comes from its own stream.
+	// The seed is replicated, the same seed and the same choices always result in the same traversal.
+	//
+
+	// Seeds the random stream of this context. Call it before starting the context, otherwise a random seed is picked on start.
+	UFUNCTION(BlueprintCallable, Category = "Dialogue|Random")
+	void SetRandomSeed(int32 InRandomSeed);
+
+	UFUNCTION(BlueprintPure, Category = "Dialogue|Random")
+	int32 GetRandomSeed() const { return RandomSeed; }
+
+	UFUNCTION(BlueprintPure, Category = "Dialogue|Random")
+	bool HasRandomSeed() const { return bHasRandomSeed; }
+
+	FRandomStream& GetRandomStream() { return RandomStream; }
+
 	// Checks the enter conditions of the node.
 	// return false if they are not satisfied or if the index is invalid
 	bool IsNodeEnterable(int32 NodeIndex, TSet<const UDlgNode*> AlreadyVisitedNodes) const;
@@ -593,6 +743,15 @@ protected:
 	UPROPERTY(Replicated, ReplicatedUsing = OnRep_SerializedParticipants)
 	TArray<UObject*> SerializedParticipants;
 
+	// Seed of RandomStream, the stream itself is not replicated
+	UPROPERTY(Replicated, ReplicatedUsing = OnRep_RandomSeed)
+	int32 RandomSeed = 0;
+
+	bool bHasRandomSeed = false;
+
+	// Source of all the random decisions of this context
+	FRandomStream RandomStream;
+
 	// All object is expected to implement the IDlgDialogueParticipant interface
 	// the key is the return value of IDlgDialogueParticipant::GetParticipantTag()
 	UPROPERTY()
@@ -601,6 +760,14 @@ protected:
 	// The index of the active node in the dialogues Nodes array
 	int32 ActiveNodeIndex = INDEX_NONE;
 
+	// The index of the active entry of the active speech sequence node
+	// Stored here and not in the node, as the node is shared by every context running the same Dialogue
+	int32 ActiveSpeechSequenceIndex = INDEX_NONE;
+
+	// Texts of the active node constructed from their text arguments, one per entry for a speech sequence
+	// Stored here for the same reason, the constructed text of the node belongs to the context that entered it last
+	TArray<FText> ActiveNodeConstructedTexts;
+
 	// Options of the active node with satisfied conditions - the options the player can choose from
 	TArray<FDlgEdge> AvailableChildren;
 
@@ -617,4 +784,15 @@ protected:
 
 	// cache the result of the last ChooseOption call
 	bool bDialogueEnded = false;
+
+	// Only allocated while tracing, see EnableTrace
+	TUniquePtr<FDlgContextTrace> Trace;
+
+	// Values are read through const methods
+	mutable FDlgParticipantValueCache ParticipantValueCache;
+
+#if WITH_GAMEPLAY_DEBUGGER
+	// Conditions are evaluated through const methods
+	mutable FDlgContextStepDebugInfo StepDebugInfo;
+#endif
 };
@@ -0,0 +1,188 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#include "DlgContextTrace.h"
+
+#include "Dom/JsonObject.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Paths.h"
+
+#include "DlgCondition.h"
+#include "DlgEvent.h"
+#include "DlgContext.h"
+#include "DlgManager.h"
+#include "Logging/DlgLogger.h"
+
+int32 FDlgContextTrace::CapacityForNewContexts = 0;
+
+FDlgContextTrace::FDlgContextTrace(int32 InCapacity)
+{
+	Entries.SetNum(FMath::Max(InCapacity, 1));
+}
+
+FDlgContextTraceEntry& FDlgContextTrace::AddEntry(EDlgContextTraceEntryType Type, int32 NodeIndex)
+{
+	FDlgContextTraceEntry& Entry = Entries[NextIndex];
+	NextIndex = (NextIndex + 1) % Entries.Num();
+	NumRecorded++;
+
+	Entry = FDlgContextTraceEntry();
+	Entry.Time = FPlatformTime::Seconds();
+	Entry.Type = Type;
+	Entry.NodeIndex = NodeIndex;
+	return Entry;
+}
+
+void FDlgContextTrace::AddEnterNode(int32 NodeIndex)
+{
+	AddEntry(EDlgContextTraceEntryType::EnterNode, NodeIndex);
+}
+
+void FDlgContextTrace::AddEdge(int32 NodeIndex, int32 TargetIndex, bool bSatisfied)
+{
+	FDlgContextTraceEntry& Entry = AddEntry(EDlgContextTraceEntryType::EvaluateEdge, NodeIndex);
+	Entry.TargetIndex = TargetIndex;
+	Entry.bResult = bSatisfied;
+}
+
+void FDlgContextTrace::AddCondition(int32 NodeIndex, const FDlgCondition& Condition, bool bSatisfied)
+{
+	FDlgContextTraceEntry& Entry = AddEntry(EDlgContextTraceEntryType::Condition, NodeIndex);
+	Entry.SubType = static_cast<uint8>(Condition.ConditionType);
+	Entry.bResult = bSatisfied;
+	Entry.Name = Condition.CallbackName;
+	Entry.ParticipantTag = Condition.ParticipantTag.GetTagName();
+	if (Pending.bHasValues)
+	{
+		Entry.bHasValues = true;
+		Entry.ObservedValue = Pending.ObservedValue;
+		Entry.ExpectedValue = Pending.ExpectedValue;
+		Entry.ObservedName = Pending.ObservedName;
+		Entry.ExpectedName = Pending.ExpectedName;
+		Pending = FDlgContextTraceEntry();
+	}
+}
+
+void FDlgContextTrace::AddEvent(int32 NodeIndex, const FDlgEvent& Event)
+{
+	FDlgContextTraceEntry& Entry = AddEntry(EDlgContextTraceEntryType::Event, NodeIndex);
+	Entry.SubType = static_cast<uint8>(Event.EventType);
+	Entry.Name = Event.EventName;
+	Entry.ParticipantTag = Event.ParticipantTag.GetTagName();
+}
+
+void FDlgContextTrace::Empty()
+{
+	NextIndex = 0;
+	NumRecorded = 0;
+	Pending = FDlgContextTraceEntry();
+}
+
+TSharedRef<FJsonObject> FDlgContextTrace::ToJsonObject() const
+{
+	static const TCHAR* TypeNames[] = { TEXT("EnterNode"), TEXT("EvaluateEdge"), TEXT("Condition"), TEXT("Event") };
+
+	TArray<TSharedPtr<FJsonValue>> EntryValues;
+	const int32 NumEntries = Num();
+	EntryValues.Reserve(NumEntries);
+	for (int32 Index = 0; Index < NumEntries; Index++)
+	{
+		const FDlgContextTraceEntry& Entry = Get(Index);
+		TSharedRef<FJsonObject> EntryObject = MakeShared<FJsonObject>();
+		EntryObject->SetNumberField(TEXT("Time"), Entry.Time);
+		EntryObject->SetStringField(TEXT("Type"), TypeNames[static_cast<int32>(Entry.Type)]);
+		EntryObject->SetNumberField(TEXT("NodeIndex"), Entry.NodeIndex);
+
+		switch (Entry.Type)
+		{
+			case EDlgContextTraceEntryType::EvaluateEdge:
+				EntryObject->SetNumberField(TEXT("TargetIndex"), Entry.TargetIndex);
+				EntryObject->SetBoolField(TEXT("Result"), Entry.bResult);
+				break;
+
+			case EDlgContextTraceEntryType::Condition:
+				EntryObject->SetStringField(TEXT("ConditionType"), FDlgCondition::ConditionTypeToString(static_cast<EDlgConditionType>(Entry.SubType)));
+				EntryObject->SetStringField(TEXT("Participant"), Entry.ParticipantTag.ToString());
+				EntryObject->SetStringField(TEXT("Name"), Entry.Name.ToString());
+				EntryObject->SetBoolField(TEXT("Result"), Entry.bResult);
+				if (Entry.bHasValues)
+				{
+					if (Entry.ObservedName.IsNone() && Entry.ExpectedName.IsNone())
+					{
+						EntryObject->SetNumberField(TEXT("Observed"), Entry.ObservedValue);
+						EntryObject->SetNumberField(TEXT("Expected"), Entry.ExpectedValue);
+					}
+					else
+					{
+						EntryObject->SetStringField(TEXT("Observed"), Entry.ObservedName.ToString());
+						EntryObject->SetStringField(TEXT("Expected"), Entry.ExpectedName.ToString());
+					}
+				}
+				break;
+
+			case EDlgContextTraceEntryType::Event:
+				EntryObject->SetStringField(TEXT("EventType"), FDlgEvent::EventTypeToString(static_cast<EDlgEventType>(Entry.SubType)));
+				EntryObject->SetStringField(TEXT("Participant"), Entry.ParticipantTag.ToString());
+				EntryObject->SetStringField(TEXT("Name"), Entry.Name.ToString());
+				break;
+
+			case EDlgContextTraceEntryType::EnterNode:
+			default:
+				break;
+		}
+
+		EntryValues.Add(MakeShared<FJsonValueObject>(EntryObject));
+	}
+
+	TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+	Root->SetNumberField(TEXT("Capacity"), GetCapacity());
+	Root->SetNumberField(TEXT("NumRecorded"), static_cast<double>(NumRecorded));
+	Root->SetArrayField(TEXT("Entries"), EntryValues);
+	return Root;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Console commands
+static FAutoConsoleCommand DlgTraceEnableCommand(
+	TEXT("Dlg.Trace.Enable"),
+	TEXT("Records the execution trace of all the active and new dialogue contexts. Usage: Dlg.Trace.Enable [Capacity]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		const int32 Capacity = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : FDlgContextTrace::DefaultCapacity;
+		FDlgContextTrace::SetCapacityForNewContexts(Capacity);
+		for (UDlgContext* Context : UDlgManager::GetActiveContexts())
+		{
+			Context->EnableTrace(Capacity);
+		}
+	})
+);
+
+static FAutoConsoleCommand DlgTraceDisableCommand(
+	TEXT("Dlg.Trace.Disable"),
+	TEXT("Stops recording and frees the execution trace of all the dialogue contexts"),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		FDlgContextTrace::SetCapacityForNewContexts(0);
+		for (UDlgContext* Context : UDlgManager::GetActiveContexts())
+		{
+			Context->DisableTrace();
+		}
+	})
+);
+
+static FAutoConsoleCommand DlgTraceDumpCommand(
+	TEXT("Dlg.Trace.Dump"),
+	TEXT("Saves the execution trace of every traced dialogue context as JSON. Usage: Dlg.Trace.Dump [Directory], defaults to Saved/DlgSystem/Traces"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		const FString Directory = Args.Num() > 0 ? Args[0] : FPaths::ProjectSavedDir() / TEXT("DlgSystem") / TEXT("Traces");
+		int32 NumSaved = 0;
+		for (const UDlgContext* Context : UDlgManager::GetActiveContexts())
+		{
+			if (Context->IsTraceEnabled() && Context->SaveTraceToFile(Directory / Context->GetName() + TEXT(".json")))
+			{
+				NumSaved++;
+			}
+		}
+		FDlgLogger::Get().Infof(TEXT("Dlg.Trace.Dump - Saved %d context traces to %s"), NumSaved, *Directory);
+	})
+);
@@ -0,0 +1,135 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FJsonObject;
+class UDlgContext;
+struct FDlgCondition;
+struct FDlgEvent;
+
+// Per context execution trace (see UDlgContext::EnableTrace)
+// DLG_WITH_CONTEXT_TRACE is set by DlgSystem.Build.cs, the recording compiles to nothing in Shipping targets
+#ifndef DLG_WITH_CONTEXT_TRACE
+#define DLG_WITH_CONTEXT_TRACE 0
+#endif
+
+enum class EDlgContextTraceEntryType : uint8
+{
+	EnterNode = 0,
+	EvaluateEdge,
+	Condition,
+	Event
+};
+
+// One recorded step, plain data only so recording never allocates or formats strings
+struct DLGSYSTEM_API FDlgContextTraceEntry
+{
+	// FPlatformTime::Seconds() when it was recorded
+	double Time = 0.0;
+
+	EDlgContextTraceEntryType Type = EDlgContextTraceEntryType::EnterNode;
+
+	// EDlgConditionType or EDlgEventType
+	uint8 SubType = 0;
+
+	// Condition or edge satisfied
+	bool bResult = false;
+
+	// Do the values below mean anything
+	bool bHasValues = false;
+
+	// The entered node, the node owning the evaluated edge (INDEX_NONE for the start nodes) or the active node at the time of recording
+	int32 NodeIndex = INDEX_NONE;
+
+	// Target node index of the edge
+	int32 TargetIndex = INDEX_NONE;
+
+	// Callback name of the condition or the event name
+	FName Name;
+	FName ParticipantTag;
+
+	// What the condition compared, numbers and bools are stored as doubles, names separately
+	double ObservedValue = 0.0;
+	double ExpectedValue = 0.0;
+	FName ObservedName;
+	FName ExpectedName;
+};
+
+// Fixed size ring buffer of FDlgContextTraceEntry, the oldest entries are overwritten
+class DLGSYSTEM_API FDlgContextTrace
+{
+public:
+	static constexpr int32 DefaultCapacity = 256;
+
+	FDlgContextTrace(int32 InCapacity = DefaultCapacity);
+
+	void AddEnterNode(int32 NodeIndex);
+	void AddEdge(int32 NodeIndex, int32 TargetIndex, bool bSatisfied);
+	void AddCondition(int32 NodeIndex, const FDlgCondition& Condition, bool bSatisfied);
+	void AddEvent(int32 NodeIndex, const FDlgEvent& Event);
+
+	// Called by the condition checks, the next AddCondition uses them
+	void SetObservedValues(double Observed, double Expected)
+	{
+		Pending.bHasValues = true;
+		Pending.ObservedValue = Observed;
+		Pending.ExpectedValue = Expected;
+	}
+	void SetObservedNames(FName Observed, FName Expected)
+	{
+		Pending.bHasValues = true;
+		Pending.ObservedName = Observed;
+		Pending.ExpectedName = Expected;
+	}
+
+	int32 Num() const { return static_cast<int32>(FMath::Min<int64>(NumRecorded, Entries.Num())); }
+	int32 GetCapacity() const { return Entries.Num(); }
+
+	// Total number of entries recorded, including the overwritten ones
+	int64 GetNumRecorded() const { return NumRecorded; }
+
+	// Index 0 is the oldest entry still in the buffer
+	const FDlgContextTraceEntry& Get(int32 Index) const
+	{
+		check(Index >= 0 && Index < Num());
+		const int32 OldestIndex = NumRecorded > Entries.Num() ? NextIndex : 0;
+		return Entries[(OldestIndex + Index) % Entries.Num()];
+	}
+
+	void Empty();
+
+	// Entries oldest first, the strings are only created here
+	TSharedRef<FJsonObject> ToJsonObject() const;
+
+	// Capacity used for the trace of new contexts, 0 means new contexts are not traced. Set by the Dlg.Trace.Enable console command.
+	static int32 GetCapacityForNewContexts() { return CapacityForNewContexts; }
+	static void SetCapacityForNewContexts(int32 Capacity) { CapacityForNewContexts = FMath::Max(Capacity, 0); }
+
+private:
+	FDlgContextTraceEntry& AddEntry(EDlgContextTraceEntryType Type, int32 NodeIndex);
+
+private:
+	TArray<FDlgContextTraceEntry> Entries;
+	int32 NextIndex = 0;
+	int64 NumRecorded = 0;
+
+	// Values observed by the condition being evaluated
+	FDlgContextTraceEntry Pending;
+
+	static int32 CapacityForNewContexts;
+};
+
+// Records into the trace of Context if it has one, e.g. DLG_CONTEXT_TRACE(Context, AddEnterNode(NodeIndex))
+#if DLG_WITH_CONTEXT_TRACE
+#define DLG_CONTEXT_TRACE(Context, Call) \
+	do \
+	{ \
+		if (FDlgContextTrace* DlgContextTrace = (Context).GetTrace()) \
+		{ \
+			DlgContextTrace->Call; \
+		} \
+	} while (0)
+#else
+#define DLG_CONTEXT_TRACE(Context, Call) do {} while (0)
+#endif // DLG_WITH_CONTEXT_TRACE
@@ -4,6 +4,8 @@
 #include "UObject/DevObjectVersion.h"
 #include "HAL/FileManager.h"
 #include "Misc/Paths.h"
+#include "Misc/FileHelper.h"
+#include "Async/Async.h"
 
 #if WITH_EDITOR
 #include "EdGraph/EdGraph.h"
@@ -15,11 +17,16 @@
 #include "IO/DlgConfigWriter.h"
 #include "IO/DlgJsonWriter.h"
 #include "IO/DlgJsonParser.h"
+#include "IO/DlgBinaryWriter.h"
+#include "IO/DlgBinaryParser.h"
 #include "Nodes/DlgNode_Speech.h"
 #include "Nodes/DlgNode_SpeechSequence.h"
 #include "Nodes/DlgNode_End.h"
+#include "Nodes/DlgNode_Proxy.h"
+#include "Nodes/DlgNode_Selector.h"
 #include "Nodes/DlgNode_Start.h"
 #include "DlgManager.h"
+#include "DlgConditionProgram.h"
 #include "Logging/DlgLogger.h"
 #include "DlgHelper.h"
 
@@ -27,6 +34,120 @@
 
 // Unique DlgDialogue Object version id, generated with random
 const FGuid FDlgDialogueObjectVersion::GUID(0x2B8E5105, 0x6F66348F, 0x2A8A0B25, 0x9047A071);
+
+namespace DlgNodeGraph
+{
+	/**
+	 * Strongly connected components (Tarjan), iterative so big dialogues can not overflow the stack.
+	 * @return the component index of every node, OutComponentSizes is the number of nodes in every component
+	 */
+	static TArray<int32> FindStronglyConnectedComponents(const TArray<TArray<int32>>& Edges, TArray<int32>& OutComponentSizes)
+	{
+		const int32 NodesNum = Edges.Num();
+		TArray<int32> Components;
+		Components.Init(INDEX_NONE, NodesNum);
+		TArray<int32> DiscoveryOrder;
+		DiscoveryOrder.Init(INDEX_NONE, NodesNum);
+		TArray<int32> LowLinks;
+		LowLinks.Init(0, NodesNum);
+		TBitArray<> OnStack(false, NodesNum);
+		TArray<int32> Stack;
+		int32 NextDiscoveryOrder = 0;
+
+		// Depth first search frames, the node and the index of its next edge
+		TArray<TPair<int32, int32>> Frames;
+		auto Discover = [&](int32 NodeIndex)
+		{
+			DiscoveryOrder[NodeIndex] = LowLinks[NodeIndex] = NextDiscoveryOrder++;
+			Stack.Add(NodeIndex);
+			OnStack[NodeIndex] = true;
+			Frames.Emplace(NodeIndex, 0);
+		};
+
+		for (int32 RootIndex = 0; RootIndex < NodesNum; RootIndex++)
+		{
+			if (DiscoveryOrder[RootIndex] != INDEX_NONE)
+			{
+				continue;
+			}
+
+			Discover(RootIndex);
+			while (Frames.Num() > 0)
+			{
+				const int32 NodeIndex = Frames.Last().Key;
+				const int32 EdgeIndex = Frames.Last().Value++;
+				if (Edges[NodeIndex].IsValidIndex(EdgeIndex))
+				{
+					const int32 TargetIndex = Edges[NodeIndex][EdgeIndex];
+					if (DiscoveryOrder[TargetIndex] == INDEX_NONE)
+					{
+						Discover(TargetIndex);
+					}
+					else if (OnStack[TargetIndex])
+					{
+						LowLinks[NodeIndex] = FMath::Min(LowLinks[NodeIndex], DiscoveryOrder[TargetIndex]);
+					}
+					continue;
+				}
+
+				// Every edge is visited, pop the component if this is its root
+				Frames.Pop();
+				if (Frames.Num() > 0)
+				{
+					const int32 ParentIndex = Frames.Last().Key;
+					LowLinks[ParentIndex] = FMath::Min(LowLinks[ParentIndex], LowLinks[NodeIndex]);
+				}
+				if (LowLinks[NodeIndex] == DiscoveryOrder[NodeIndex])
+				{
+					const int32 ComponentIndex = OutComponentSizes.Add(0);
+					int32 MemberIndex = INDEX_NONE;
+					do
+					{
+						MemberIndex = Stack.Pop();
+						OnStack[MemberIndex] = false;
+						Components[MemberIndex] = ComponentIndex;
+						OutComponentSizes[ComponentIndex]++;
+					} while (MemberIndex != NodeIndex);
+				}
+			}
+		}
+
+		return Components;
+	}
+
+	// Can any of the StartIndices reach TargetIndex through Edges
+	static bool CanReach(const TArray<TArray<int32>>& Edges, const TArray<int32>& StartIndices, int32 TargetIndex)
+	{
+		TBitArray<> Visited(false, Edges.Num());
+		TArray<int32> Queue;
+		for (const int32 StartIndex : StartIndices)
+		{
+			if (!Visited[StartIndex])
+			{
+				Visited[StartIndex] = true;
+				Queue.Add(StartIndex);
+			}
+		}
+
+		while (Queue.Num() > 0)
+		{
+			const int32 NodeIndex = Queue.Pop();
+			if (NodeIndex == TargetIndex)
+			{
+				return true;
+			}
+			for (const int32 NextIndex : Edges[NodeIndex])
+			{
+				if (!Visited[NextIndex])
+				{
+					Visited[NextIndex] = true;
+					Queue.Add(NextIndex);
+				}
+			}
+		}
+		return false;
+	}
+}
 // Register Dialogue custom version with Core
 FDevVersionRegistration GRegisterDlgDialogueObjectVersion(FDlgDialogueObjectVersion::GUID,
 														  FDlgDialogueObjectVersion::LatestVersion, TEXT("Dev-DlgDialogue"));
@@ -67,6 +188,28 @@ void UDlgDialogue::PreSave(const class ITargetPlatform* TargetPlatform)
 	Name = GetDialogueFName();
 	bWasLoaded = true;
 	OnPreAssetSaved();
+
+#if WITH_EDITOR
+#if NY_ENGINE_VERSION >= 500
+	FoldConstantConditionsForCook(SaveContext.IsCooking());
+#else
+	FoldConstantConditionsForCook(TargetPlatform != nullptr);
+#endif
+#endif // WITH_EDITOR
+}
+
+#if NY_ENGINE_VERSION >= 500
+void UDlgDialogue::PostSaveRoot(FObjectPostSaveRootContext ObjectSaveContext)
+{
+	Super::PostSaveRoot(ObjectSaveContext);
+#else
+void UDlgDialogue::PostSaveRoot(bool bCleanupIsRequired)
+{
+	Super::PostSaveRoot(bCleanupIsRequired);
+#endif
+
+	// The save is not finished until the text files are written
+	WaitForPendingTextFileExports();
 }
 
 void UDlgDialogue::Serialize(FArchive& Ar)
@@ -127,6 +270,7 @@ void UDlgDialogue::PostLoad()
 			*GUID.ToString(), *GetPathName()
 		);
 	}
+	UDlgManager::RegisterDialogueGUID(this);
 
 #if WITH_EDITOR
 	const bool bHasDialogueEditorModule = GetDialogueEditorAccess().IsValid();
@@ -172,9 +316,18 @@ void UDlgDialogue::PostLoad()
 		}
 	}
 
+	// Not serialized, UpdateAndRefreshData is not called on every load
+	ResolveProxyChains();
+	AnalyzeNodeGraph();
 	bWasLoaded = true;
 }
 
+void UDlgDialogue::BeginDestroy()
+{
+	UDlgManager::UnregisterDialogueGUID(this);
+	Super::BeginDestroy();
+}
+
 void UDlgDialogue::PostInitProperties()
 {
 	Super::PostInitProperties();
@@ -208,6 +361,7 @@ void UDlgDialogue::PostInitProperties()
 			*GUID.ToString(), *GetPathName()
 		);
 	}
+	UDlgManager::RegisterDialogueGUID(this);
 }
 
 void UDlgDialogue::PostRename(UObject* OldOuter, const FName OldName)
@@ -435,6 +589,7 @@ void UDlgDialogue::ImportFromFile()
 		return;
 	}
 
+	WaitForPendingTextFileExports();
 	ImportFromFileFormat(TextFormat);
 }
 
@@ -504,6 +659,40 @@ void UDlgDialogue::ImportFromFileFormat(EDlgDialogueTextFormat TextFormat)
 			break;
 	}
 
+	PostImportFromFile();
+}
+
+bool UDlgDialogue::ImportFromBinaryPack(const FString& FilePath)
+{
+	FDlgBinaryParser Parser(FilePath);
+	if (!Parser.IsValidFile())
+	{
+		FDlgLogger::Get().Errorf(TEXT("Reloading data for Dialogue = `%s` FROM binary pack = `%s` FAILED"), *GetPathName(), *FilePath);
+		return false;
+	}
+
+	// Clear data first
+	StartNode_DEPRECATED = nullptr;
+	Nodes.Empty();
+	StartNodes.Empty();
+
+	FDlgLogger::Get().Infof(TEXT("Reloading data for Dialogue = `%s` FROM binary pack = `%s`"), *GetPathName(), *FilePath);
+	Parser.ReadAllProperty(GetClass(), this, this);
+	PostImportFromFile();
+	return true;
+}
+
+bool UDlgDialogue::ExportToBinaryPack(const FString& FilePath) const
+{
+	FDlgLogger::Get().Infof(TEXT("Exporting data for Dialogue = `%s` TO binary pack = `%s`"), *GetPathName(), *FilePath);
+
+	FDlgBinaryWriter Writer;
+	Writer.Write(GetClass(), this);
+	return Writer.ExportToFile(FilePath);
+}
+
+void UDlgDialogue::PostImportFromFile()
+{
 	if (IsValid(StartNode_DEPRECATED))
 	{
 		StartNodes.Add(StartNode_DEPRECATED);
@@ -516,27 +705,18 @@ void UDlgDialogue::ImportFromFileFormat(EDlgDialogueTextFormat TextFormat)
 	}
 
 	// TODO(vampy): validate if data is legit, indicies exist and that sort.
+	// The file may have changed the GUID, keep the index in sync
+	UDlgManager::RegisterDialogueGUID(this);
+
 	// Check if Guid is not a duplicate
-	const TArray<UDlgDialogue*> DuplicateDialogues = UDlgManager::GetDialoguesWithDuplicateGUIDs();
-	if (DuplicateDialogues.Num() > 0)
+	if (UDlgManager::HasDialogueDuplicateGUID(this))
 	{
-		if (DuplicateDialogues.Contains(this))
-		{
-			// found duplicate of this Dialogue
-			RegenerateGUID();
-			FDlgLogger::Get().Warningf(
-				TEXT("Creating new GUID = `%s` for Dialogue = `%s` because the input file contained a duplicate GUID."),
-				*GUID.ToString(), *GetPathName()
-			);
-		}
-		else
-		{
-			// We have bigger problems on our hands
-			FDlgLogger::Get().Errorf(
-				TEXT("Found Duplicate Dialogue that does not belong to this Dialogue = `%s`, DuplicateDialogues.Num = %d"),
-				*GetPathName(),  DuplicateDialogues.Num()
-			);
-		}
+		// found duplicate of this Dialogue
+		RegenerateGUID();
+		FDlgLogger::Get().Warningf(
+			TEXT("Creating new GUID = `%s` for Dialogue = `%s` because the input file contained a duplicate GUID."),
+			*GUID.ToString(), *GetPathName()
+		);
 	}
 
 	Name = GetDialogueFName();
@@ -564,33 +744,87 @@ void UDlgDialogue::ExportToFile() const
 		return;
 	}
 
+	// Previous export of the same files must finish first
+	WaitForPendingTextFileExports();
 	ExportToFileFormat(TextFormat);
 }
 
+void UDlgDialogue::WaitForPendingTextFileExports() const
+{
+	for (FDlgPendingTextFileExport& PendingExport : PendingTextFileExports)
+	{
+		const FDateTime TimeStamp = PendingExport.Task.Get();
+		if (TimeStamp == FDateTime::MinValue())
+		{
+			FDlgLogger::Get().Errorf(TEXT("Exporting data for Dialogue = `%s` TO file = `%s` FAILED"), *GetPathName(), *PendingExport.TextFileName);
+			ExportedTextFiles.Remove(PendingExport.TextFormat);
+			continue;
+		}
+
+		FDlgExportedTextFile& ExportedTextFile = ExportedTextFiles.FindOrAdd(PendingExport.TextFormat);
+		ExportedTextFile.Hash = PendingExport.Hash;
+		ExportedTextFile.TimeStamp = TimeStamp;
+	}
+	PendingTextFileExports.Empty();
+}
+
+void UDlgDialogue::ExportToFileAsync(EDlgDialogueTextFormat TextFormat, const FString& TextFileName, const TSharedRef<IDlgWriter, ESPMode::ThreadSafe>& Writer) const
+{
+	// Nothing changed since the last export and nobody touched the file
+	const uint32 Hash = FCrc::StrCrc32(*Writer->GetAsString());
+	const FDlgExportedTextFile* ExportedTextFile = ExportedTextFiles.Find(TextFormat);
+	if (ExportedTextFile && ExportedTextFile->Hash == Hash && ExportedTextFile->TimeStamp == IFileManager::Get().GetTimeStamp(*TextFileName))
+	{
+		FDlgLogger::Get().Debugf(TEXT("Skipping export for Dialogue = `%s` TO file = `%s`, the content did not change"), *GetPathName(), *TextFileName);
+		return;
+	}
+
+	FDlgLogger::Get().Infof(TEXT("Exporting data for Dialogue = `%s` TO file = `%s`"), *GetPathName(), *TextFileName);
+
+	// First export in this session, the file on disk might already be up to date
+	const bool bCompareWithFile = ExportedTextFile == nullptr;
+	FDlgPendingTextFileExport& PendingExport = PendingTextFileExports.AddDefaulted_GetRef();
+	PendingExport.TextFormat = TextFormat;
+	PendingExport.TextFileName = TextFileName;
+	PendingExport.Hash = Hash;
+	PendingExport.Task = Async(EAsyncExecution::ThreadPool, [Writer, TextFileName, bCompareWithFile]() -> FDateTime
+	{
+		IFileManager& FileManager = IFileManager::Get();
+		FString FileContent;
+		if (bCompareWithFile && FFileHelper::LoadFileToString(FileContent, *TextFileName) &&
+			FileContent.Equals(Writer->GetAsString(), ESearchCase::CaseSensitive))
+		{
+			return FileManager.GetTimeStamp(*TextFileName);
+		}
+
+		if (!Writer->ExportToFile(TextFileName))
+		{
+			return FDateTime::MinValue();
+		}
+		return FileManager.GetTimeStamp(*TextFileName);
+	});
+}
+
 void UDlgDialogue::ExportToFileFormat(EDlgDialogueTextFormat TextFormat) const
 {
-	// TODO(vampy): Check for errors
 	const bool bHasExtension = UDlgSystemSettings::HasTextFileExtension(TextFormat);
 	const FString& TextFileName = GetTextFilePathName(TextFormat);
-	if (bHasExtension)
-	{
-		FDlgLogger::Get().Infof(TEXT("Exporting data for Dialogue = `%s` TO file = `%s`"), *GetPathName(), *TextFileName);
-	}
 
+	// The serialization must happen here (reads the UObjects), only the file write is done in the background
 	switch (TextFormat)
 	{
 		case EDlgDialogueTextFormat::JSON:
 		{
-			FDlgJsonWriter JsonWriter;
-			JsonWriter.Write(GetClass(), this);
-			JsonWriter.ExportToFile(TextFileName);
+			const TSharedRef<FDlgJsonWriter, ESPMode::ThreadSafe> JsonWriter = MakeShared<FDlgJsonWriter, ESPMode::ThreadSafe>();
+			JsonWriter->Write(GetClass(), this);
+			ExportToFileAsync(TextFormat, TextFileName, JsonWriter);
 			break;
 		}
 		case EDlgDialogueTextFormat::DialogueDEPRECATED:
 		{
-			FDlgConfigWriter DlgWriter(TEXT("Dlg"));
-			DlgWriter.Write(GetClass(), this);
-			DlgWriter.ExportToFile(TextFileName);
+			const TSharedRef<FDlgConfigWriter, ESPMode::ThreadSafe> DlgWriter = MakeShared<FDlgConfigWriter, ESPMode::ThreadSafe>(TEXT("Dlg"));
+			DlgWriter->Write(GetClass(), this);
+			ExportToFileAsync(TextFormat, TextFileName, DlgWriter);
 			break;
 		}
 		case EDlgDialogueTextFormat::All:
@@ -796,6 +1030,9 @@ void UDlgDialogue::UpdateAndRefreshData(bool bUpdateTextsNamespacesAndKeys)
 	// Remove default values
 	AllSpeakerStates.Remove(FName(NAME_None));
 
+	ResolveProxyChains();
+	AnalyzeNodeGraph();
+
 	//
 	// Fill ParticipantClasses
 	//
@@ -829,13 +1066,6 @@ void UDlgDialogue::UpdateAndRefreshData(bool bUpdateTextsNamespacesAndKeys)
 	// 3. Set auto default participant classes
 	if (bWasLoaded && Settings->bAutoSetDefaultParticipantClasses)
 	{
-		TArray<UClass*> NativeClasses;
-		TArray<UClass*> BlueprintClasses;
-		FDlgHelper::GetAllClassesImplementingInterface(UDlgDialogueParticipant::StaticClass(), NativeClasses, BlueprintClasses);
-
-		const TMap<FGameplayTag, TArray<FDlgClassAndObject>> NativeClassesMap = FDlgHelper::ConvertDialogueParticipantsClassesIntoMap(NativeClasses);
-		const TMap<FGameplayTag, TArray<FDlgClassAndObject>> BlueprintClassesMap = FDlgHelper::ConvertDialogueParticipantsClassesIntoMap(BlueprintClasses);
-
 		for (FDlgParticipantClass& Struct : ParticipantsClasses)
 		{
 			// Participant Name is not set or Class is set, ignore
@@ -844,27 +1074,341 @@ void UDlgDialogue::UpdateAndRefreshData(bool bUpdateTextsNamespacesAndKeys)
 				continue;
 			}
 
-			// Blueprint
-			if (BlueprintClassesMap.Contains(Struct.ParticipantTag))
+			Struct.ParticipantClass = UDlgManager::GetDefaultParticipantClass(Struct.ParticipantTag);
+		}
+	}
+}
+
+void UDlgDialogue::ResolveProxyChains()
+{
+	const int32 NodesNum = Nodes.Num();
+	for (int32 NodeIndex = 0; NodeIndex < NodesNum; NodeIndex++)
+	{
+		UDlgNode_Proxy* Proxy = Cast<UDlgNode_Proxy>(Nodes[NodeIndex]);
+		if (!Proxy)
+		{
+			continue;
+		}
+
+		// Follow the targets until the first node that is not a proxy
+		TArray<int32> ProxyChain;
+		int32 TargetIndex = Proxy->GetTargetNodeIndex();
+		bool bCycle = false;
+		while (const UDlgNode_Proxy* TargetProxy = Nodes.IsValidIndex(TargetIndex) ? Cast<UDlgNode_Proxy>(Nodes[TargetIndex]) : nullptr)
+		{
+			if (TargetIndex == NodeIndex || ProxyChain.Contains(TargetIndex))
 			{
-				const TArray<FDlgClassAndObject>& Array = BlueprintClassesMap.FindChecked(Struct.ParticipantTag);
-				if (Array.Num() == 1)
-				{
-					Struct.ParticipantClass = Array[0].Class;
-				}
+				bCycle = true;
+				break;
 			}
+			ProxyChain.Add(TargetIndex);
+			TargetIndex = TargetProxy->GetTargetNodeIndex();
+		}
 
-			// Native last resort
-			if (Struct.ParticipantClass == nullptr && NativeClassesMap.Contains(Struct.ParticipantTag))
+		if (bCycle)
+		{
+			// Entering it terminates the dialogue, see UDlgNode_Proxy::HandleNodeEnter
+			FDlgLogger::Get().Errorf(
+				TEXT("Dialogue = `%s`, proxy Node %d is part of a cycle of proxies (Node %d is reached twice)"),
+				*GetPathName(), NodeIndex, TargetIndex
+			);
+			Proxy->ResetResolvedProxyChain();
+		}
+		else if (!Nodes.IsValidIndex(TargetIndex))
+		{
+			Proxy->ResetResolvedProxyChain();
+		}
+		else
+		{
+			Proxy->SetResolvedProxyChain(MoveTemp(ProxyChain), TargetIndex);
+		}
+	}
+}
+
+void UDlgDialogue::AnalyzeNodeGraph()
+{
+	const int32 NodesNum = Nodes.Num();
+
+	// Edges of the recursive evaluation (UDlgNode::CheckNodeEnterConditions):
+	// a node checking its children evaluates the nodes its edges lead to, a proxy evaluates its target
+	TArray<TArray<int32>> EvaluationEdges;
+	EvaluationEdges.SetNum(NodesNum);
+	TBitArray<> HasIncomingEvaluationEdge(false, NodesNum);
+	TArray<TArray<int32>> ChildrenIndices;
+	ChildrenIndices.SetNum(NodesNum);
+	for (int32 NodeIndex = 0; NodeIndex < NodesNum; NodeIndex++)
+	{
+		const UDlgNode* Node = Nodes[NodeIndex];
+		for (const FDlgEdge& Edge : Node->GetNodeChildren())
+		{
+			if (Edge.IsValid() && Nodes.IsValidIndex(Edge.TargetIndex))
+			{
+				ChildrenIndices[NodeIndex].AddUnique(Edge.TargetIndex);
+			}
+		}
+
+		if (const UDlgNode_Proxy* Proxy = Cast<UDlgNode_Proxy>(Node))
+		{
+			if (Nodes.IsValidIndex(Proxy->GetTargetNodeIndex()))
+			{
+				EvaluationEdges[NodeIndex].Add(Proxy->GetTargetNodeIndex());
+			}
+		}
+		else if (Node->GetCheckChildrenOnEvaluation())
+		{
+			EvaluationEdges[NodeIndex] = ChildrenIndices[NodeIndex];
+		}
+
+		for (const int32 TargetIndex : EvaluationEdges[NodeIndex])
+		{
+			HasIncomingEvaluationEdge[TargetIndex] = true;
+		}
+	}
+
+	// The evaluation of the children of a node (a step or the selector) starts from every child, the rest goes through the evaluation edges.
+	// The node can be reached again if it is in a cycle of evaluation edges or if one of its children leads back to it.
+	TArray<int32> ComponentSizes;
+	const TArray<int32> Components = DlgNodeGraph::FindStronglyConnectedComponents(EvaluationEdges, ComponentSizes);
+	int32 NumInEvaluationCycle = 0;
+	for (int32 NodeIndex = 0; NodeIndex < NodesNum; NodeIndex++)
+	{
+		bool bInEvaluationCycle = false;
+		if (HasIncomingEvaluationEdge[NodeIndex])
+		{
+			if (EvaluationEdges[NodeIndex].Num() > 0)
+			{
+				// The evaluation edges are the children (or the proxy target)
+				bInEvaluationCycle = ComponentSizes[Components[NodeIndex]] > 1 || EvaluationEdges[NodeIndex].Contains(NodeIndex);
+			}
+			else
 			{
-				const TArray<FDlgClassAndObject>& Array = NativeClassesMap.FindChecked(Struct.ParticipantTag);
-				if (Array.Num() == 1)
+				bInEvaluationCycle = DlgNodeGraph::CanReach(EvaluationEdges, ChildrenIndices[NodeIndex], NodeIndex);
+			}
+		}
+
+		Nodes[NodeIndex]->SetInEvaluationCycle(bInEvaluationCycle);
+		NumInEvaluationCycle += bInEvaluationCycle ? 1 : 0;
+	}
+
+	// Reachable from the start nodes through the edges and proxies, the nodes referenced by conditions are kept as well
+	TBitArray<> Reachable(false, NodesNum);
+	TArray<int32> Queue;
+	auto Visit = [this, &Reachable, &Queue](int32 NodeIndex)
+	{
+		if (Nodes.IsValidIndex(NodeIndex) && !Reachable[NodeIndex])
+		{
+			Reachable[NodeIndex] = true;
+			Queue.Add(NodeIndex);
+		}
+	};
+	auto VisitReferenced = [this, &Visit](const TArray<FDlgCondition>& Conditions)
+	{
+		for (const FDlgCondition& Condition : Conditions)
+		{
+			if (Condition.ConditionType == EDlgConditionType::WasNodeVisited || Condition.ConditionType == EDlgConditionType::HasSatisfiedChild)
+			{
+				Visit(Condition.IntValue);
+				if (Condition.GUID.IsValid())
 				{
-					Struct.ParticipantClass = Array[0].Class;
+					Visit(GetNodeIndexForGUID(Condition.GUID));
 				}
 			}
 		}
+	};
+	auto VisitFromNode = [&Visit, &VisitReferenced](const UDlgNode& Node)
+	{
+		VisitReferenced(Node.GetNodeEnterConditions());
+		for (const FDlgEdge& Edge : Node.GetNodeChildren())
+		{
+			VisitReferenced(Edge.Conditions);
+			if (Edge.IsValid())
+			{
+				Visit(Edge.TargetIndex);
+			}
+		}
+		if (const UDlgNode_Proxy* Proxy = Cast<UDlgNode_Proxy>(&Node))
+		{
+			Visit(Proxy->GetTargetNodeIndex());
+		}
+	};
+
+	for (const UDlgNode* StartNode : StartNodes)
+	{
+		if (StartNode)
+		{
+			VisitFromNode(*StartNode);
+		}
+	}
+	while (Queue.Num() > 0)
+	{
+		VisitFromNode(*Nodes[Queue.Pop()]);
 	}
+
+	UnreachableNodeIndices.Reset();
+	for (int32 NodeIndex = 0; NodeIndex < NodesNum; NodeIndex++)
+	{
+		if (!Reachable[NodeIndex])
+		{
+			UnreachableNodeIndices.Add(NodeIndex);
+		}
+	}
+
+	if (UnreachableNodeIndices.Num() > 0)
+	{
+		FString NodeIndices;
+		for (const int32 NodeIndex : UnreachableNodeIndices)
+		{
+			NodeIndices += FString::Printf(TEXT("%s%d"), NodeIndices.IsEmpty() ? TEXT("") : TEXT(", "), NodeIndex);
+		}
+		FDlgLogger::Get().Infof(
+			TEXT("Dialogue = `%s` has %d nodes that are not reachable from any start node: %s"),
+			*GetPathName(), UnreachableNodeIndices.Num(), *NodeIndices
+		);
+	}
+	FDlgLogger::Get().Debugf(
+		TEXT("Dialogue = `%s` has %d of %d nodes that the evaluation can reach again"),
+		*GetPathName(), NumInEvaluationCycle, NodesNum
+	);
+}
+
+#if WITH_EDITOR
+void UDlgDialogue::FoldConstantConditionsForCook(bool bCooking)
+{
+	if (!bCooking)
+	{
+		for (UDlgNode* Node : StartNodes)
+		{
+			Node->ResetCookedData();
+		}
+		for (UDlgNode* Node : Nodes)
+		{
+			Node->ResetCookedData();
+		}
+		return;
+	}
+
+	// Working copies, the start nodes are after the nodes
+	TArray<UDlgNode*> AllNodes = Nodes;
+	AllNodes.Append(StartNodes);
+	TArray<TArray<FDlgCondition>> EnterConditions;
+	TArray<TArray<FDlgEdge>> Children;
+	TArray<EDlgConditionConstant> EnterConstants;
+	TArray<TArray<EDlgConditionConstant>> EdgeConstants;
+	int32 NumConditionsBefore = 0;
+	for (const UDlgNode* Node : AllNodes)
+	{
+		EnterConditions.Add(Node->GetNodeEnterConditions());
+		Children.Add(Node->GetNodeChildren());
+		EnterConstants.Add(EDlgConditionConstant::Unknown);
+		EdgeConstants.Emplace_GetRef().Init(EDlgConditionConstant::Unknown, Children.Last().Num());
+		NumConditionsBefore += EnterConditions.Last().Num();
+		for (const FDlgEdge& Edge : Children.Last())
+		{
+			NumConditionsBefore += Edge.Conditions.Num();
+		}
+	}
+
+	// Only the nodes using the default CheckNodeEnterConditions, the rest (proxies, custom node classes) may check anything
+	auto HasDefaultEnterCheck = [this](int32 NodeIndex)
+	{
+		const UClass* Class = Nodes.IsValidIndex(NodeIndex) ? Nodes[NodeIndex]->GetClass() : nullptr;
+		return Class == UDlgNode_Speech::StaticClass() || Class == UDlgNode_SpeechSequence::StaticClass()
+			|| Class == UDlgNode_Selector::StaticClass() || Class == UDlgNode_End::StaticClass();
+	};
+	auto IsAlwaysEnterable = [&](int32 NodeIndex)
+	{
+		return HasDefaultEnterCheck(NodeIndex)
+			&& EnterConditions[NodeIndex].Num() == 0
+			&& !Nodes[NodeIndex]->GetCheckChildrenOnEvaluation()
+			&& Nodes[NodeIndex]->GetNodeEnterRestriction() == EDlgEntryRestriction::None;
+	};
+	auto IsNeverEnterable = [&](int32 NodeIndex)
+	{
+		return !Nodes.IsValidIndex(NodeIndex) || (HasDefaultEnterCheck(NodeIndex) && EnterConstants[NodeIndex] == EDlgConditionConstant::AlwaysFalse);
+	};
+
+	// HasSatisfiedChild is constant if one of the children is always satisfied or none of them can be
+	auto GetConstant = [&](const FDlgCondition& Condition)
+	{
+		if (Condition.ConditionType != EDlgConditionType::HasSatisfiedChild)
+		{
+			return EDlgConditionConstant::Unknown;
+		}
+
+		// Same lookup as FDlgCondition::IsConditionMet, no node is never satisfied regardless of bBoolValue
+		const int32 NodeIndex = Condition.GUID.IsValid() ? GetNodeIndexForGUID(Condition.GUID) : Condition.IntValue;
+		if (!Nodes.IsValidIndex(NodeIndex))
+		{
+			return EDlgConditionConstant::AlwaysFalse;
+		}
+
+		bool bCanBeSatisfied = false;
+		for (int32 EdgeIndex = 0; EdgeIndex < Children[NodeIndex].Num(); EdgeIndex++)
+		{
+			const FDlgEdge& Edge = Children[NodeIndex][EdgeIndex];
+			if (!Edge.IsValid() || IsNeverEnterable(Edge.TargetIndex) || EdgeConstants[NodeIndex][EdgeIndex] == EDlgConditionConstant::AlwaysFalse)
+			{
+				continue;
+			}
+			if (EdgeConstants[NodeIndex][EdgeIndex] == EDlgConditionConstant::AlwaysTrue && IsAlwaysEnterable(Edge.TargetIndex))
+			{
+				return Condition.bBoolValue ? EDlgConditionConstant::AlwaysTrue : EDlgConditionConstant::AlwaysFalse;
+			}
+			bCanBeSatisfied = true;
+		}
+		if (!bCanBeSatisfied)
+		{
+			return Condition.bBoolValue ? EDlgConditionConstant::AlwaysFalse : EDlgConditionConstant::AlwaysTrue;
+		}
+		return EDlgConditionConstant::Unknown;
+	};
+
+	// Folding a node can make the conditions pointing to it constant, repeat until nothing changes
+	bool bChanged = true;
+	while (bChanged)
+	{
+		bChanged = false;
+		for (int32 NodeIndex = 0; NodeIndex < AllNodes.Num(); NodeIndex++)
+		{
+			const EDlgConditionConstant EnterConstant = FDlgConditionProgram::FoldConstants(EnterConditions[NodeIndex], GetConstant);
+			bChanged |= EnterConstant != EnterConstants[NodeIndex];
+			EnterConstants[NodeIndex] = EnterConstant;
+
+			for (int32 EdgeIndex = 0; EdgeIndex < Children[NodeIndex].Num(); EdgeIndex++)
+			{
+				const EDlgConditionConstant EdgeConstant = FDlgConditionProgram::FoldConstants(Children[NodeIndex][EdgeIndex].Conditions, GetConstant);
+				bChanged |= EdgeConstant != EdgeConstants[NodeIndex][EdgeIndex];
+				EdgeConstants[NodeIndex][EdgeIndex] = EdgeConstant;
+			}
+		}
+	}
+
+	int32 NumConditionsAfter = 0;
+	int32 NumAlwaysSatisfiedEdges = 0;
+	for (int32 NodeIndex = 0; NodeIndex < AllNodes.Num(); NodeIndex++)
+	{
+		NumConditionsAfter += EnterConditions[NodeIndex].Num();
+		for (int32 EdgeIndex = 0; EdgeIndex < Children[NodeIndex].Num(); EdgeIndex++)
+		{
+			FDlgEdge& Edge = Children[NodeIndex][EdgeIndex];
+			NumConditionsAfter += Edge.Conditions.Num();
+			Edge.bAlwaysSatisfied = Edge.IsValid() && EdgeConstants[NodeIndex][EdgeIndex] == EDlgConditionConstant::AlwaysTrue && IsAlwaysEnterable(Edge.TargetIndex);
+			NumAlwaysSatisfiedEdges += Edge.bAlwaysSatisfied ? 1 : 0;
+		}
+		AllNodes[NodeIndex]->SetCookedData(MoveTemp(EnterConditions[NodeIndex]), MoveTemp(Children[NodeIndex]));
+	}
+
+	FDlgLogger::Get().Infof(
+		TEXT("Cooking Dialogue = `%s`: folded %d of %d conditions, %d edges are always satisfied"),
+		*GetPathName(), NumConditionsBefore - NumConditionsAfter, NumConditionsBefore, NumAlwaysSatisfiedEdges
+	);
+}
+#endif // WITH_EDITOR
+
+void UDlgDialogue::RegenerateGUID()
+{
+	GUID = FGuid::NewGuid();
+	UDlgManager::RegisterDialogueGUID(this);
 }
 
 FGuid UDlgDialogue::GetNodeGUIDForIndex(int32 NodeIndex) const
@@ -974,6 +1518,8 @@ bool UDlgDialogue::DeleteTextFileForExtension(const FString& FileExtension) cons
 		return false;
 	}
 
+	// Do not race with a background write of the same file
+	WaitForPendingTextFileExports();
 	const FString FullPathName = TextFilePathName + FileExtension;
 	return FDlgHelper::DeleteFile(FullPathName);
 }
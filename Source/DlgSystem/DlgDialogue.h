@@ -2,6 +2,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Async/Future.h"
 #include "Templates/SubclassOf.h"
 #include "Interfaces/Interface_AssetUserData.h"
 #include "Engine/AssetUserData.h"
@@ -18,6 +19,7 @@
 #include "DlgDialogue.generated.h"
 
 class UDlgNode;
+class IDlgWriter;
 
 // Custom serialization version for changes made in Dev-Dialogues stream
 struct DLGSYSTEM_API FDlgDialogueObjectVersion
@@ -97,6 +99,13 @@ public:
 #else
 	void PreSave(const class ITargetPlatform* TargetPlatform) override;
 #endif
+
+	/** Called after the package containing this object was saved, waits for the text file exports started in PreSave. */
+#if NY_ENGINE_VERSION >= 500
+	void PostSaveRoot(FObjectPostSaveRootContext ObjectSaveContext) override;
+#else
+	void PostSaveRoot(bool bCleanupIsRequired) override;
+#endif
 	/** UObject serializer. */
 	void Serialize(FArchive& Ar) override;
 
@@ -106,6 +115,9 @@ public:
 	 */
 	void PostLoad() override;
 
+	/** Removes this Dialogue from the UDlgManager GUID index. */
+	void BeginDestroy() override;
+
 	/**
 	 * Called after the C++ constructor and after the properties have been initialized, including those loaded from config.
 	 * mainly this is to emulate some behavior of when the constructor was called after the properties were initialized.
@@ -581,8 +593,8 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Dialogue|GUID")
 	FGuid GetGUID() const { check(GUID.IsValid()); return GUID; }
 
-	// Regenerate the GUID of this Dialogue
-	void RegenerateGUID() { GUID = FGuid::NewGuid(); }
+	// Regenerate the GUID of this Dialogue, also updates the UDlgManager GUID index
+	void RegenerateGUID();
 
 	UFUNCTION(BlueprintPure, Category = "Dialogue|GUID")
 	bool HasGUID() const { return GUID.IsValid(); }
@@ -591,6 +603,9 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Dialogue")
 	const TArray<UDlgNode*>& GetNodes() const { return Nodes; }
 
+	// Nodes that can not be entered from any start node and are not referenced by any condition, updated by UpdateAndRefreshData
+	const TArray<int32>& GetUnreachableNodeIndices() const { return UnreachableNodeIndices; }
+
 	// Gets the Start Node as a mutable pointer.
 	UE_DEPRECATED(4.24, "GetMutableStartNode has been deprecated in favour of GetMutableStartNodes")
 	UFUNCTION(BlueprintPure, Category = "Dialogue", DisplayName = "Get Start Node", meta = (DeprecatedFunction, DeprecationMessage = "Function has been deprecated, Please use GetMutableStartNodes"))
@@ -663,8 +678,19 @@ public:
 	}
 
 	// Exports this dialogue data into it's corresponding ".dlg" text file with the same name as this (Name).
+	// The file is written on a background task and only if its content changed, see WaitForPendingTextFileExports.
 	void ExportToFile() const;
 
+	// Blocks until all the text file writes started by ExportToFile are finished.
+	void WaitForPendingTextFileExports() const;
+
+	// Loads the dialogue data from a binary pack (see FDlgBinaryWriter), replacing the current nodes.
+	// NOTE: in the editor call ClearGraph afterwards to rebuild the graph from the dialogue data.
+	bool ImportFromBinaryPack(const FString& FilePath);
+
+	// Exports this dialogue data into a binary pack at FilePath, see FDlgBinaryPack::FileExtension
+	bool ExportToBinaryPack(const FString& FilePath) const;
+
 	// Updates the data of some nodes
 	// Fills the DlgData with the updated data
 	// NOTE: this can do a dialogue data -> graph node data update
@@ -709,9 +735,29 @@ private:
 	// Rebuild & Update and node and its edges
 	void RebuildAndUpdateNode(UDlgNode* Node, const UDlgSystemSettings& Settings, bool bUpdateTextsNamespacesAndKeys);
 
+	// Resolves every chain of proxy nodes to the node at its end, see UDlgNode_Proxy::SetResolvedProxyChain
+	void ResolveProxyChains();
+
+	// Finds the nodes the recursive evaluation can reach again (see UDlgNode::IsInEvaluationCycle) and the unreachable nodes
+	void AnalyzeNodeGraph();
+
+#if WITH_EDITOR
+	/**
+	 * Folds the conditions with a constant result and marks the edges that are always satisfied, for the cooked package only
+	 * (see UDlgNode::SetCookedData). Resets the cooked data of the nodes if bCooking is false.
+	 */
+	void FoldConstantConditionsForCook(bool bCooking);
+#endif
+
 	void ImportFromFileFormat(EDlgDialogueTextFormat TextFormat);
 	void ExportToFileFormat(EDlgDialogueTextFormat TextFormat) const;
 
+	// Fixes up the dialogue data after it was read from a file (start nodes, duplicate GUIDs, refresh)
+	void PostImportFromFile();
+
+	// Writes the output of the Writer to TextFileName on a background task, unless the file already has that content
+	void ExportToFileAsync(EDlgDialogueTextFormat TextFormat, const FString& TextFileName, const TSharedRef<IDlgWriter, ESPMode::ThreadSafe>& Writer) const;
+
 	// Updates NodesGUIDToIndexMap with Node
 	void UpdateGUIDToIndexMap(const UDlgNode* Node, int32 NodeIndex);
 
@@ -763,6 +809,27 @@ protected:
 	// Useful for syncing on the first run with the text file.
 	bool bIsSyncedWithTextFile = false;
 
+	// Last text file written (or found up to date) for a text format
+	struct FDlgExportedTextFile
+	{
+		// FCrc::StrCrc32 of the file content
+		uint32 Hash = 0;
+
+		// Used to detect if the file was modified outside of the editor since
+		FDateTime TimeStamp;
+	};
+	mutable TMap<EDlgDialogueTextFormat, FDlgExportedTextFile> ExportedTextFiles;
+
+	// Text file writes that are still running, the task returns the file time stamp or FDateTime::MinValue() on failure
+	struct FDlgPendingTextFileExport
+	{
+		EDlgDialogueTextFormat TextFormat = EDlgDialogueTextFormat::None;
+		FString TextFileName;
+		uint32 Hash = 0;
+		TFuture<FDateTime> Task;
+	};
+	mutable TArray<FDlgPendingTextFileExport> PendingTextFileExports;
+
 #if WITH_EDITORONLY_DATA
 	// EdGraph based representation of the DlgDialogue class
 	UPROPERTY(Meta = (DlgNoExport))
@@ -784,6 +851,9 @@ protected:
 	// Flag that indicates that This Was Loaded was called
 	bool bWasLoaded = false;
 
+	// See GetUnreachableNodeIndices
+	TArray<int32> UnreachableNodeIndices;
+
 public:
 	/** Array of user data stored with the asset (for IInterface_AssetUserData implementation) */
 	UPROPERTY(EditAnywhere, AdvancedDisplay, Instanced, Category = "Asset User Data")
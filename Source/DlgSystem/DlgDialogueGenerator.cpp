@@ -0,0 +1,307 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#include "DlgDialogueGenerator.h"
+
+#include "DlgDialogue.h"
+#include "DlgConstants.h"
+#include "DlgCondition.h"
+#include "DlgTextArgument.h"
+#include "Nodes/DlgNode_Start.h"
+#include "Nodes/DlgNode_Speech.h"
+#include "Nodes/DlgNode_SpeechSequence.h"
+#include "Nodes/DlgNode_Selector.h"
+#include "Nodes/DlgNode_Proxy.h"
+#include "Nodes/DlgNode_End.h"
+#include "Logging/DlgLogger.h"
+
+// Generated node types, decided before the edges are created
+enum class EDlgGeneratedNodeType : uint8
+{
+	Speech,
+	SpeechSequence,
+	Selector,
+	Proxy,
+	End
+};
+
+// Number of different variable/condition names the conditions use per participant
+static constexpr int32 NumGeneratedValueNames = 8;
+
+
+void FDlgDialogueGenerator::Generate(UDlgDialogue& Dialogue, const FDlgDialogueGeneratorOptions& Options)
+{
+	FDlgDialogueGenerator Generator(Dialogue, Options);
+	Generator.GenerateNodes();
+}
+
+UDlgDialogue* FDlgDialogueGenerator::GenerateNewDialogue(const FDlgDialogueGeneratorOptions& Options, UObject* Outer, FName Name)
+{
+	UDlgDialogue* Dialogue = NewObject<UDlgDialogue>(Outer, Name, Outer == GetTransientPackage() ? RF_Transient : RF_NoFlags);
+	Generate(*Dialogue, Options);
+	return Dialogue;
+}
+
+FDlgDialogueGenerator::FDlgDialogueGenerator(UDlgDialogue& InDialogue, const FDlgDialogueGeneratorOptions& InOptions)
+	: Dialogue(InDialogue), Options(InOptions), Stream(InOptions.Seed)
+{
+	Options.NumNodes = FMath::Max(1, Options.NumNodes);
+	Options.NumStartNodes = FMath::Max(1, Options.NumStartNodes);
+	Options.BranchingFactor = FMath::Max(1, Options.BranchingFactor);
+	Options.NumTextArguments = FMath::Max(0, Options.NumTextArguments);
+
+	const TArray<FGameplayTag> AllParticipantTags = {
+		TAG_Dlg_Hero, TAG_Dlg_Human, TAG_Dlg_Cat, TAG_Dlg_Frog, TAG_Dlg_Critter, TAG_Dlg_Object, TAG_Dlg_Other
+	};
+	const int32 NumParticipants = FMath::Clamp(Options.NumParticipants, 1, AllParticipantTags.Num());
+	for (int32 Index = 0; Index < NumParticipants; Index++)
+	{
+		ParticipantTags.Add(AllParticipantTags[Index]);
+	}
+}
+
+void FDlgDialogueGenerator::GenerateNodes()
+{
+	const int32 NumNodes = Options.NumNodes;
+
+	// Decide the types first, the edges depend on the type of the next node
+	TArray<EDlgGeneratedNodeType> NodeTypes;
+	NodeTypes.SetNum(NumNodes);
+	for (int32 NodeIndex = 0; NodeIndex < NumNodes; NodeIndex++)
+	{
+		EDlgGeneratedNodeType Type = EDlgGeneratedNodeType::Speech;
+		float Roll = Stream.FRand();
+		if ((Roll -= Options.ProxyRatio) < 0.f)
+		{
+			Type = EDlgGeneratedNodeType::Proxy;
+		}
+		else if ((Roll -= Options.SelectorRatio) < 0.f)
+		{
+			Type = EDlgGeneratedNodeType::Selector;
+		}
+		else if ((Roll -= Options.SpeechSequenceRatio) < 0.f)
+		{
+			Type = EDlgGeneratedNodeType::SpeechSequence;
+		}
+		else if ((Roll -= Options.EndRatio) < 0.f)
+		{
+			Type = EDlgGeneratedNodeType::End;
+		}
+
+		// Proxies always jump to the next node, which must not be the end of the dialogue.
+		// The first node or two end nodes in a row would cut the spine of the graph.
+		if (Type == EDlgGeneratedNodeType::End && (NodeIndex == 0 ||
+			NodeTypes[NodeIndex - 1] == EDlgGeneratedNodeType::Proxy || NodeTypes[NodeIndex - 1] == EDlgGeneratedNodeType::End))
+		{
+			Type = EDlgGeneratedNodeType::Speech;
+		}
+		NodeTypes[NodeIndex] = Type;
+	}
+
+	// The last node ends the dialogue, the one before can't be a proxy or an end node
+	NodeTypes.Last() = EDlgGeneratedNodeType::End;
+	if (NumNodes > 1 && (NodeTypes[NumNodes - 2] == EDlgGeneratedNodeType::Proxy || NodeTypes[NumNodes - 2] == EDlgGeneratedNodeType::End))
+	{
+		NodeTypes[NumNodes - 2] = EDlgGeneratedNodeType::Speech;
+	}
+
+	EndNodes.SetNum(NumNodes);
+	for (int32 NodeIndex = 0; NodeIndex < NumNodes; NodeIndex++)
+	{
+		EndNodes[NodeIndex] = NodeTypes[NodeIndex] == EDlgGeneratedNodeType::End;
+	}
+
+	TArray<UDlgNode*> Nodes;
+	Nodes.Reserve(NumNodes);
+	for (int32 NodeIndex = 0; NodeIndex < NumNodes; NodeIndex++)
+	{
+		const FString Prefix = FString::Printf(TEXT("Node %d"), NodeIndex);
+		UDlgNode* Node = nullptr;
+		switch (NodeTypes[NodeIndex])
+		{
+			case EDlgGeneratedNodeType::Speech:
+			{
+				auto* Speech = Dialogue.ConstructDialogueNode<UDlgNode_Speech>();
+				TArray<FDlgTextArgument> Arguments;
+				const FText Text = MakeText(Prefix, Arguments);
+				Speech->SetNodeText(Text, Arguments);
+				Speech->SetCheckChildrenOnEvaluation(Stream.FRand() < Options.CheckChildrenOnEvaluationRatio);
+				if (Stream.FRand() < Options.ConditionDensity)
+				{
+					Speech->SetNodeEnterConditions({ MakeCondition(NodeIndex) });
+				}
+				AddChildren(*Speech, NodeIndex, false, true);
+				Node = Speech;
+				break;
+			}
+			case EDlgGeneratedNodeType::SpeechSequence:
+			{
+				auto* Sequence = Dialogue.ConstructDialogueNode<UDlgNode_SpeechSequence>();
+				TArray<FDlgSpeechSequenceEntry>& Entries = *Sequence->GetMutableNodeSpeechSequence();
+				const int32 NumEntries = Stream.RandRange(2, 4);
+				for (int32 EntryIndex = 0; EntryIndex < NumEntries; EntryIndex++)
+				{
+					FDlgSpeechSequenceEntry Entry;
+					Entry.SpeakerTag = RandomParticipant();
+					Entry.Text = MakeText(FString::Printf(TEXT("%s Entry %d"), *Prefix, EntryIndex), Entry.TextArguments);
+					Entry.EdgeText = FText::FromString(TEXT("Next"));
+					Entries.Add(Entry);
+				}
+				AddChildren(*Sequence, NodeIndex, false, true);
+				Node = Sequence;
+				break;
+			}
+			case EDlgGeneratedNodeType::Selector:
+			{
+				auto* Selector = Dialogue.ConstructDialogueNode<UDlgNode_Selector>();
+				Selector->SetSelectorType(Stream.FRand() < 0.5f ? EDlgNodeSelectorType::First : EDlgNodeSelectorType::Random);
+				AddChildren(*Selector, NodeIndex, true, false);
+				Node = Selector;
+				break;
+			}
+			case EDlgGeneratedNodeType::Proxy:
+			{
+				auto* Proxy = Dialogue.ConstructDialogueNode<UDlgNode_Proxy>();
+				Proxy->SetTargetNodeIndex(NodeIndex + 1);
+				Node = Proxy;
+				break;
+			}
+			case EDlgGeneratedNodeType::End:
+			default:
+			{
+				Node = Dialogue.ConstructDialogueNode<UDlgNode_End>();
+				break;
+			}
+		}
+
+		Node->SetNodeParticipantTag(RandomParticipant());
+		Node->RegenerateGUID();
+		Nodes.Add(Node);
+	}
+
+	// The first start node always leads to the first node, the others to random nodes behind a condition
+	TArray<UDlgNode*> StartNodes;
+	for (int32 StartIndex = 0; StartIndex < Options.NumStartNodes; StartIndex++)
+	{
+		auto* StartNode = Dialogue.ConstructDialogueNode<UDlgNode_Start>();
+		FDlgEdge Edge(StartIndex == 0 ? 0 : Stream.RandHelper(NumNodes));
+		if (StartIndex > 0)
+		{
+			Edge.Conditions.Add(MakeCondition(INDEX_NONE));
+		}
+		StartNode->AddNodeChild(Edge);
+		StartNode->RegenerateGUID();
+		StartNodes.Add(StartNode);
+	}
+
+	Dialogue.EmptyNodesGUIDToIndexMap();
+	Dialogue.SetNodes(Nodes);
+	Dialogue.SetStartNodes(StartNodes);
+	Dialogue.UpdateAndRefreshData(true);
+
+	FDlgLogger::Get().Debugf(
+		TEXT("Generated Dialogue = `%s` with %d nodes, %d start nodes, %d participants (Seed = %d)"),
+		*Dialogue.GetPathName(), Nodes.Num(), StartNodes.Num(), ParticipantTags.Num(), Options.Seed
+	);
+}
+
+void FDlgDialogueGenerator::AddChildren(UDlgNode& Node, int32 NodeIndex, bool bOnlyForward, bool bWithText)
+{
+	const int32 NumNodes = Options.NumNodes;
+	TArray<int32> Targets;
+
+	// Keep every node reachable, jump over the end node so the nodes after it are reachable too
+	if (NodeIndex + 1 < NumNodes)
+	{
+		Targets.Add(NodeIndex + 1);
+		if (EndNodes[NodeIndex + 1] && NodeIndex + 2 < NumNodes)
+		{
+			Targets.AddUnique(NodeIndex + 2);
+		}
+	}
+
+	const int32 NumChildren = Stream.RandRange(1, Options.BranchingFactor);
+	const int32 MinTarget = bOnlyForward ? NodeIndex + 1 : 0;
+	for (int32 Try = 0; Targets.Num() < NumChildren && Try < NumChildren * 2 && MinTarget < NumNodes; Try++)
+	{
+		const int32 Target = Stream.RandRange(MinTarget, NumNodes - 1);
+		if (Target != NodeIndex)
+		{
+			Targets.AddUnique(Target);
+		}
+	}
+
+	for (int32 ChildIndex = 0; ChildIndex < Targets.Num(); ChildIndex++)
+	{
+		FDlgEdge Edge(Targets[ChildIndex]);
+		if (bWithText)
+		{
+			Edge.SetText(FText::FromString(FString::Printf(TEXT("Option %d"), ChildIndex)));
+		}
+		// The first edge keeps the graph connected, do not block it
+		if (ChildIndex > 0 && Stream.FRand() < Options.ConditionDensity)
+		{
+			Edge.Conditions.Add(MakeCondition(NodeIndex));
+		}
+		Node.AddNodeChild(Edge);
+	}
+}
+
+FDlgCondition FDlgDialogueGenerator::MakeCondition(int32 NodeIndex)
+{
+	static const EDlgConditionType ConditionTypes[] = {
+		EDlgConditionType::IntCall,
+		EDlgConditionType::FloatCall,
+		EDlgConditionType::BoolCall,
+		EDlgConditionType::NameCall,
+		EDlgConditionType::EventCall,
+		EDlgConditionType::WasNodeVisited
+	};
+	static const EDlgOperation Operations[] = {
+		EDlgOperation::Equal,
+		EDlgOperation::NotEqual,
+		EDlgOperation::Less,
+		EDlgOperation::LessOrEqual,
+		EDlgOperation::Greater,
+		EDlgOperation::GreaterOrEqual
+	};
+
+	FDlgCondition Condition;
+	Condition.ConditionType = ConditionTypes[Stream.RandHelper(UE_ARRAY_COUNT(ConditionTypes))];
+	Condition.Strength = Stream.FRand() < 0.75f ? EDlgConditionStrength::Strong : EDlgConditionStrength::Weak;
+	Condition.ParticipantTag = RandomParticipant();
+	Condition.CallbackName = FName(TEXT("Value"), Stream.RandHelper(NumGeneratedValueNames) + 1);
+	Condition.Operation = Operations[Stream.RandHelper(UE_ARRAY_COUNT(Operations))];
+	Condition.IntValue = Stream.RandRange(-10, 10);
+	Condition.FloatValue = Stream.FRandRange(-10.f, 10.f);
+	Condition.NameValue = FName(TEXT("Value"), Stream.RandHelper(NumGeneratedValueNames) + 1);
+	Condition.bBoolValue = Stream.FRand() < 0.5f;
+
+	if (Condition.ConditionType == EDlgConditionType::WasNodeVisited)
+	{
+		// Any node but this one
+		Condition.IntValue = Stream.RandHelper(Options.NumNodes);
+		if (Condition.IntValue == NodeIndex)
+		{
+			Condition.IntValue = (Condition.IntValue + 1) % Options.NumNodes;
+		}
+		Condition.bLongTermMemory = Stream.FRand() < 0.5f;
+	}
+
+	return Condition;
+}
+
+FText FDlgDialogueGenerator::MakeText(const FString& Prefix, TArray<FDlgTextArgument>& OutArguments)
+{
+	FString String = Prefix;
+	OutArguments.Empty(Options.NumTextArguments);
+	for (int32 ArgumentIndex = 0; ArgumentIndex < Options.NumTextArguments; ArgumentIndex++)
+	{
+		FDlgTextArgument Argument;
+		Argument.DisplayString = FString::Printf(TEXT("Arg%d"), ArgumentIndex);
+		Argument.Type = EDlgTextArgumentType::DisplayName;
+		Argument.ParticipantTag = RandomParticipant();
+		String += FString::Printf(TEXT(" {%s}"), *Argument.DisplayString);
+		OutArguments.Add(Argument);
+	}
+
+	return FText::FromString(String);
+}
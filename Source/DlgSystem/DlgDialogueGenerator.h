@@ -0,0 +1,105 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/RandomStream.h"
+#include "UObject/Package.h"
+#include "GameplayTagContainer.h"
+
+#include "DlgDialogueGenerator.generated.h"
+
+class UDlgDialogue;
+class UDlgNode;
+struct FDlgCondition;
+struct FDlgTextArgument;
+
+
+// Shape of a procedurally generated Dialogue, see FDlgDialogueGenerator
+USTRUCT(BlueprintType)
+struct DLGSYSTEM_API FDlgDialogueGeneratorOptions
+{
+	GENERATED_USTRUCT_BODY()
+
+public:
+	// Same Seed and options always generate the same Dialogue
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dialogue|Generator")
+	int32 Seed = 0;
+
+	// Number of nodes, without the start nodes
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dialogue|Generator", meta = (ClampMin = 1))
+	int32 NumNodes = 100;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dialogue|Generator", meta = (ClampMin = 1))
+	int32 NumStartNodes = 1;
+
+	// Maximum number of children of a node, every node that is not an end node has at least one
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dialogue|Generator", meta = (ClampMin = 1))
+	int32 BranchingFactor = 3;
+
+	// Participants are taken from the native Dlg tags
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dialogue|Generator", meta = (ClampMin = 1, ClampMax = 7))
+	int32 NumParticipants = 2;
+
+	// Chance of an edge or a node to have a condition
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dialogue|Generator", meta = (ClampMin = 0, ClampMax = 1))
+	float ConditionDensity = 0.25f;
+
+	// Chance of a node to be a proxy, selector, speech sequence or end node, the rest are speech nodes
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dialogue|Generator", meta = (ClampMin = 0, ClampMax = 1))
+	float ProxyRatio = 0.05f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dialogue|Generator", meta = (ClampMin = 0, ClampMax = 1))
+	float SelectorRatio = 0.1f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dialogue|Generator", meta = (ClampMin = 0, ClampMax = 1))
+	float SpeechSequenceRatio = 0.1f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dialogue|Generator", meta = (ClampMin = 0, ClampMax = 1))
+	float EndRatio = 0.05f;
+
+	// Number of text arguments of every node text
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dialogue|Generator", meta = (ClampMin = 0))
+	int32 NumTextArguments = 1;
+
+	// Chance of a speech node to have bCheckChildrenOnEvaluation, selectors always have it
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dialogue|Generator", meta = (ClampMin = 0, ClampMax = 1))
+	float CheckChildrenOnEvaluationRatio = 0.1f;
+};
+
+
+/**
+ * Generates dialogues with a configurable shape, used for benchmarks and stress tests.
+ * Every node is reachable from the start node (node i always has an edge to node i + 1),
+ * nodes that step automatically (proxies, selectors) only point forward so they can't loop.
+ */
+class DLGSYSTEM_API FDlgDialogueGenerator
+{
+public:
+	/**
+	 * Replaces the nodes of the Dialogue with generated ones and refreshes the data.
+	 * Does not touch the editor graph, see FDlgEditorUtilities::CreateGeneratedDialogue.
+	 */
+	static void Generate(UDlgDialogue& Dialogue, const FDlgDialogueGeneratorOptions& Options);
+
+	// Creates a new Dialogue and fills it with Generate
+	static UDlgDialogue* GenerateNewDialogue(const FDlgDialogueGeneratorOptions& Options, UObject* Outer = GetTransientPackage(), FName Name = NAME_None);
+
+private:
+	FDlgDialogueGenerator(UDlgDialogue& InDialogue, const FDlgDialogueGeneratorOptions& InOptions);
+
+	void GenerateNodes();
+	void AddChildren(UDlgNode& Node, int32 NodeIndex, bool bOnlyForward, bool bWithText);
+
+	FDlgCondition MakeCondition(int32 NodeIndex);
+	FText MakeText(const FString& Prefix, TArray<FDlgTextArgument>& OutArguments);
+	const FGameplayTag& RandomParticipant() { return ParticipantTags[Stream.RandHelper(ParticipantTags.Num())]; }
+
+private:
+	UDlgDialogue& Dialogue;
+	FDlgDialogueGeneratorOptions Options;
+	FRandomStream Stream;
+	TArray<FGameplayTag> ParticipantTags;
+
+	// Index is the node index
+	TArray<bool> EndNodes;
+};
@@ -1,11 +1,14 @@
 // Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
 #include "DlgEdge.h"
 
+#include "DlgConditionProgram.h"
 #include "DlgConstants.h"
 #include "DlgSystem/DlgContext.h"
+#include "DlgDialogue.h"
 #include "DlgLocalizationHelper.h"
 #include "Nodes/DlgNode_Selector.h"
 #include "Nodes/DlgNode_Speech.h"
+#include "DlgStats.h"
 
 bool FDlgEdge::IsTextVisible(const UDlgNode& ParentNode)
 {
@@ -81,30 +84,33 @@ void FDlgEdge::UpdateTextsNamespacesAndKeys(const UObject* ParentObject, const U
 	FDlgLocalizationHelper::UpdateTextNamespaceAndKey(ParentObject, Settings, Text);
 }
 
-bool FDlgEdge::Evaluate(const UDlgContext& Context, TSet<const UDlgNode*> AlreadyVisitedNodes) const
+bool FDlgEdge::Evaluate(const UDlgContext& Context, TSet<const UDlgNode*> AlreadyVisitedNodes, const UDlgNode* OwnerNode) const
 {
 	if (!IsValid())
 	{
 		return false;
 	}
 
-	// Check target node enter conditions
-	if (!Context.IsNodeEnterable(TargetIndex, AlreadyVisitedNodes))
-	{
-		return false;
-	}
-
-	// Check this edge conditions
-	return FDlgCondition::EvaluateArray(Context, Conditions);
+	// Check target node enter conditions and this edge conditions
+	const bool bSatisfied = bAlwaysSatisfied
+		|| (Context.IsNodeEnterable(TargetIndex, AlreadyVisitedNodes) && FDlgConditionProgram::EvaluateCached(ConditionProgram, Context, Conditions));
+	// The recursive evaluation checks edges of other nodes than the active one, only looked up when tracing
+	DLG_CONTEXT_TRACE(Context, AddEdge(
+		OwnerNode ? Context.GetDialogue()->GetNodeIndexForGUID(OwnerNode->GetGUID()) : Context.GetActiveNodeIndex(),
+		TargetIndex, bSatisfied
+	));
+	return bSatisfied;
 }
 
 void FDlgEdge::RebuildConstructedText(const UDlgContext& Context, const FGameplayTag& FallbackParticipantTag)
 {
+	DLG_SCOPE_CYCLE_COUNTER(RebuildText);
 	if (TextArguments.Num() <= 0)
 	{
 		return;
 	}
 
+	DLG_INC_COUNTER(TextsFormatted);
 	FFormatNamedArguments OrderedArguments;
 	for (const FDlgTextArgument& DlgArgument : TextArguments)
 	{
@@ -14,6 +14,7 @@ class UDlgContext;
 class UDlgNode;
 class UDlgDialogue;
 class UDlgNodeData;
+struct FDlgConditionProgram;
 
 /**
  * The representation of a child in a node. Defined by a TargetIndex which points to the index array in the Dialogue.Nodes
@@ -38,7 +39,8 @@ public:
 			Text.EqualTo(Other.Text) &&
 			bIncludeInAllOptionListIfUnsatisfied == Other.bIncludeInAllOptionListIfUnsatisfied &&
 			TextArguments == Other.TextArguments &&
-			Conditions == Other.Conditions;
+			Conditions == Other.Conditions &&
+			bAlwaysSatisfied == Other.bAlwaysSatisfied;
 	}
 
 	bool operator!=(const FDlgEdge& Other) const
@@ -66,7 +68,11 @@ public:
 	void RebuildTextArgumentsFromPreview(const FText& Preview) { FDlgTextArgument::UpdateTextArgumentArray(Preview, TextArguments); }
 
 	// Returns with true if every condition attached to the edge and every enter condition of the target node are satisfied //
-	bool Evaluate(const UDlgContext& Context, TSet<const UDlgNode*> AlreadyVisitedNodes) const;
+	// OwnerNode is the node this edge belongs to, the context trace records it as the source of the edge (the active node if not set).
+	bool Evaluate(const UDlgContext& Context, TSet<const UDlgNode*> AlreadyVisitedNodes, const UDlgNode* OwnerNode = nullptr) const;
+
+	// Resets the compiled Conditions, call it after modifying the Conditions in place
+	void InvalidateConditionProgram() const { ConditionProgram.Reset(); }
 
 	// Constructs the ConstructedText.
 	void RebuildConstructedText(const UDlgContext& Context, const FGameplayTag& FallbackParticipantTag);
@@ -135,6 +141,11 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Instanced, Category = "DialogueEdge")
 	UDlgNodeData* EdgeData = nullptr;
 
+	// Only set in cooked data, the conditions were folded away and the target node has nothing to check so Evaluate skips it.
+	// See UDlgDialogue::FoldConstantConditionsForCook
+	UPROPERTY(Meta = (DlgNoExport))
+	bool bAlwaysSatisfied = false;
+
 protected:
 	// Some Variables are here to stop misuse
 
@@ -148,6 +159,9 @@ protected:
 
 	// Constructed at runtime from the original text and the arguments if there is any.
 	FText ConstructedText;
+
+	// Conditions compiled on the first Evaluate, see FDlgConditionProgram
+	mutable TSharedPtr<const FDlgConditionProgram> ConditionProgram;
 };
 
 template<>
@@ -1,15 +1,28 @@
 // Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
 #include "DlgEvent.h"
 
+#include "Misc/ScopeExit.h"
+
 #include "DlgConstants.h"
 #include "DlgContext.h"
 #include "NYReflectionHelper.h"
 #include "DlgDialogueParticipant.h"
 #include "DlgHelper.h"
 #include "Logging/DlgLogger.h"
+#include "DlgStats.h"
 
 void FDlgEvent::Call(UDlgContext& Context, const FString& ContextString, UObject* Participant) const
 {
+	DLG_SCOPE_CYCLE_COUNTER(CallEvent);
+	DLG_INC_COUNTER(EventsCalled);
+	DLG_CONTEXT_TRACE(Context, AddEvent(Context.GetActiveNodeIndex(), *this));
+
+	// The event can modify any participant value
+	ON_SCOPE_EXIT
+	{
+		Context.InvalidateParticipantValueCache();
+	};
+
 	const bool bHasParticipant = ValidateIsParticipantValid(
 		Context,
 		FString::Printf(TEXT("%s::Call"), *ContextString),
@@ -21,13 +34,15 @@ void FDlgEvent::Call(UDlgContext& Context, const FString& ContextString, UObject
 	{
 		if (CustomEvent == nullptr)
 		{
-			FDlgLogger::Get().Warningf(
+			DLG_LOG_WARNING_RATE_LIMITED(
 				TEXT("Custom Event is empty (not valid). Ignoring. Context:\n\t%s, Participant = %s"),
 				*Context.GetContextString(), Participant ? *Participant->GetPathName() : TEXT("INVALID")
 			);
 			return;
 		}
 
+		DLG_TRACE_SCOPE(DlgEvent_Custom);
+		DLG_INC_COUNTER(ParticipantCalls);
 		CustomEvent->EnterEvent(&Context, Participant);
 		return;
 	}
@@ -40,18 +55,23 @@ void FDlgEvent::Call(UDlgContext& Context, const FString& ContextString, UObject
 	switch (EventType)
 	{
 		case EDlgEventType::Event:
+			DLG_INC_COUNTER(ParticipantCalls);
 			IDlgDialogueParticipant::Execute_OnDialogueEvent(Participant, &Context, EventName);
 			break;
 		case EDlgEventType::ModifyInt:
+			DLG_INC_COUNTER(ParticipantCalls);
 			IDlgDialogueParticipant::Execute_ModifyIntValue(Participant, EventName, bDelta, IntValue);
 			break;
 		case EDlgEventType::ModifyFloat:
+			DLG_INC_COUNTER(ParticipantCalls);
 			IDlgDialogueParticipant::Execute_ModifyFloatValue(Participant, EventName, bDelta, FloatValue);
 			break;
 		case EDlgEventType::ModifyBool:
+			DLG_INC_COUNTER(ParticipantCalls);
 			IDlgDialogueParticipant::Execute_ModifyBoolValue(Participant, EventName, bValue);
 			break;
 		case EDlgEventType::ModifyName:
+			DLG_INC_COUNTER(ParticipantCalls);
 			IDlgDialogueParticipant::Execute_ModifyNameValue(Participant, EventName, NameValue);
 			break;
 
@@ -151,14 +171,14 @@ bool FDlgEvent::ValidateIsParticipantValid(const UDlgContext& Context, const FSt
 
 	if (MustHaveParticipant())
 	{
-		FDlgLogger::Get().Errorf(
+		DLG_LOG_ERROR_RATE_LIMITED(
 			TEXT("%s - Event FAILED because the PARTICIPANT is INVALID. \nContext:\n\t%s, \n\tParticipantTag = %s, EventType = %s, EventName = %s, CustomEvent = %s"),
 			*ContextString, *Context.GetContextString(), *ParticipantTag.ToString(), *EventTypeToString(EventType), *EventName.ToString(), *GetCustomEventName()
 		);
 	}
 	else
 	{
-		FDlgLogger::Get().Warningf(
+		DLG_LOG_WARNING_RATE_LIMITED(
 			TEXT("%s - Event WARNING because the PARTICIPANT is INVALID. The call will NOT FAIL, but the participant is not present. \nContext:\n\t%s, \n\tParticipantTag = %s, EventType = %s, EventName = %s, CustomEvent = %s"),
 			*ContextString, *Context.GetContextString(), *ParticipantTag.ToString(), *EventTypeToString(EventType), *EventName.ToString(), *GetCustomEventName()
 		);
@@ -183,11 +203,13 @@ void FDlgEvent::CallUnrealFunction(UDlgContext& Context, const FString& ContextS
 
 	if (UFunction* Function = Participant->FindFunction(EventName))
 	{
+		DLG_TRACE_SCOPE(DlgEvent_UnrealFunction);
+		DLG_INC_COUNTER(ParticipantCalls);
 		Participant->ProcessEvent(Function, nullptr);
 	}
 	else
 	{
-		FDlgLogger::Get().Warningf(
+		DLG_LOG_WARNING_RATE_LIMITED(
 			TEXT("Unreal Function %s Not Found. Ignoring. Context:\n\t%s, Participant = %s"),
 			*EventName.ToString(), *Context.GetContextString(), Participant ? *Participant->GetPathName() : TEXT("INVALID")
 		);
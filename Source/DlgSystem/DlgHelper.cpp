@@ -11,6 +11,8 @@
 #include "UObject/UObjectIterator.h"
 #include "Framework/Docking/TabManager.h"
 #include "DlgConstants.h"
+#include "GameplayTagsManager.h"
+#include "Misc/ScopeRWLock.h"
 
 bool FDlgHelper::DeleteFile(const FString& PathName, bool bVerbose)
 {
@@ -294,54 +296,138 @@ TMap<FGameplayTag, TArray<FDlgClassAndObject>> FDlgHelper::ConvertDialoguePartic
 }
 
 
+namespace DlgParticipantTags
+{
+	// Precomputed metadata of a tag under Dlg (including Dlg itself)
+	struct FTagInfo
+	{
+		EDlgParticipantTagType Type = EDlgParticipantTagType::MAX;
+		FString LeafString;
+	};
+
+	// Empty and not used until RebuildParticipantTagsCache is called once the native tags are added
+	static TMap<FGameplayTag, FTagInfo> Cache;
+	static bool bCacheBuilt = false;
+
+	// Dialogues can be loaded outside of the game thread
+	static FRWLock CacheLock;
+
+	static EDlgParticipantTagType ComputeType(const FGameplayTag& ParticipantTag)
+	{
+		if (ParticipantTag.MatchesTag(TAG_Dlg))
+		{
+			const uint8 enum_value = UGameplayTagsManager::Get().GetNumberOfTagNodes(ParticipantTag) - 1;
+			if (enum_value <= (uint8)EDlgParticipantTagType::MAX)
+			{
+				return EDlgParticipantTagType(enum_value);
+			}
+		}
+
+		return EDlgParticipantTagType::MAX;
+	}
+
+	static FString ComputeLeafString(const FGameplayTag& ParticipantTag)
+	{
+		if (ParticipantTag.IsValid() && ComputeType(ParticipantTag) == EDlgParticipantTagType::PARTICIPANT)
+		{
+			// Convert the gameplay tag to a string
+			FString TagString = ParticipantTag.ToString();
+
+			// Split the tag string by the '.' delimiter
+			TArray<FString> TagParts;
+			TagString.ParseIntoArray(TagParts, TEXT("."), true);
+
+			// Return the last part if there are any elements
+			if (TagParts.Num() > 0)
+			{
+				FString leaf_string;
+				if (ParticipantTag.MatchesTag(TAG_Dlg_Hero))
+				{
+					leaf_string += FString::Printf(TEXT("Hero "));
+				}
+
+				return leaf_string + TagParts.Last();  // Last part of the tag
+			}
+		}
+
+		return FString("None");
+	}
+}
+
+void UBSDlgFunctions::RebuildParticipantTagsCache()
+{
+	using namespace DlgParticipantTags;
+
+	TMap<FGameplayTag, FTagInfo> NewCache;
+	if (TAG_Dlg.GetTag().IsValid())
+	{
+		FGameplayTagContainer Tags = UGameplayTagsManager::Get().RequestGameplayTagChildren(TAG_Dlg);
+		Tags.AddTag(TAG_Dlg);
+		NewCache.Reserve(Tags.Num());
+		for (const FGameplayTag& Tag : Tags)
+		{
+			FTagInfo& Info = NewCache.Add(Tag);
+			Info.Type = ComputeType(Tag);
+			Info.LeafString = ComputeLeafString(Tag);
+		}
+	}
+
+	FRWScopeLock Lock(CacheLock, SLT_Write);
+	Cache = MoveTemp(NewCache);
+	bCacheBuilt = true;
+}
+
 bool UBSDlgFunctions::IsValidParticipantTag(const FGameplayTag& ParticipantTag, EDlgParticipantTagType DesiredType)
 {
-	return ParticipantTag.IsValid() &&
-		ParticipantTag.MatchesTag(TAG_Dlg) &&
-		(DesiredType == EDlgParticipantTagType::MAX || GetParticipantTagType(ParticipantTag) == DesiredType);
+	if (!ParticipantTag.IsValid())
+	{
+		return false;
+	}
+
+	{
+		using namespace DlgParticipantTags;
+		FRWScopeLock Lock(CacheLock, SLT_ReadOnly);
+		if (bCacheBuilt)
+		{
+			const FTagInfo* Info = Cache.Find(ParticipantTag);
+			return Info && (DesiredType == EDlgParticipantTagType::MAX || Info->Type == DesiredType);
+		}
+	}
+
+	return ParticipantTag.MatchesTag(TAG_Dlg) &&
+		(DesiredType == EDlgParticipantTagType::MAX || DlgParticipantTags::ComputeType(ParticipantTag) == DesiredType);
 }
 
 
 EDlgParticipantTagType UBSDlgFunctions::GetParticipantTagType(const FGameplayTag& ParticipantTag)
 {
-	if (ParticipantTag.MatchesTag(TAG_Dlg))
 	{
-		const uint8 enum_value = UGameplayTagsManager::Get().GetNumberOfTagNodes(ParticipantTag) - 1;
-		if (enum_value <= (uint8)EDlgParticipantTagType::MAX)
+		using namespace DlgParticipantTags;
+		FRWScopeLock Lock(CacheLock, SLT_ReadOnly);
+		if (bCacheBuilt)
 		{
-			return EDlgParticipantTagType(enum_value);
+			const FTagInfo* Info = Cache.Find(ParticipantTag);
+			return Info ? Info->Type : EDlgParticipantTagType::MAX;
 		}
 	}
 
-	return EDlgParticipantTagType::MAX;
+	return DlgParticipantTags::ComputeType(ParticipantTag);
 }
 
 
 FString UBSDlgFunctions::GetParticipantLeafTagAsString(const FGameplayTag& ParticipantTag)
 {
-	if (IsValidParticipantTag(ParticipantTag, EDlgParticipantTagType::PARTICIPANT))
 	{
-		// Convert the gameplay tag to a string
-		FString TagString = ParticipantTag.ToString();
-
-		// Split the tag string by the '.' delimiter
-		TArray<FString> TagParts;
-		TagString.ParseIntoArray(TagParts, TEXT("."), true);
-
-		// Return the last part if there are any elements
-		if (TagParts.Num() > 0)
+		using namespace DlgParticipantTags;
+		FRWScopeLock Lock(CacheLock, SLT_ReadOnly);
+		if (bCacheBuilt)
 		{
-			FString leaf_string;
-			if (ParticipantTag.MatchesTag(TAG_Dlg_Hero))
-			{
-				leaf_string += FString::Printf(TEXT("Hero "));
-			}
-
-			return leaf_string + TagParts.Last();  // Last part of the tag
+			const FTagInfo* Info = Cache.Find(ParticipantTag);
+			return Info ? Info->LeafString : FString("None");
 		}
 	}
 
-	return FString("None");
+	return DlgParticipantTags::ComputeLeafString(ParticipantTag);
 }
 
 
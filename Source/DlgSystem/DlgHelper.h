@@ -620,4 +620,8 @@ public:
 	/** Returns only the last 2 parts of the gameplay tag.*/
 	UFUNCTION(BlueprintCallable)
 	static FGameplayTag GetParticipantTypeTag(const FGameplayTag& ParticipantTag);
+
+	// Precomputes the validity, type and leaf string of every tag under Dlg, the functions above use it from then on.
+	// Called by the module once the native tags are added and every time the gameplay tag tree changes.
+	static void RebuildParticipantTagsCache();
 };
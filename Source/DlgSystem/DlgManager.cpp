@@ -2,6 +2,7 @@
 #include "DlgManager.h"
 
 #include "UObject/UObjectIterator.h"
+#include "Misc/ScopeLock.h"
 #include "Engine/ObjectLibrary.h"
 #include "Interfaces/IPluginManager.h"
 #include "Engine/Blueprint.h"
@@ -17,11 +18,24 @@
 #include "Logging/DlgLogger.h"
 #include "DlgHelper.h"
 #include "NYReflectionHelper.h"
+#include "DlgStats.h"
 
 TWeakObjectPtr<const UObject> UDlgManager::UserWorldContextObjectPtr = nullptr;
 
 bool UDlgManager::bCalledLoadAllDialoguesIntoMemory = false;;
 
+TMultiMap<FGuid, UDlgDialogue*> UDlgManager::DialoguesGUIDIndex;
+TMap<UDlgDialogue*, FGuid> UDlgManager::DialoguesIndexedGUIDs;
+FCriticalSection UDlgManager::DialoguesGUIDIndexCriticalSection;
+
+TSet<UDlgContext*> UDlgManager::ActiveContexts;
+
+TMap<FGameplayTag, UClass*> UDlgManager::DefaultParticipantClasses;
+TArray<TWeakObjectPtr<UClass>> UDlgManager::ParticipantClassesIndexClasses;
+TArray<TWeakObjectPtr<UClass>> UDlgManager::PendingParticipantClasses;
+bool UDlgManager::bParticipantClassesIndexValid = false;
+FCriticalSection UDlgManager::ParticipantClassesIndexLock;
+
 UDlgContext* UDlgManager::StartDialogueWithDefaultParticipants(UObject* WorldContextObject, UDlgDialogue* Dialogue)
 {
 	if (!IsValid(Dialogue))
@@ -99,7 +113,12 @@ UDlgContext* UDlgManager::StartDialogueWithDefaultParticipants(UObject* WorldCon
 	return StartDialogueWithContext(TEXT("StartDialogueWithDefaultParticipants"), Dialogue, Participants);
 }
 
-UDlgContext* UDlgManager::StartDialogueWithContext(const FString& ContextString, UDlgDialogue* Dialogue, const TArray<UObject*>& Participants)
+UDlgContext* UDlgManager::StartDialogueWithContext(
+	const FString& ContextString,
+	UDlgDialogue* Dialogue,
+	const TArray<UObject*>& Participants,
+	const TOptional<int32>& RandomSeed
+)
 {
 	const FString ContextMessage = ContextString.IsEmpty()
 		? FString::Printf(TEXT("StartDialogue"))
@@ -112,6 +131,10 @@ UDlgContext* UDlgManager::StartDialogueWithContext(const FString& ContextString,
 	}
 
 	auto* Context = NewObject<UDlgContext>(Participants[0], UDlgContext::StaticClass());
+	if (RandomSeed.IsSet())
+	{
+		Context->SetRandomSeed(RandomSeed.GetValue());
+	}
 	if (Context->StartWithContext(ContextMessage, Dialogue, ParticipantBinding))
 	{
 		return Context;
@@ -286,6 +309,7 @@ TArray<TWeakObjectPtr<AActor>> UDlgManager::GetAllWeakActorsWithDialogueParticip
 
 TArray<UObject*> UDlgManager::GetObjectsWithDialogueParticipantInterface(UObject* WorldContextObject)
 {
+	DLG_SCOPE_CYCLE_COUNTER(GatherParticipants);
 	TArray<UObject*> Array;
 	if (!WorldContextObject)
 		return Array;
@@ -347,22 +371,37 @@ TMap<FGameplayTag, FDlgObjectsArray> UDlgManager::GetObjectsMapWithDialogueParti
 
 TArray<UDlgDialogue*> UDlgManager::GetDialoguesWithDuplicateGUIDs()
 {
-	TArray<UDlgDialogue*> Dialogues = GetAllDialoguesFromMemory();
+#if WITH_EDITOR
+	// Same as GetAllDialoguesFromMemory, the index only knows about the dialogues in memory
+	if (!bCalledLoadAllDialoguesIntoMemory)
+	{
+		LoadAllDialoguesIntoMemory(false);
+	}
+#endif
+
+	FScopeLock Lock(&DialoguesGUIDIndexCriticalSection);
 	TArray<UDlgDialogue*> DuplicateDialogues;
 
-	TSet<FGuid> DialogueGUIDs;
-	for (UDlgDialogue* Dialogue : Dialogues)
+	TArray<FGuid> DialogueGUIDs;
+	DialoguesGUIDIndex.GetKeys(DialogueGUIDs);
+	for (const FGuid& ID : DialogueGUIDs)
 	{
-		const FGuid ID = Dialogue->GetGUID();
-		if (DialogueGUIDs.Find(ID) == nullptr)
+		// The first valid Dialogue keeps the GUID, the rest are duplicates
+		bool bFoundFirst = false;
+		for (auto It = DialoguesGUIDIndex.CreateConstKeyIterator(ID); It; ++It)
 		{
-			// does not exist, good
-			DialogueGUIDs.Add(ID);
-		}
-		else
-		{
-			// how?
-			DuplicateDialogues.Add(Dialogue);
+			UDlgDialogue* Dialogue = It.Value();
+			if (!IsValid(Dialogue))
+			{
+				continue;
+			}
+
+			if (bFoundFirst)
+			{
+				// how?
+				DuplicateDialogues.Add(Dialogue);
+			}
+			bFoundFirst = true;
 		}
 	}
 
@@ -391,6 +430,223 @@ TMap<FGuid, UDlgDialogue*> UDlgManager::GetAllDialoguesGUIDsMap()
 	return DialoguesMap;
 }
 
+TArray<UDlgDialogue*> UDlgManager::GetDialoguesWithGUID(const FGuid& DialogueGUID)
+{
+	FScopeLock Lock(&DialoguesGUIDIndexCriticalSection);
+	TArray<UDlgDialogue*> Dialogues;
+	for (auto It = DialoguesGUIDIndex.CreateConstKeyIterator(DialogueGUID); It; ++It)
+	{
+		if (IsValid(It.Value()))
+		{
+			Dialogues.Add(It.Value());
+		}
+	}
+
+	return Dialogues;
+}
+
+bool UDlgManager::HasDialogueDuplicateGUID(const UDlgDialogue* Dialogue)
+{
+	if (!IsValid(Dialogue) || !Dialogue->HasGUID())
+	{
+		return false;
+	}
+
+	FScopeLock Lock(&DialoguesGUIDIndexCriticalSection);
+	for (auto It = DialoguesGUIDIndex.CreateConstKeyIterator(Dialogue->GetGUID()); It; ++It)
+	{
+		if (It.Value() != Dialogue && IsValid(It.Value()))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void UDlgManager::RegisterDialogueGUID(UDlgDialogue* Dialogue)
+{
+	if (Dialogue == nullptr || Dialogue->HasAnyFlags(RF_ClassDefaultObject | RF_ArchetypeObject))
+	{
+		return;
+	}
+
+	FScopeLock Lock(&DialoguesGUIDIndexCriticalSection);
+	const bool bHasGUID = Dialogue->HasGUID();
+	if (FGuid* IndexedGUID = DialoguesIndexedGUIDs.Find(Dialogue))
+	{
+		if (bHasGUID && *IndexedGUID == Dialogue->GetGUID())
+		{
+			// Nothing changed
+			return;
+		}
+
+		DialoguesGUIDIndex.RemoveSingle(*IndexedGUID, Dialogue);
+		if (!bHasGUID)
+		{
+			DialoguesIndexedGUIDs.Remove(Dialogue);
+			return;
+		}
+
+		*IndexedGUID = Dialogue->GetGUID();
+	}
+	else if (bHasGUID)
+	{
+		DialoguesIndexedGUIDs.Add(Dialogue, Dialogue->GetGUID());
+	}
+	else
+	{
+		return;
+	}
+
+	DialoguesGUIDIndex.Add(Dialogue->GetGUID(), Dialogue);
+}
+
+void UDlgManager::UnregisterDialogueGUID(UDlgDialogue* Dialogue)
+{
+	FScopeLock Lock(&DialoguesGUIDIndexCriticalSection);
+	FGuid IndexedGUID;
+	if (DialoguesIndexedGUIDs.RemoveAndCopyValue(Dialogue, IndexedGUID))
+	{
+		DialoguesGUIDIndex.RemoveSingle(IndexedGUID, Dialogue);
+	}
+}
+
+int32 UDlgManager::GetNumIndexedDialogues()
+{
+	FScopeLock Lock(&DialoguesGUIDIndexCriticalSection);
+	return DialoguesIndexedGUIDs.Num();
+}
+
+void UDlgManager::RegisterActiveContext(UDlgContext* Context)
+{
+	if (Context == nullptr || Context->HasAnyFlags(RF_ClassDefaultObject | RF_ArchetypeObject))
+	{
+		return;
+	}
+
+	check(IsInGameThread());
+	ActiveContexts.Add(Context);
+}
+
+void UDlgManager::UnregisterActiveContext(UDlgContext* Context)
+{
+	check(IsInGameThread());
+	ActiveContexts.Remove(Context);
+}
+
+UClass* UDlgManager::GetDefaultParticipantClass(const FGameplayTag& ParticipantTag)
+{
+	FScopeLock Lock(&ParticipantClassesIndexLock);
+	CheckPendingParticipantClasses();
+	if (!bParticipantClassesIndexValid)
+	{
+		BuildParticipantClassesIndex();
+	}
+
+	UClass* const* ClassPtr = DefaultParticipantClasses.Find(ParticipantTag);
+	return ClassPtr ? *ClassPtr : nullptr;
+}
+
+void UDlgManager::InvalidateParticipantClassesIndex()
+{
+	FScopeLock Lock(&ParticipantClassesIndexLock);
+	bParticipantClassesIndexValid = false;
+	DefaultParticipantClasses.Empty();
+	ParticipantClassesIndexClasses.Empty();
+}
+
+void UDlgManager::HandleParticipantClassesPostGarbageCollect()
+{
+	FScopeLock Lock(&ParticipantClassesIndexLock);
+	for (const TWeakObjectPtr<UClass>& Class : ParticipantClassesIndexClasses)
+	{
+		if (!Class.IsValid())
+		{
+			bParticipantClassesIndexValid = false;
+			DefaultParticipantClasses.Empty();
+			ParticipantClassesIndexClasses.Empty();
+			return;
+		}
+	}
+}
+
+void UDlgManager::HandleBlueprintClassCreated(UClass* Class)
+{
+	// Without an index there is nothing to invalidate, the next build sees every loaded class
+	FScopeLock Lock(&ParticipantClassesIndexLock);
+	if (bParticipantClassesIndexValid)
+	{
+		PendingParticipantClasses.Add(Class);
+	}
+}
+
+void UDlgManager::CheckPendingParticipantClasses()
+{
+	for (int32 Index = PendingParticipantClasses.Num() - 1; Index >= 0; Index--)
+	{
+		UClass* Class = PendingParticipantClasses[Index].Get();
+		if (Class != nullptr && Class->HasAnyFlags(RF_NeedLoad | RF_NeedPostLoad))
+		{
+			// Still loading
+			continue;
+		}
+		PendingParticipantClasses.RemoveAtSwap(Index);
+
+		if (bParticipantClassesIndexValid && Class != nullptr
+			&& Class->ImplementsInterface(UDlgDialogueParticipant::StaticClass())
+			&& !FDlgHelper::IsClassIgnored(Class)
+			&& !ParticipantClassesIndexClasses.Contains(Class))
+		{
+			DLG_LOG_DEBUG(TEXT("Participant class `%s` was loaded after the participant classes index was built"), *Class->GetPathName());
+			bParticipantClassesIndexValid = false;
+			DefaultParticipantClasses.Empty();
+			ParticipantClassesIndexClasses.Empty();
+		}
+	}
+}
+
+void UDlgManager::BuildParticipantClassesIndex()
+{
+	DLG_TRACE_SCOPE(DlgManager_BuildParticipantClassesIndex);
+	TArray<UClass*> NativeClasses;
+	TArray<UClass*> BlueprintClasses;
+	FDlgHelper::GetAllClassesImplementingInterface(UDlgDialogueParticipant::StaticClass(), NativeClasses, BlueprintClasses);
+
+	const TMap<FGameplayTag, TArray<FDlgClassAndObject>> NativeClassesMap = FDlgHelper::ConvertDialogueParticipantsClassesIntoMap(NativeClasses);
+	const TMap<FGameplayTag, TArray<FDlgClassAndObject>> BlueprintClassesMap = FDlgHelper::ConvertDialogueParticipantsClassesIntoMap(BlueprintClasses);
+
+	DefaultParticipantClasses.Empty();
+	ParticipantClassesIndexClasses.Empty(NativeClasses.Num() + BlueprintClasses.Num());
+	for (UClass* Class : NativeClasses)
+	{
+		ParticipantClassesIndexClasses.Add(Class);
+	}
+	for (UClass* Class : BlueprintClasses)
+	{
+		ParticipantClassesIndexClasses.Add(Class);
+	}
+
+	// Blueprint first, native last resort
+	for (const auto& Elem : BlueprintClassesMap)
+	{
+		if (Elem.Value.Num() == 1)
+		{
+			DefaultParticipantClasses.Add(Elem.Key, Elem.Value[0].Class);
+		}
+	}
+	for (const auto& Elem : NativeClassesMap)
+	{
+		if (Elem.Value.Num() == 1 && !DefaultParticipantClasses.Contains(Elem.Key))
+		{
+			DefaultParticipantClasses.Add(Elem.Key, Elem.Value[0].Class);
+		}
+	}
+
+	bParticipantClassesIndexValid = true;
+	DLG_LOG_DEBUG(TEXT("Built the participant classes index from %d native and %d blueprint classes"), NativeClasses.Num(), BlueprintClasses.Num());
+}
+
 const TMap<FGuid, FDlgHistory>& UDlgManager::GetDialogueHistory()
 {
 	return FDlgMemory::Get().GetHistoryMaps();
@@ -47,8 +47,13 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Dialogue|Launch", meta = (WorldContext = "WorldContextObject"))
 	static UDlgContext* StartDialogueWithDefaultParticipants(UObject* WorldContextObject, UDlgDialogue* Dialogue);
 
-	// Supplies where we called this from
-	static UDlgContext* StartDialogueWithContext(const FString& ContextString, UDlgDialogue* Dialogue, const TArray<UObject*>& Participants);
+	// Supplies where we called this from, RandomSeed seeds the random stream of the context if it is set
+	static UDlgContext* StartDialogueWithContext(
+		const FString& ContextString,
+		UDlgDialogue* Dialogue,
+		const TArray<UObject*>& Participants,
+		const TOptional<int32>& RandomSeed = {}
+	);
 
 	/**
 	 * Starts a Dialogue with the provided Dialogue and Participants array
@@ -65,6 +70,18 @@ public:
 		return StartDialogueWithContext(TEXT("StartDialogue"), Dialogue, Participants);
 	}
 
+	/**
+	 * Same as StartDialogue but every random decision of the context (e.g. random selector nodes) comes from a stream seeded with RandomSeed.
+	 * The same seed and the same choices always result in the same traversal, on the server and on the clients.
+	 *
+	 * @returns The dialogue context object or nullptr if something wrong happened
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Dialogue|Launch")
+	static UDlgContext* StartDialogueWithRandomSeed(UDlgDialogue* Dialogue, UPARAM(ref)const TArray<UObject*>& Participants, int32 RandomSeed)
+	{
+		return StartDialogueWithContext(TEXT("StartDialogueWithRandomSeed"), Dialogue, Participants, RandomSeed);
+	}
+
 	/**
 	 * Checks if there is any child of the start node which can be enterred based on the conditions
 	 *
@@ -182,6 +199,47 @@ public:
 	// Helper methods that gets all the dialogues in a map by guid.
 	static TMap<FGuid, UDlgDialogue*> GetAllDialoguesGUIDsMap();
 
+	// Gets all the dialogues from memory that have the DialogueGUID. Uses the GUID index, does not iterate all the dialogues.
+	static TArray<UDlgDialogue*> GetDialoguesWithGUID(const FGuid& DialogueGUID);
+
+	// Is there any other dialogue in memory with the same GUID as this Dialogue?
+	static bool HasDialogueDuplicateGUID(const UDlgDialogue* Dialogue);
+
+	// Adds or updates the Dialogue in the GUID index. Called by the Dialogue every time its GUID changes.
+	static void RegisterDialogueGUID(UDlgDialogue* Dialogue);
+
+	// Removes the Dialogue from the GUID index. Called by the Dialogue when it is destroyed.
+	static void UnregisterDialogueGUID(UDlgDialogue* Dialogue);
+
+	// Number of dialogues in the GUID index, cheap version of GetAllDialoguesFromMemory().Num()
+	static int32 GetNumIndexedDialogues();
+
+	// Adds the Context to the active contexts. Called by the Context when it is created.
+	static void RegisterActiveContext(UDlgContext* Context);
+
+	// Removes the Context from the active contexts. Called by the Context when it is destroyed.
+	static void UnregisterActiveContext(UDlgContext* Context);
+
+	// All the contexts that are not destroyed yet, the dialogue of some of them might have ended. Game thread only.
+	static const TSet<UDlgContext*>& GetActiveContexts() { return ActiveContexts; }
+
+	// Default participant class for ParticipantTag (see UDlgSystemSettings::bAutoSetDefaultParticipantClasses).
+	// The only blueprint class with this participant tag, or the only native class if there is no blueprint class, nullptr otherwise.
+	// Uses the participant classes index, built from all the loaded classes once and shared by all the dialogues.
+	static UClass* GetDefaultParticipantClass(const FGameplayTag& ParticipantTag);
+
+	// Forces the participant classes index to be rebuilt on the next use.
+	// Called when modules are loaded, on hot reload, when blueprints are compiled and when class packages are loaded or unloaded.
+	static void InvalidateParticipantClassesIndex();
+
+	// Rebuilds the participant classes index only if one of its classes was garbage collected
+	static void HandleParticipantClassesPostGarbageCollect();
+
+	// Called for every blueprint class created or loaded while the participant classes index is valid, can be called from the async loading thread.
+	// The class is checked on the next use of the participant classes index, once it is loaded.
+	// Only called in the editor or if UDlgSystemSettings::bAutoSetDefaultParticipantClasses is set.
+	static void HandleBlueprintClassCreated(UClass* Class);
+
 	// Gets all the loaded dialogues from memory that have the ParticipantTag included inside them.
 	static TArray<UDlgDialogue*> GetAllDialoguesForParticipantName(const FGameplayTag& ParticipantTag);
 
@@ -346,8 +404,41 @@ public:
 private:
 	static void GatherParticipantsRecursive(UObject* Object, TArray<UObject*>& Array, TSet<UObject*>& AlreadyVisited);
 
+	// Builds DefaultParticipantClasses, ParticipantClassesIndexLock must be held
+	static void BuildParticipantClassesIndex();
+
+	// Invalidates the participant classes index if one of the loaded PendingParticipantClasses is a participant class
+	// that is not in it yet, ParticipantClassesIndexLock must be held
+	static void CheckPendingParticipantClasses();
+
 	// Set by the user, we will default to automagically resolve the world
 	static TWeakObjectPtr<const UObject> UserWorldContextObjectPtr;
 
 	static bool bCalledLoadAllDialoguesIntoMemory;
+
+	// Maps Dialogue GUID => Dialogues in memory, more than one Dialogue for a GUID means a duplicate
+	static TMultiMap<FGuid, UDlgDialogue*> DialoguesGUIDIndex;
+
+	// Maps Dialogue => GUID it was indexed with, used to remove the old entry when the GUID changes
+	static TMap<UDlgDialogue*, FGuid> DialoguesIndexedGUIDs;
+
+	// Dialogues can be loaded outside of the game thread
+	static FCriticalSection DialoguesGUIDIndexCriticalSection;
+
+	// Contexts alive in memory, used by the debug tools
+	static TSet<UDlgContext*> ActiveContexts;
+
+	// Maps Participant Tag => default participant class (nullptr if ambiguous), see GetDefaultParticipantClass
+	static TMap<FGameplayTag, UClass*> DefaultParticipantClasses;
+
+	// Every class in the participant classes index, used to detect garbage collected classes
+	static TArray<TWeakObjectPtr<UClass>> ParticipantClassesIndexClasses;
+
+	// Blueprint classes created since the last use of the participant classes index, see HandleBlueprintClassCreated
+	static TArray<TWeakObjectPtr<UClass>> PendingParticipantClasses;
+
+	static bool bParticipantClassesIndexValid;
+
+	// Dialogues can be loaded outside of the game thread
+	static FCriticalSection ParticipantClassesIndexLock;
 };
@@ -13,8 +13,55 @@ struct DLGSYSTEM_API FDlgNodeSavedData
 	GENERATED_USTRUCT_BODY()
 
 public:
+	//
+	// Used by the random selector node to avoid repetition, one bit per child edge
+	//
+
+	bool IsEdgeUsed(int32 EdgeIndex) const
+	{
+		const int32 WordIndex = EdgeIndex / 32;
+		return UsedEdgeBits.IsValidIndex(WordIndex) && (UsedEdgeBits[WordIndex] & (1u << (EdgeIndex % 32))) != 0;
+	}
+
+	void SetEdgeUsed(int32 EdgeIndex, bool bUsed)
+	{
+		const int32 WordIndex = EdgeIndex / 32;
+		if (bUsed)
+		{
+			if (!UsedEdgeBits.IsValidIndex(WordIndex))
+			{
+				UsedEdgeBits.SetNumZeroed(WordIndex + 1);
+			}
+			UsedEdgeBits[WordIndex] |= 1u << (EdgeIndex % 32);
+		}
+		else if (UsedEdgeBits.IsValidIndex(WordIndex))
+		{
+			UsedEdgeBits[WordIndex] &= ~(1u << (EdgeIndex % 32));
+		}
+	}
+
+	void ResetUsedEdges()
+	{
+		UsedEdgeBits.Reset();
+		LastUsedEdgeIndex = INDEX_NONE;
+	}
+
+public:
+	// Bit EdgeIndex is set if the child edge was already picked
+	UPROPERTY()
+	TArray<uint32> UsedEdgeBits;
+
+	// Child edge picked last, INDEX_NONE if none
+	UPROPERTY()
+	int32 LastUsedEdgeIndex = INDEX_NONE;
+
+	// Hash of the target node GUIDs of the children (in order) when UsedEdgeBits was written,
+	// the bits are reset if the children were added, removed, reordered or retargeted since
+	UPROPERTY()
+	int32 EdgesSignature = 0;
 
-	// used by random selector node to avoid repetition
+	// DEPRECATED, target node GUIDs picked by the random selector node.
+	// Only read from old saves, converted to UsedEdgeBits the first time the selector node uses it.
 	UPROPERTY()
 	TArray<FGuid> GUIDList;
 };
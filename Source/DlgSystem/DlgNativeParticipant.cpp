@@ -0,0 +1,105 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#include "DlgNativeParticipant.h"
+
+#include "DlgDialogueParticipant.h"
+#include "DlgStats.h"
+
+FDlgParticipantValue IDlgNativeParticipant::ReadValue(const UDlgContext& Context, const UObject* Participant, EDlgParticipantValueType Type, FName Name)
+{
+	FDlgParticipantValue Value(Type, Name);
+	if (const IDlgNativeParticipant* NativeParticipant = Cast<const IDlgNativeParticipant>(Participant))
+	{
+		NativeParticipant->GetDialogueValues(Context, MakeArrayView(&Value, 1));
+		return Value;
+	}
+
+	switch (Type)
+	{
+		case EDlgParticipantValueType::Condition:
+			Value.bBoolValue = IDlgDialogueParticipant::Execute_CheckCondition(Participant, &Context, Name);
+			break;
+
+		case EDlgParticipantValueType::Bool:
+			Value.bBoolValue = IDlgDialogueParticipant::Execute_GetBoolValue(Participant, Name);
+			break;
+
+		case EDlgParticipantValueType::Int:
+			Value.IntValue = IDlgDialogueParticipant::Execute_GetIntValue(Participant, Name);
+			break;
+
+		case EDlgParticipantValueType::Float:
+			Value.FloatValue = IDlgDialogueParticipant::Execute_GetFloatValue(Participant, Name);
+			break;
+
+		case EDlgParticipantValueType::Name:
+			Value.NameValue = IDlgDialogueParticipant::Execute_GetNameValue(Participant, Name);
+			break;
+
+		default:
+			checkNoEntry();
+			break;
+	}
+	return Value;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// FDlgParticipantValueBatch
+int32 FDlgParticipantValueBatch::Add(const UObject* Participant, EDlgParticipantValueType Type, FName Name)
+{
+	const IDlgNativeParticipant* NativeParticipant = Cast<const IDlgNativeParticipant>(Participant);
+	if (NativeParticipant == nullptr)
+	{
+		return INDEX_NONE;
+	}
+
+	Owners.Add(NativeParticipant);
+	return Values.Emplace(Type, Name);
+}
+
+void FDlgParticipantValueBatch::Read(const UDlgContext& Context)
+{
+	if (Values.Num() == 0)
+	{
+		return;
+	}
+
+	// Usually all values belong to the same participant
+	const IDlgNativeParticipant* FirstOwner = Owners[0];
+	if (!Owners.ContainsByPredicate([FirstOwner](const IDlgNativeParticipant* Owner) { return Owner != FirstOwner; }))
+	{
+		DLG_INC_COUNTER(ParticipantCalls);
+		FirstOwner->GetDialogueValues(Context, Values);
+		return;
+	}
+
+	// Gather the values of each participant, read them and scatter the results back
+	TArray<const IDlgNativeParticipant*, TInlineAllocator<4>> ReadOwners;
+	TArray<FDlgParticipantValue, TInlineAllocator<8>> OwnerValues;
+	TArray<int32, TInlineAllocator<8>> OwnerValueIndices;
+	for (const IDlgNativeParticipant* Owner : Owners)
+	{
+		if (ReadOwners.Contains(Owner))
+		{
+			continue;
+		}
+		ReadOwners.Add(Owner);
+
+		OwnerValues.Reset();
+		OwnerValueIndices.Reset();
+		for (int32 Index = 0; Index < Values.Num(); Index++)
+		{
+			if (Owners[Index] == Owner)
+			{
+				OwnerValues.Add(Values[Index]);
+				OwnerValueIndices.Add(Index);
+			}
+		}
+
+		DLG_INC_COUNTER(ParticipantCalls);
+		Owner->GetDialogueValues(Context, OwnerValues);
+		for (int32 Index = 0; Index < OwnerValues.Num(); Index++)
+		{
+			Values[OwnerValueIndices[Index]] = OwnerValues[Index];
+		}
+	}
+}
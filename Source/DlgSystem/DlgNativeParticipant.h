@@ -0,0 +1,100 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectMacros.h"
+#include "UObject/Interface.h"
+
+#include "DlgNativeParticipant.generated.h"
+
+class UDlgContext;
+class IDlgNativeParticipant;
+
+// The IDlgDialogueParticipant method a FDlgParticipantValue stands for
+enum class EDlgParticipantValueType : uint8
+{
+	// CheckCondition, result in bBoolValue
+	Condition,
+
+	// GetBoolValue, result in bBoolValue
+	Bool,
+
+	// GetIntValue, result in IntValue
+	Int,
+
+	// GetFloatValue, result in FloatValue
+	Float,
+
+	// GetNameValue, result in NameValue
+	Name
+};
+
+// One value requested from a participant, filled by IDlgNativeParticipant::GetDialogueValues
+struct DLGSYSTEM_API FDlgParticipantValue
+{
+public:
+	FDlgParticipantValue() {}
+	FDlgParticipantValue(EDlgParticipantValueType InType, FName InName) : Type(InType), Name(InName) {}
+
+public:
+	// Request
+	EDlgParticipantValueType Type = EDlgParticipantValueType::Condition;
+	FName Name;
+
+	// Result, only the member matching Type is set
+	bool bBoolValue = false;
+	int32 IntValue = 0;
+	float FloatValue = 0.f;
+	FName NameValue;
+};
+
+
+UINTERFACE(meta = (CannotImplementInterfaceInBlueprint))
+class DLGSYSTEM_API UDlgNativeParticipant : public UInterface
+{
+	GENERATED_UINTERFACE_BODY()
+};
+inline UDlgNativeParticipant::UDlgNativeParticipant(const FObjectInitializer& ObjectInitializer) {}
+
+/**
+ * Optional interface for C++ participants, next to IDlgDialogueParticipant.
+ *
+ * The condition arrays read the values (GetBoolValue, GetIntValue, GetFloatValue, GetNameValue) of a participant
+ * implementing it with one GetDialogueValues call instead of one IDlgDialogueParticipant event (and ProcessEvent) per condition.
+ * Every value of the array is requested up front, even the ones an earlier failing strong condition would have skipped.
+ * CheckCondition is requested on its own when its condition is evaluated, it often does more than read a value.
+ * The events (ModifyIntValue, ...) still go through IDlgDialogueParticipant.
+ */
+class DLGSYSTEM_API IDlgNativeParticipant
+{
+	GENERATED_IINTERFACE_BODY()
+
+public:
+	// Must fill the result of every value the same way the matching IDlgDialogueParticipant method would
+	virtual void GetDialogueValues(const UDlgContext& Context, TArrayView<FDlgParticipantValue> Values) const = 0;
+
+	// Reads a single value, with GetDialogueValues if Participant implements this interface, with IDlgDialogueParticipant otherwise
+	static FDlgParticipantValue ReadValue(const UDlgContext& Context, const UObject* Participant, EDlgParticipantValueType Type, FName Name);
+};
+
+
+// Values of a condition array read with one IDlgNativeParticipant::GetDialogueValues call per participant
+struct DLGSYSTEM_API FDlgParticipantValueBatch
+{
+public:
+	// @return the index of the value or INDEX_NONE if Participant does not implement IDlgNativeParticipant
+	int32 Add(const UObject* Participant, EDlgParticipantValueType Type, FName Name);
+
+	// Fills every added value
+	void Read(const UDlgContext& Context);
+
+	const FDlgParticipantValue& GetValue(int32 Index) const { return Values[Index]; }
+	bool IsEmpty() const { return Values.Num() == 0; }
+	void Reset() { Values.Reset(); Owners.Reset(); }
+
+protected:
+	TArray<FDlgParticipantValue, TInlineAllocator<8>> Values;
+
+	// Participant of each value
+	TArray<const IDlgNativeParticipant*, TInlineAllocator<8>> Owners;
+};
@@ -0,0 +1,27 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#include "DlgStats.h"
+
+#if DLG_WITH_STATS
+
+DEFINE_STAT(STAT_DlgEvaluateConditions);
+DEFINE_STAT(STAT_DlgCallEvent);
+DEFINE_STAT(STAT_DlgRebuildText);
+DEFINE_STAT(STAT_DlgEnterNode);
+DEFINE_STAT(STAT_DlgChooseOption);
+DEFINE_STAT(STAT_DlgReevaluateOptions);
+DEFINE_STAT(STAT_DlgStartDialogue);
+DEFINE_STAT(STAT_DlgGatherParticipants);
+DEFINE_STAT(STAT_DlgParse);
+DEFINE_STAT(STAT_DlgWrite);
+
+DEFINE_STAT(STAT_DlgConditionsEvaluated);
+DEFINE_STAT(STAT_DlgEventsCalled);
+DEFINE_STAT(STAT_DlgParticipantCalls);
+DEFINE_STAT(STAT_DlgTextsFormatted);
+DEFINE_STAT(STAT_DlgContextsCreated);
+
+#if DLG_WITH_LLM_TAG
+LLM_DEFINE_TAG(DlgSystem);
+#endif
+
+#endif // DLG_WITH_STATS
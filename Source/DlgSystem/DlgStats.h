@@ -0,0 +1,81 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+
+#include "NYEngineVersionHelpers.h"
+
+// Stats (stat DlgSystem), Unreal Insights scopes and the DlgSystem LLM tag
+// DLG_WITH_STATS is set by DlgSystem.Build.cs, everything below compiles to nothing in Shipping and Test targets
+#ifndef DLG_WITH_STATS
+#define DLG_WITH_STATS 0
+#endif
+
+// Insights CPU scopes exist since 4.25, LLM tags declared outside the engine since 4.27
+#define DLG_WITH_TRACE (DLG_WITH_STATS && NY_ENGINE_VERSION >= 425)
+#define DLG_WITH_LLM_TAG (DLG_WITH_STATS && NY_ENGINE_VERSION >= 427)
+
+#if DLG_WITH_TRACE
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#endif
+#if DLG_WITH_LLM_TAG
+#include "HAL/LowLevelMemTracker.h"
+#endif
+
+#if DLG_WITH_STATS
+
+DECLARE_STATS_GROUP(TEXT("DlgSystem"), STATGROUP_DlgSystem, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Evaluate Conditions"), STAT_DlgEvaluateConditions, STATGROUP_DlgSystem, DLGSYSTEM_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Call Event"), STAT_DlgCallEvent, STATGROUP_DlgSystem, DLGSYSTEM_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Rebuild Text"), STAT_DlgRebuildText, STATGROUP_DlgSystem, DLGSYSTEM_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Enter Node"), STAT_DlgEnterNode, STATGROUP_DlgSystem, DLGSYSTEM_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Choose Option"), STAT_DlgChooseOption, STATGROUP_DlgSystem, DLGSYSTEM_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Reevaluate Options"), STAT_DlgReevaluateOptions, STATGROUP_DlgSystem, DLGSYSTEM_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Start Dialogue"), STAT_DlgStartDialogue, STATGROUP_DlgSystem, DLGSYSTEM_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Gather Participants"), STAT_DlgGatherParticipants, STATGROUP_DlgSystem, DLGSYSTEM_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Parse"), STAT_DlgParse, STATGROUP_DlgSystem, DLGSYSTEM_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Write"), STAT_DlgWrite, STATGROUP_DlgSystem, DLGSYSTEM_API);
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Conditions Evaluated"), STAT_DlgConditionsEvaluated, STATGROUP_DlgSystem, DLGSYSTEM_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Events Called"), STAT_DlgEventsCalled, STATGROUP_DlgSystem, DLGSYSTEM_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Participant Calls"), STAT_DlgParticipantCalls, STATGROUP_DlgSystem, DLGSYSTEM_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Texts Formatted"), STAT_DlgTextsFormatted, STATGROUP_DlgSystem, DLGSYSTEM_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Contexts Created"), STAT_DlgContextsCreated, STATGROUP_DlgSystem, DLGSYSTEM_API);
+
+#if DLG_WITH_TRACE
+// Cycle stat STAT_Dlg<Name> and an Insights scope Dlg<Name>, e.g. DLG_SCOPE_CYCLE_COUNTER(EnterNode)
+#define DLG_SCOPE_CYCLE_COUNTER(Name) \
+	SCOPE_CYCLE_COUNTER(STAT_Dlg##Name); \
+	TRACE_CPUPROFILER_EVENT_SCOPE(Dlg##Name)
+
+// Insights only scope, used where a cycle stat per call site would be too much (e.g. per condition type)
+#define DLG_TRACE_SCOPE(Name) TRACE_CPUPROFILER_EVENT_SCOPE(Name)
+#else
+#define DLG_SCOPE_CYCLE_COUNTER(Name) SCOPE_CYCLE_COUNTER(STAT_Dlg##Name)
+#define DLG_TRACE_SCOPE(Name)
+#endif // DLG_WITH_TRACE
+
+// Counter STAT_Dlg<Name>, e.g. DLG_INC_COUNTER(ConditionsEvaluated)
+#define DLG_INC_COUNTER(Name) INC_DWORD_STAT(STAT_Dlg##Name)
+#define DLG_INC_COUNTER_BY(Name, Amount) INC_DWORD_STAT_BY(STAT_Dlg##Name, Amount)
+
+#if DLG_WITH_LLM_TAG
+LLM_DECLARE_TAG_API(DlgSystem, DLGSYSTEM_API);
+
+// Attributes the allocations of the current scope to the DlgSystem LLM tag
+#define DLG_LLM_SCOPE() LLM_SCOPE_BYTAG(DlgSystem)
+#else
+#define DLG_LLM_SCOPE()
+#endif // DLG_WITH_LLM_TAG
+
+#else
+
+#define DLG_SCOPE_CYCLE_COUNTER(Name)
+#define DLG_TRACE_SCOPE(Name)
+#define DLG_INC_COUNTER(Name)
+#define DLG_INC_COUNTER_BY(Name, Amount)
+#define DLG_LLM_SCOPE()
+
+#endif // DLG_WITH_STATS
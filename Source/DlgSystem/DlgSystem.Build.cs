@@ -72,6 +72,26 @@ public class DlgSystem : ModuleRules
 			PublicDefinitions.Add("WITH_GAMEPLAY_DEBUGGER=0");
 		}
 
+		// Stats, Unreal Insights scopes and the LLM tag (see DlgStats.h), compiled out of 'Shipping' and 'Test' targets.
+		if (Target.Configuration != UnrealTargetConfiguration.Shipping && Target.Configuration != UnrealTargetConfiguration.Test)
+		{
+			PublicDefinitions.Add("DLG_WITH_STATS=1");
+		}
+		else
+		{
+			PublicDefinitions.Add("DLG_WITH_STATS=0");
+		}
+
+		// Per context execution trace (see DlgContextTrace.h), compiled out of 'Shipping' targets only so it can be used in playtests.
+		if (Target.Configuration != UnrealTargetConfiguration.Shipping)
+		{
+			PublicDefinitions.Add("DLG_WITH_CONTEXT_TRACE=1");
+		}
+		else
+		{
+			PublicDefinitions.Add("DLG_WITH_CONTEXT_TRACE=0");
+		}
+
 #if UE_4_26_OR_LATER
 		PrivateDependencyModuleNames.Add("DeveloperSettings");
 #endif
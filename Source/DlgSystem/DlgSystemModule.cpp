@@ -10,6 +10,9 @@
 #include "HAL/FileManager.h"
 #include "GameFramework/Actor.h"
 #include "Engine/World.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "GameplayTagsManager.h"
+#include "GameplayTagsModule.h"
 
 #if WITH_GAMEPLAY_DEBUGGER
 #include "GameplayDebugger.h"
@@ -27,6 +30,7 @@
 #include "GameplayDebugger/SDlgDataDisplay.h"
 #include "Logging/DlgLogger.h"
 #include "DlgHelper.h"
+#include "NYEngineVersionHelpers.h"
 
 #define LOCTEXT_NAMESPACE "FDlgSystemModule"
 
@@ -53,6 +57,33 @@ void FDlgSystemModule::StartupModule()
 	OnAssetRemovedHandle = AssetRegistry.OnAssetRemoved().AddRaw(this, &Self::HandleOnAssetRemoved);
 	OnAssetRenamedHandle = AssetRegistry.OnAssetRenamed().AddRaw(this, &Self::HandleOnAssetRenamed);
 
+	// Keep the participant classes index up to date (see UDlgManager::GetDefaultParticipantClass)
+	OnModulesChangedHandle = FModuleManager::Get().OnModulesChanged().AddRaw(this, &Self::HandleOnModulesChanged);
+	OnPostGarbageCollectHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddStatic(&UDlgManager::HandleParticipantClassesPostGarbageCollect);
+#if WITH_EDITOR
+	const bool bListenForBlueprintClasses = true;
+#else
+	// Every created object pays for the listener, games only use the index for bAutoSetDefaultParticipantClasses
+	const bool bListenForBlueprintClasses = GetDefault<UDlgSystemSettings>()->bAutoSetDefaultParticipantClasses;
+#endif
+	if (bListenForBlueprintClasses)
+	{
+		GUObjectArray.AddUObjectCreateListener(this);
+		bIsObjectCreateListener = true;
+	}
+#if NY_ENGINE_VERSION >= 500
+	OnReloadCompleteHandle = FCoreUObjectDelegates::ReloadCompleteDelegate.AddLambda([](EReloadCompleteReason)
+	{
+		UDlgManager::InvalidateParticipantClassesIndex();
+	});
+#endif
+
+	// Precompute the participant tags metadata once the tag table is complete, and again every time it changes
+	UGameplayTagsManager::Get().CallOrRegister_OnDoneAddingNativeTagsDelegate(
+		FSimpleMulticastDelegate::FDelegate::CreateStatic(&UBSDlgFunctions::RebuildParticipantTagsCache)
+	);
+	OnGameplayTagTreeChangedHandle = IGameplayTagsModule::OnGameplayTagTreeChanged.AddStatic(&UBSDlgFunctions::RebuildParticipantTagsCache);
+
 #if WITH_GAMEPLAY_DEBUGGER
 	// If the gameplay debugger is available, register the category and notify the editor about the changes
 	IGameplayDebugger& GameplayDebuggerModule = IGameplayDebugger::Get();
@@ -138,6 +169,25 @@ void FDlgSystemModule::ShutdownModule()
 	{
 		FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(OnPostLoadMapWithWorldHandle);
 	}
+	if (OnModulesChangedHandle.IsValid())
+	{
+		FModuleManager::Get().OnModulesChanged().Remove(OnModulesChangedHandle);
+	}
+	if (OnPostGarbageCollectHandle.IsValid())
+	{
+		FCoreUObjectDelegates::GetPostGarbageCollect().Remove(OnPostGarbageCollectHandle);
+	}
+	if (OnGameplayTagTreeChangedHandle.IsValid())
+	{
+		IGameplayTagsModule::OnGameplayTagTreeChanged.Remove(OnGameplayTagTreeChangedHandle);
+	}
+#if NY_ENGINE_VERSION >= 500
+	if (OnReloadCompleteHandle.IsValid())
+	{
+		FCoreUObjectDelegates::ReloadCompleteDelegate.Remove(OnReloadCompleteHandle);
+	}
+#endif
+	OnUObjectArrayShutdown();
 
 	FDlgLogger::Get().Info(TEXT("DlgSystemModule: ShutdownModule"));
 	FDlgLogger::OnShutdown();
@@ -335,6 +385,33 @@ void FDlgSystemModule::HandleOnPreLoadMap(const FString& MapName)
 	}
 }
 
+void FDlgSystemModule::HandleOnModulesChanged(FName ModuleName, EModuleChangeReason ReasonForChange)
+{
+	if (ReasonForChange == EModuleChangeReason::ModuleLoaded)
+	{
+		UDlgManager::InvalidateParticipantClassesIndex();
+	}
+}
+
+void FDlgSystemModule::NotifyUObjectCreated(const UObjectBase* Object, int32 Index)
+{
+	// Native classes are handled by HandleOnModulesChanged
+	const UObject* CreatedObject = static_cast<const UObject*>(Object);
+	if (CreatedObject->IsA<UBlueprintGeneratedClass>())
+	{
+		UDlgManager::HandleBlueprintClassCreated(static_cast<UClass*>(const_cast<UObject*>(CreatedObject)));
+	}
+}
+
+void FDlgSystemModule::OnUObjectArrayShutdown()
+{
+	if (bIsObjectCreateListener)
+	{
+		GUObjectArray.RemoveUObjectCreateListener(this);
+		bIsObjectCreateListener = false;
+	}
+}
+
 void FDlgSystemModule::HandleOnPostLoadMapWithWorld(UWorld* LoadedWorld)
 {
 	// NOTE: only in NON editor game
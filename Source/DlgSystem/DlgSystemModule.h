@@ -4,6 +4,7 @@
 #include "IDlgSystemModule.h"
 #include "UObject/WeakObjectPtr.h"
 #include "UObject/WeakObjectPtrTemplates.h"
+#include "UObject/UObjectArray.h"
 
 class UDlgDialogue;
 class SWidget;
@@ -17,7 +18,7 @@ struct FTabSpawnerEntry;
 DECLARE_LOG_CATEGORY_EXTERN(LogDlgSystem, All, All);
 
 // Implementation of the DlgSystem Module
-class DLGSYSTEM_API FDlgSystemModule : public IDlgSystemModule
+class DLGSYSTEM_API FDlgSystemModule : public IDlgSystemModule, public FUObjectArray::FUObjectCreateListener
 {
 	typedef FDlgSystemModule Self;
 public:
@@ -32,6 +33,10 @@ public:
 	FTabSpawnerEntry* GetDialogueDataDisplaySpawnEntry() override;
 	void DisplayDialogueDataWindow() override;
 
+	// FUObjectCreateListener implementation, blueprint classes loaded later can add participant classes
+	void NotifyUObjectCreated(const UObjectBase* Object, int32 Index) override;
+	void OnUObjectArrayShutdown() override;
+
 private:
 	// Refreshes the actor of the DlgDataDisplay if it is already opened. Return true if refresh was successful
 	bool RefreshDisplayDialogueDataWindow(bool bFocus = true);
@@ -57,10 +62,16 @@ private:
 	// Handle event when a new map with world is loaded is loaded.
 	void HandleOnPostLoadMapWithWorld(UWorld* LoadedWorld);
 
+	// Handle modules being loaded, they can add participant classes
+	void HandleOnModulesChanged(FName ModuleName, EModuleChangeReason ReasonForChange);
+
 private:
 	// True if the tab spawners have been registered for this module
 	bool bHasRegisteredTabSpawners = false;
 
+	// True if this module is registered as an FUObjectCreateListener
+	bool bIsObjectCreateListener = false;
+
 	// Holds the widget reflector singleton.
 	TWeakPtr<SDlgDataDisplay> DialogueDataDisplayWidget;
 	FTabSpawnerEntry* DialogueDataDisplayTabSpawnEntry = nullptr;
@@ -80,4 +91,8 @@ private:
 	FDelegateHandle OnInMemoryAssetDeletedHandle;
 	FDelegateHandle OnAssetRemovedHandle;
 	FDelegateHandle OnAssetRenamedHandle;
+	FDelegateHandle OnModulesChangedHandle;
+	FDelegateHandle OnPostGarbageCollectHandle;
+	FDelegateHandle OnReloadCompleteHandle;
+	FDelegateHandle OnGameplayTagTreeChangedHandle;
 };
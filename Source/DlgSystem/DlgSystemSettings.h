@@ -261,6 +261,21 @@ public:
 	UPROPERTY(Category = "Runtime", Config, EditAnywhere)
 	EDlgNoSatisfiedChildBehavior NoSatisfiedChildBehavior;
 
+	// How often the runtime Dialogue Data Display reads the values of the variables it shows
+	// Only the variables of the visible rows are read, all of them at once
+	UPROPERTY(Category = "Runtime", Config, EditAnywhere, meta = (ClampMin = "0.0", UIMin = "0.0", Units = "s"))
+	float DataDisplaySampleIntervalSeconds = 1.f;
+
+	// If enabled the dialogue values of the participants (GetIntValue, GetFloatValue, GetBoolValue, GetNameValue) are read at most once
+	// per step (start, choose option, reevaluate options) of a context by the conditions and the text arguments
+	// Every event fired during the step clears them, see UDlgContext::InvalidateParticipantValueCache
+	UPROPERTY(Category = "Runtime", Config, EditAnywhere)
+	bool bCacheParticipantValuesPerStep = true;
+
+	// Dialogue values that can change without an event, these are read every time even if bCacheParticipantValuesPerStep is enabled
+	UPROPERTY(Category = "Runtime", Config, EditAnywhere, meta = (EditCondition = "bCacheParticipantValuesPerStep"))
+	TArray<FName> VolatileParticipantValues;
+
 
 	// The dialogue text format used for saving and reloading from text files.
 	UPROPERTY(Category = "Dialogue", Config, EditAnywhere, DisplayName = "Text Format")
@@ -385,6 +400,10 @@ public:
 	UPROPERTY(Config)
 	bool bEnableOutputLog = false;
 
+	// Messages more verbose than this are dropped before they are even formatted
+	UPROPERTY(Category = "Logger", Config, EditAnywhere, AdvancedDisplay)
+	ENYLoggerLogLevel MaxLogLevel = ENYLoggerLogLevel::Trace;
+
 	// By default the message log does not support debug output, latest is info.
 	// For the sake of sanity we redirect all levels higher than RedirectMessageLogLevelsHigherThan to the output log
 	// even if the output log is disabled.
@@ -17,7 +17,7 @@ FFormatArgumentValue FDlgTextArgument::ConstructFormatArgumentValue(const UDlgCo
 	const UObject* Participant = Context.GetParticipant(ValidParticipantTag);
 	if (Participant == nullptr)
 	{
-		FDlgLogger::Get().Errorf(
+		DLG_LOG_ERROR_RATE_LIMITED(
 			TEXT("FAILED to construct text argument because the PARTICIPANT is INVALID (Supplied Participant = %s). \nContext:\n\t%s, DisplayString = %s, ParticipantName = %s, ArgumentType = %s"),
 			*ValidParticipantTag.ToString(), *Context.GetContextString(), *DisplayString, *ValidParticipantTag.ToString(), *ArgumentTypeToString(Type)
 		);
@@ -27,13 +27,13 @@ FFormatArgumentValue FDlgTextArgument::ConstructFormatArgumentValue(const UDlgCo
 	switch (Type)
 	{
 		case EDlgTextArgumentType::DialogueInt:
-			return FFormatArgumentValue(IDlgDialogueParticipant::Execute_GetIntValue(Participant, VariableName));
+			return FFormatArgumentValue(Context.ReadParticipantValue(Participant, EDlgParticipantValueType::Int, VariableName).IntValue);
 
 		case EDlgTextArgumentType::ClassInt:
 			return FFormatArgumentValue(FNYReflectionHelper::GetVariable<FIntProperty, int32>(Participant, VariableName));
 
 		case EDlgTextArgumentType::DialogueFloat:
-			return FFormatArgumentValue(IDlgDialogueParticipant::Execute_GetFloatValue(Participant, VariableName));
+			return FFormatArgumentValue(Context.ReadParticipantValue(Participant, EDlgParticipantValueType::Float, VariableName).FloatValue);
 
 		case EDlgTextArgumentType::ClassFloat:
 			return FFormatArgumentValue(FNYReflectionHelper::GetVariable<FDoubleProperty, double>(Participant, VariableName));
@@ -50,7 +50,7 @@ FFormatArgumentValue FDlgTextArgument::ConstructFormatArgumentValue(const UDlgCo
 		case EDlgTextArgumentType::Custom:
 			if (CustomTextArgument == nullptr)
 			{
-				FDlgLogger::Get().Errorf(
+				DLG_LOG_ERROR_RATE_LIMITED(
 					TEXT("Custom Text Argument is INVALID. Returning Error Text. Context:\n\t%s, Participant = %s"),
 					*Context.GetContextString(), Participant ? *Participant->GetPathName() : TEXT("INVALID")
 				);
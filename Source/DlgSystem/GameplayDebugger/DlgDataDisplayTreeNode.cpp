@@ -1,8 +1,18 @@
 // Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
 #include "DlgDataDisplayTreeNode.h"
 
+#include "UObject/TextProperty.h"
+
+#include "DlgSystem/DlgDialogueParticipant.h"
+#include "DlgSystem/NYReflectionHelper.h"
+
 #define LOCTEXT_NAMESPACE "FDlgDataDisplayTreeNode"
 
+static FString BoolToFString(const bool Value)
+{
+	return Value ? TEXT("True") : TEXT("False");
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // FDlgDataDisplayTreeNode
 FDlgDataDisplayTreeNode::FDlgDataDisplayTreeNode(const FText& InDisplayText, const TSharedPtr<Self>& InParent)
@@ -76,4 +86,88 @@ FDlgDataDisplayTreeVariableNode::FDlgDataDisplayTreeVariableNode(
 	TextType = EDlgDataDisplayTextTreeNodeType::Variable;
 }
 
+void FDlgDataDisplayTreeVariableNode::UpdateVariableValueFromActor()
+{
+	TWeakObjectPtr<const AActor> Actor = GetParentActor();
+	if (!Actor.IsValid())
+	{
+		return;
+	}
+
+	switch (VariableType)
+	{
+		case EDlgDataDisplayVariableTreeNodeType::Integer:
+		{
+			const int32 Value = IDlgDialogueParticipant::Execute_GetIntValue(Actor.Get(), VariableName);
+			VariableValue = FString::FromInt(Value);
+			break;
+		}
+		case EDlgDataDisplayVariableTreeNodeType::Float:
+		{
+			const float Value = IDlgDialogueParticipant::Execute_GetFloatValue(Actor.Get(), VariableName);
+			VariableValue = FString::SanitizeFloat(Value);
+			break;
+		}
+		case EDlgDataDisplayVariableTreeNodeType::Bool:
+		{
+			const bool Value = IDlgDialogueParticipant::Execute_GetBoolValue(Actor.Get(), VariableName);
+			VariableValue = BoolToFString(Value);
+			break;
+		}
+		case EDlgDataDisplayVariableTreeNodeType::FName:
+		{
+			const FName Value = IDlgDialogueParticipant::Execute_GetNameValue(Actor.Get(), VariableName);
+			VariableValue = Value.ToString();
+			break;
+		}
+
+		case EDlgDataDisplayVariableTreeNodeType::ClassInteger:
+		{
+			const int32 Value = FNYReflectionHelper::GetVariable<FIntProperty, int32>(Actor.Get(), VariableName);
+			VariableValue = FString::FromInt(Value);
+			break;
+		}
+		case EDlgDataDisplayVariableTreeNodeType::ClassFloat:
+		{
+			const double Value = FNYReflectionHelper::GetVariable<FDoubleProperty, double>(Actor.Get(), VariableName);
+			VariableValue = FString::SanitizeFloat(Value);
+			break;
+		}
+		case EDlgDataDisplayVariableTreeNodeType::ClassBool:
+		{
+			const bool Value = FNYReflectionHelper::GetVariable<FBoolProperty, bool>(Actor.Get(), VariableName);
+			VariableValue = BoolToFString(Value);
+			break;
+		}
+		case EDlgDataDisplayVariableTreeNodeType::ClassFName:
+		{
+			const FName Value = FNYReflectionHelper::GetVariable<FNameProperty, FName>(Actor.Get(), VariableName);
+			VariableValue = Value.ToString();
+			break;
+		}
+		case EDlgDataDisplayVariableTreeNodeType::ClassFText:
+		{
+			const FText Value = FNYReflectionHelper::GetVariable<FTextProperty, FText>(Actor.Get(), VariableName);
+			VariableValue = Value.ToString();
+			break;
+		}
+
+		case EDlgDataDisplayVariableTreeNodeType::Event:
+		case EDlgDataDisplayVariableTreeNodeType::UnrealFunction:
+		{
+			// Event does not have any state value, ignore
+			break;
+		}
+		case EDlgDataDisplayVariableTreeNodeType::Condition:
+		{
+			const bool Value = IDlgDialogueParticipant::Execute_CheckCondition(Actor.Get(), nullptr, VariableName);
+			VariableValue = BoolToFString(Value);
+			break;
+		}
+		case EDlgDataDisplayVariableTreeNodeType::Default:
+		default:
+			VariableValue = TEXT("UNIMPLEMENTED - SHOULD NEVER HAPPEN");
+	}
+}
+
 #undef LOCTEXT_NAMESPACE
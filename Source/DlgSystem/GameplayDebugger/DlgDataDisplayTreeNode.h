@@ -81,6 +81,9 @@ public:
 		return IsEqual(Other);
 	}
 
+	/** Does this represent the same thing as Other? Unlike IsEqual it ignores the state (like the variable value). Used to diff the trees. */
+	virtual bool IsSameNode(const Self& Other) const { return Self::IsEqual(Other); }
+
 protected:
 	// FDlgTreeViewNode Interface
 	void PostFilterPathsToNodes(const TSharedPtr<Self>& Child) override
@@ -185,6 +188,16 @@ public:
 	// VariableType:
 	EDlgDataDisplayVariableTreeNodeType GetVariableType() const { return VariableType; }
 
+	/** Does this variable type have a value we can read? Events and functions do not. */
+	bool HasVariableValue() const
+	{
+		return VariableType != EDlgDataDisplayVariableTreeNodeType::Event &&
+			VariableType != EDlgDataDisplayVariableTreeNodeType::UnrealFunction;
+	}
+
+	/** Reads the VariableValue from the parent Actor. */
+	void UpdateVariableValueFromActor();
+
 	bool IsEqual(const Super& Other) const override
 	{
 		if (const Self* OtherSelf = static_cast<const Self*>(&Other))
@@ -197,6 +210,19 @@ public:
 		return false;
 	}
 
+	bool IsSameNode(const Super& Other) const override
+	{
+		if (Other.GetTextType() != EDlgDataDisplayTextTreeNodeType::Variable)
+		{
+			return false;
+		}
+
+		const Self& OtherSelf = static_cast<const Self&>(Other);
+		return VariableName == OtherSelf.GetVariableName() &&
+			VariableType == OtherSelf.GetVariableType() &&
+			Super::IsSameNode(Other);
+	}
+
 protected:
 	/** Used to store the name Event, Condition, IntName, etc */
 	FName VariableName = NAME_None;
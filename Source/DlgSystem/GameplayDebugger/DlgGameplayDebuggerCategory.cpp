@@ -2,26 +2,197 @@
 #if WITH_GAMEPLAY_DEBUGGER
 #include "DlgGameplayDebuggerCategory.h"
 
+#include "GameFramework/Actor.h"
+#include "HAL/PlatformTime.h"
+
 #include "DlgSystem/DlgManager.h"
+#include "DlgSystem/DlgContext.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// FDlgDebuggerContextData
+void FDlgDebuggerContextData::Serialize(FArchive& Ar)
+{
+	Ar << DialogueName;
+	Ar << ActiveNodeIndex;
+	Ar << ActiveNodeType;
+	Ar << Participants;
+	Ar << NumOptions;
+	Ar << NumAllOptions;
+	Ar << HistorySize;
+	Ar << bDialogueEnded;
+	Ar << LastStepMilliseconds;
+	Ar << SecondsSinceLastStep;
+	Ar << NumConditionsEvaluated;
+	Ar << SlowConditions;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// FDlgDataToPrint
+void FDlgDataToPrint::Serialize(FArchive& Ar)
+{
+	Ar << NumLoadedDialogues;
+	Ar << NumActiveContexts;
+	Ar << Contexts;
+}
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// FDlgGameplayDebuggerCategory
 FDlgGameplayDebuggerCategory::FDlgGameplayDebuggerCategory()
 {
 	bShowOnlyWithDebugActor = false;
+	SetDataPackReplication<FDlgDataToPrint>(&Data);
+}
+
+FDlgGameplayDebuggerCategory::~FDlgGameplayDebuggerCategory()
+{
+	FDlgContextStepDebugInfo::bEnabled = false;
 }
 
 void FDlgGameplayDebuggerCategory::CollectData(APlayerController* OwnerPC, AActor* DebugActor)
 {
-	Data.NumLoadedDialogues = UDlgManager::GetAllDialoguesFromMemory().Num();
+	// Only measure the steps while someone is looking
+	FDlgContextStepDebugInfo::bEnabled = true;
+
+	const TSet<UDlgContext*>& ActiveContexts = UDlgManager::GetActiveContexts();
+	Data.NumLoadedDialogues = UDlgManager::GetNumIndexedDialogues();
+	Data.NumActiveContexts = ActiveContexts.Num();
+
+	// Selected another actor, start over so its contexts show up as soon as possible
+	if (LastDebugActor.Get() != DebugActor)
+	{
+		LastDebugActor = DebugActor;
+		ScanSnapshot.Reset();
+		ScanCursor = 0;
+	}
+
+	// Start a new scan pass
+	if (ScanCursor >= ScanSnapshot.Num())
+	{
+		ScanSnapshot.Reset(ActiveContexts.Num());
+		for (UDlgContext* Context : ActiveContexts)
+		{
+			ScanSnapshot.Add(Context);
+		}
+		ScanCursor = 0;
+		ScanCandidates.Reset();
+	}
 
-	if (DebugActor)
+	const int32 ScanEnd = FMath::Min(ScanCursor + MaxScannedContextsPerFrame, ScanSnapshot.Num());
+	for (; ScanCursor < ScanEnd; ScanCursor++)
+	{
+		if (UDlgContext* Context = ScanSnapshot[ScanCursor].Get())
+		{
+			AddCandidate(ScanCandidates, Context, DebugActor);
+		}
+	}
+	if (ScanCursor >= ScanSnapshot.Num())
 	{
+		DisplayedContexts = MoveTemp(ScanCandidates);
+		ScanCandidates.Reset();
+	}
 
+	// The displayed contexts are few, refresh them every frame
+	const double CurrentTime = FPlatformTime::Seconds();
+	Data.Contexts.Reset(DisplayedContexts.Num());
+	for (const FCandidate& Candidate : DisplayedContexts)
+	{
+		if (const UDlgContext* Context = Candidate.Context.Get())
+		{
+			FillContextData(*Context, CurrentTime, Data.Contexts.AddDefaulted_GetRef());
+		}
 	}
 }
 
 void FDlgGameplayDebuggerCategory::DrawData(APlayerController* OwnerPC, FGameplayDebuggerCanvasContext& CanvasContext)
 {
 	CanvasContext.Printf(TEXT("{green}Number loaded Dialogues: %s"), *FString::FromInt(Data.NumLoadedDialogues));
+	CanvasContext.Printf(TEXT("{green}Number active Contexts: %s"), *FString::FromInt(Data.NumActiveContexts));
+
+	for (const FDlgDebuggerContextData& Context : Data.Contexts)
+	{
+		CanvasContext.Printf(
+			TEXT("{yellow}%s {white}node = %d (%s), options = %d/%d, history = %d%s"),
+			*Context.DialogueName, Context.ActiveNodeIndex, *Context.ActiveNodeType,
+			Context.NumOptions, Context.NumAllOptions, Context.HistorySize,
+			Context.bDialogueEnded ? TEXT(" {red}ENDED") : TEXT("")
+		);
+		CanvasContext.Printf(TEXT("    {grey}Participants: {white}%s"), *Context.Participants);
+		if (Context.SecondsSinceLastStep >= 0.f)
+		{
+			CanvasContext.Printf(
+				TEXT("    {grey}Last step: {white}%.3f ms, %.1f s ago, conditions = %d %s"),
+				Context.LastStepMilliseconds, Context.SecondsSinceLastStep, Context.NumConditionsEvaluated,
+				*(Context.SlowConditions.IsEmpty() ? FString() : FString::Printf(TEXT("{red}slow: %s"), *Context.SlowConditions))
+			);
+		}
+	}
+}
+
+void FDlgGameplayDebuggerCategory::AddCandidate(TArray<FCandidate>& Candidates, UDlgContext* Context, AActor* DebugActor)
+{
+	FCandidate Candidate;
+	Candidate.Context = Context;
+	Candidate.bHasDebugActor = DebugActor && Context->GetParticipantsMap().FindKey(DebugActor) != nullptr;
+	Candidate.LastStepTime = Context->GetStepDebugInfo().StepStartTime;
+
+	// Sorted, best first
+	int32 InsertIndex = Candidates.Num();
+	while (InsertIndex > 0 && Candidate.IsBetterThan(Candidates[InsertIndex - 1]))
+	{
+		InsertIndex--;
+	}
+	if (InsertIndex >= MaxDisplayedContexts)
+	{
+		return;
+	}
+
+	Candidates.Insert(Candidate, InsertIndex);
+	if (Candidates.Num() > MaxDisplayedContexts)
+	{
+		Candidates.RemoveAt(Candidates.Num() - 1);
+	}
+}
+
+void FDlgGameplayDebuggerCategory::FillContextData(const UDlgContext& Context, double CurrentTime, FDlgDebuggerContextData& OutData)
+{
+	const UDlgDialogue* Dialogue = Context.GetDialogue();
+	OutData.DialogueName = Dialogue ? Dialogue->GetDialogueName() : TEXT("INVALID");
+	OutData.ActiveNodeIndex = Context.GetActiveNodeIndex();
+	OutData.NumOptions = Context.GetOptionsNum();
+	OutData.NumAllOptions = Context.GetAllOptionsNum();
+	OutData.HistorySize = Context.GetHistoryOfThisContext().VisitedNodeIndices.Num();
+	OutData.bDialogueEnded = Context.HasDialogueEnded();
+
+	if (const UDlgNode* Node = Dialogue ? Context.GetActiveNode() : nullptr)
+	{
+		OutData.ActiveNodeType = Node->GetClass()->GetName();
+		OutData.ActiveNodeType.RemoveFromStart(TEXT("DlgNode_"));
+	}
+
+	TArray<FString> ParticipantTags;
+	for (const auto& KeyValue : Context.GetParticipantsMap())
+	{
+		ParticipantTags.Add(KeyValue.Key.ToString());
+	}
+	OutData.Participants = FString::Join(ParticipantTags, TEXT(", "));
+
+	const FDlgContextStepDebugInfo& StepInfo = Context.GetStepDebugInfo();
+	if (StepInfo.StepStartTime > 0.0)
+	{
+		OutData.LastStepMilliseconds = static_cast<float>(StepInfo.StepSeconds * 1000.0);
+		OutData.SecondsSinceLastStep = static_cast<float>(CurrentTime - StepInfo.StepStartTime);
+		OutData.NumConditionsEvaluated = StepInfo.NumConditionsEvaluated;
+
+		TArray<FString> SlowConditions;
+		for (const FDlgContextStepDebugInfo::FSlowCondition& SlowCondition : StepInfo.SlowConditions)
+		{
+			SlowConditions.Add(FString::Printf(
+				TEXT("%s(%s) %.3f ms"),
+				*FDlgCondition::ConditionTypeToString(SlowCondition.ConditionType), *SlowCondition.CallbackName.ToString(), SlowCondition.Seconds * 1000.0
+			));
+		}
+		OutData.SlowConditions = FString::Join(SlowConditions, TEXT(", "));
+	}
 }
 
 #endif // WITH_GAMEPLAY_DEBUGGER
@@ -8,11 +8,44 @@
 class AActor;
 class APlayerController;
 class FGameplayDebuggerCanvasContext;
+class UDlgContext;
 
-// The data we're going to print inside the viewport
+// One active dialogue context as displayed in the viewport
+struct DLGSYSTEM_API FDlgDebuggerContextData
+{
+	FString DialogueName;
+	int32 ActiveNodeIndex = INDEX_NONE;
+	FString ActiveNodeType;
+	FString Participants;
+	int32 NumOptions = 0;
+	int32 NumAllOptions = 0;
+	int32 HistorySize = 0;
+	bool bDialogueEnded = false;
+
+	// Last step (start, choose option, reevaluate options) of the context
+	float LastStepMilliseconds = 0.f;
+	float SecondsSinceLastStep = -1.f;
+	int32 NumConditionsEvaluated = 0;
+	FString SlowConditions;
+
+	void Serialize(FArchive& Ar);
+	friend FArchive& operator<<(FArchive& Ar, FDlgDebuggerContextData& Data)
+	{
+		Data.Serialize(Ar);
+		return Ar;
+	}
+};
+
+// The data we're going to print inside the viewport, replicated to the client that owns the debugger
 struct DLGSYSTEM_API FDlgDataToPrint
 {
 	int32 NumLoadedDialogues = 0;
+	int32 NumActiveContexts = 0;
+
+	// The most recently stepped contexts, the ones involving the debug actor first
+	TArray<FDlgDebuggerContextData> Contexts;
+
+	void Serialize(FArchive& Ar);
 };
 
 class DLGSYSTEM_API FDlgGameplayDebuggerCategory : public FGameplayDebuggerCategory
@@ -20,8 +53,16 @@ class DLGSYSTEM_API FDlgGameplayDebuggerCategory : public FGameplayDebuggerCateg
 private:
 	typedef FDlgGameplayDebuggerCategory Self;
 
+public:
+	// Maximum number of contexts displayed (and replicated)
+	static constexpr int32 MaxDisplayedContexts = 12;
+
+	// The contexts are scanned incrementally so thousands of live contexts do not cost a hitch every frame
+	static constexpr int32 MaxScannedContextsPerFrame = 256;
+
 public:
 	FDlgGameplayDebuggerCategory();
+	~FDlgGameplayDebuggerCategory();
 
 	/** Creates an instance of this category - will be used on module startup to include our category in the Editor */
 	static TSharedRef<FGameplayDebuggerCategory> MakeInstance() { return MakeShared<Self>(); }
@@ -34,9 +75,38 @@ public:
 	/** Displays the data we collected in the CollectData function */
 	void DrawData(APlayerController* OwnerPC, FGameplayDebuggerCanvasContext& CanvasContext) override;
 
+protected:
+	struct FCandidate
+	{
+		TWeakObjectPtr<UDlgContext> Context;
+		bool bHasDebugActor = false;
+		double LastStepTime = 0.0;
+
+		// Contexts of the debug actor first, then the most recently stepped ones
+		bool IsBetterThan(const FCandidate& Other) const
+		{
+			return bHasDebugActor != Other.bHasDebugActor ? bHasDebugActor : LastStepTime > Other.LastStepTime;
+		}
+	};
+
+	static void AddCandidate(TArray<FCandidate>& Candidates, UDlgContext* Context, AActor* DebugActor);
+	static void FillContextData(const UDlgContext& Context, double CurrentTime, FDlgDebuggerContextData& OutData);
+
 protected:
 	// The data that we're going to print
 	FDlgDataToPrint Data;
+
+	// Copy of the active contexts taken at the start of every scan pass
+	TArray<TWeakObjectPtr<UDlgContext>> ScanSnapshot;
+	int32 ScanCursor = 0;
+
+	// Best contexts of the scan pass in progress
+	TArray<FCandidate> ScanCandidates;
+
+	// Best contexts of the last finished scan pass, their data is refreshed every frame
+	TArray<FCandidate> DisplayedContexts;
+
+	TWeakObjectPtr<AActor> LastDebugActor;
 };
 
 #endif // WITH_GAMEPLAY_DEBUGGER
@@ -14,6 +14,7 @@
 
 #include "DlgSystem/DlgManager.h"
 #include "DlgSystem/DlgContext.h"
+#include "DlgSystem/DlgSystemSettings.h"
 #include "SDlgDataPropertyValues.h"
 #include "DlgSystem/Logging/DlgLogger.h"
 
@@ -34,6 +35,7 @@ void SDlgDataDisplay::Construct(const FArguments& InArgs, const TWeakObjectPtr<c
 		.ItemHeight(32)
 		.TreeItemsSource(&RootChildren)
 		.OnGenerateRow(this, &Self::HandleGenerateRow)
+		.OnRowReleased(this, &Self::HandleRowReleased)
 		.OnSelectionChanged(this, &Self::HandleTreeSelectionChanged)
 		.OnGetChildren(this, &Self::HandleGetChildren)
 		.SelectionMode(ESelectionMode::Single)
@@ -103,15 +105,6 @@ void SDlgDataDisplay::Construct(const FArguments& InArgs, const TWeakObjectPtr<c
 
 void SDlgDataDisplay::RefreshTree(bool bPreserveExpansion)
 {
-	// First, save off current expansion state
-	TSet<TSharedPtr<FDlgDataDisplayTreeNode>> OldExpansionState;
-	if (bPreserveExpansion)
-	{
-		ActorsTreeView->GetExpandedItems(OldExpansionState);
-	}
-
-	RootTreeItem->ClearChildren();
-	RootChildren.Empty();
 	ActorsProperties.Empty();
 
 	// Try the actor World
@@ -128,6 +121,9 @@ void SDlgDataDisplay::RefreshTree(bool bPreserveExpansion)
 	// Can't do anything without the world
 	if (!IsValid(World))
 	{
+		RootTreeItem->ClearChildren();
+		RootChildren.Empty();
+		ActorsTreeView->RequestTreeRefresh();
 		FDlgLogger::Get().Error(
 			TEXT("Failed to refresh SDlgDataDisplay tree. World is a null pointer. "
 				"Is the game running? "
@@ -284,6 +280,7 @@ void SDlgDataDisplay::RefreshTree(bool bPreserveExpansion)
 	}
 
 	// Build the Actors Tree View (aka the actual tree)
+	TArray<TSharedPtr<FDlgDataDisplayTreeNode>> ActorItems;
 	for (const auto& Elem : ActorsProperties)
 	{
 		// Key: AActor
@@ -296,25 +293,76 @@ void SDlgDataDisplay::RefreshTree(bool bPreserveExpansion)
 		TSharedPtr<FDlgDataDisplayTreeNode> ActorItem =
 			MakeShared<FDlgDataDisplayTreeActorNode>(FText::FromString(Actor->GetName()), RootTreeItem, Actor);
 		BuildTreeViewItem(ActorItem);
-		RootTreeItem->AddChild(ActorItem);
+		ActorItems.Add(ActorItem);
 	}
+
+	// Keep the unchanged nodes, the tree view keeps their expansion and rows
+	MergeTreeChildren(RootTreeItem, ActorItems);
 	RootChildren = RootTreeItem->GetChildren();
 
 	// Clear Previous states
 	ActorsTreeView->ClearSelection();
-	// Triggers RequestTreeRefresh
-	ActorsTreeView->ClearExpandedItems();
+	if (bPreserveExpansion)
+	{
+		ActorsTreeView->RequestTreeRefresh();
+	}
+	else
+	{
+		// Triggers RequestTreeRefresh
+		ActorsTreeView->ClearExpandedItems();
+	}
+}
 
-	// Restore old Expansion
-	if (bPreserveExpansion && OldExpansionState.Num() > 0)
+void SDlgDataDisplay::MergeTreeChildren(
+	const TSharedPtr<FDlgDataDisplayTreeNode>& Item,
+	const TArray<TSharedPtr<FDlgDataDisplayTreeNode>>& NewChildren
+)
+{
+	const TArray<TSharedPtr<FDlgDataDisplayTreeNode>> OldChildren = Item->GetChildren();
+	TArray<TSharedPtr<FDlgDataDisplayTreeNode>> MergedChildren;
+	MergedChildren.Reserve(NewChildren.Num());
+	for (const TSharedPtr<FDlgDataDisplayTreeNode>& NewChild : NewChildren)
 	{
-		// Flattened tree
-		TArray<TSharedPtr<FDlgDataDisplayTreeNode>> AllNodes;
-		RootTreeItem->GetAllNodes(AllNodes);
+		const TSharedPtr<FDlgDataDisplayTreeNode>* OldChildPtr = OldChildren.FindByPredicate(
+			[&NewChild](const TSharedPtr<FDlgDataDisplayTreeNode>& OldChild)
+			{
+				return OldChild->IsSameNode(*NewChild);
+			}
+		);
 
-		// Expand to match the old state
-		FDlgTreeViewHelper::RestoreTreeExpansionState<TSharedPtr<FDlgDataDisplayTreeNode>>(ActorsTreeView,
-			AllNodes, OldExpansionState, Self::PredicateCompareDlgDataDisplayTreeNode);
+		if (OldChildPtr)
+		{
+			MergeTreeChildren(*OldChildPtr, NewChild->GetChildren());
+			MergedChildren.Add(*OldChildPtr);
+		}
+		else
+		{
+			MergedChildren.Add(NewChild);
+		}
+	}
+
+	Item->SetChildren(MergedChildren);
+}
+
+void SDlgDataDisplay::Tick(const FGeometry& AllottedGeometry, double InCurrentTime, float InDeltaTime)
+{
+	SCompoundWidget::Tick(AllottedGeometry, InCurrentTime, InDeltaTime);
+
+	SampleElapsedSeconds += InDeltaTime;
+	if (bHasNewVisibleVariables || SampleElapsedSeconds >= GetDefault<UDlgSystemSettings>()->DataDisplaySampleIntervalSeconds)
+	{
+		SampleVisibleVariables();
+	}
+}
+
+void SDlgDataDisplay::SampleVisibleVariables()
+{
+	SampleElapsedSeconds = 0.f;
+	bHasNewVisibleVariables = false;
+
+	for (const auto& KeyValue : VisibleVariableNodes)
+	{
+		KeyValue.Value->UpdateVariableValueFromActor();
 	}
 }
 
@@ -566,6 +614,13 @@ TSharedRef<ITableRow> SDlgDataDisplay::HandleGenerateRow(TSharedPtr<FDlgDataDisp
 					break;
 			}
 
+			// Sampled until the row is released, see HandleRowReleased
+			if (VariableNode->HasVariableValue())
+			{
+				VisibleVariableNodes.Add(TableRow.Get(), VariableNode);
+				bHasNewVisibleVariables = true;
+			}
+
 			RowContent = SNew(SHorizontalBox)
 				// <variable type> <variable name> =
 				+SHorizontalBox::Slot()
@@ -606,6 +661,12 @@ TSharedRef<ITableRow> SDlgDataDisplay::HandleGenerateRow(TSharedPtr<FDlgDataDisp
 	return TableRow.ToSharedRef();
 }
 
+void SDlgDataDisplay::HandleRowReleased(const TSharedRef<ITableRow>& Row)
+{
+	// Row scrolled out of view, collapsed or removed from the tree
+	VisibleVariableNodes.Remove(&Row.Get());
+}
+
 void SDlgDataDisplay::HandleGetChildren(TSharedPtr<FDlgDataDisplayTreeNode> InItem,
 	TArray<TSharedPtr<FDlgDataDisplayTreeNode>>& OutChildren)
 {
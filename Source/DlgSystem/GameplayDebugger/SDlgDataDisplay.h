@@ -27,8 +27,12 @@ public:
 	}
 
 	// Updates the actors tree.
+	// The new tree is diffed against the old one, the nodes that did not change are kept (with their values and expansion).
 	void RefreshTree(bool bPreserveExpansion);
 
+	// SWidget Interface
+	void Tick(const FGeometry& AllottedGeometry, double InCurrentTime, float InDeltaTime) override;
+
 	// Get current filter text
 	FText GetFilterText() const { return FilterTextBoxWidget->GetText(); }
 
@@ -50,6 +54,12 @@ private:
 	// Recursively build the view item.
 	void BuildTreeViewItem(const TSharedPtr<FDlgDataDisplayTreeNode>& Item);
 
+	// Sets the NewChildren as the children of Item but reuses the existing children that represent the same thing, recursively
+	static void MergeTreeChildren(const TSharedPtr<FDlgDataDisplayTreeNode>& Item, const TArray<TSharedPtr<FDlgDataDisplayTreeNode>>& NewChildren);
+
+	// Reads the values of all the variables that have a row widget
+	void SampleVisibleVariables();
+
 	// Text search changed
 	void HandleSearchTextCommited(const FText& InText, ETextCommit::Type InCommitType);
 
@@ -63,6 +73,9 @@ private:
 	// Make the row
 	TSharedRef<ITableRow> HandleGenerateRow(TSharedPtr<FDlgDataDisplayTreeNode> InItem, const TSharedRef<STableViewBase>& OwnerTable);
 
+	// Row scrolled out of view or removed, its variable is not sampled anymore
+	void HandleRowReleased(const TSharedRef<ITableRow>& Row);
+
 	// General Get children
 	void HandleGetChildren(TSharedPtr<FDlgDataDisplayTreeNode> InItem, TArray<TSharedPtr<FDlgDataDisplayTreeNode>>& OutChildren);
 
@@ -75,16 +88,6 @@ private:
 	// Callback for expanding tree items recursively
 	void HandleSetExpansionRecursive(TSharedPtr<FDlgDataDisplayTreeNode> InItem, bool bInIsItemExpanded);
 
-	// Compare two FDlgDataDisplayTreeNode
-	static bool PredicateCompareDlgDataDisplayTreeNode(const TSharedPtr<FDlgDataDisplayTreeNode>& FirstNode, const TSharedPtr<FDlgDataDisplayTreeNode>& SecondNode)
-	{
-		if (!FirstNode.IsValid() || !SecondNode.IsValid())
-		{
-			return false;
-		}
-		return *FirstNode == *SecondNode;
-	}
-
 private:
 	// The search box
 	TSharedPtr<SSearchBox> FilterTextBoxWidget;
@@ -108,4 +111,14 @@ private:
 
 	// Reference Object used to get the World
 	TWeakObjectPtr<const UObject> WorldContextObjectPtr = nullptr;
+
+	// Variables with a value and a generated row, sampled every UDlgSystemSettings::DataDisplaySampleIntervalSeconds
+	// Key: the row widget, removed when the tree releases it
+	TMap<const ITableRow*, TSharedPtr<FDlgDataDisplayTreeVariableNode>> VisibleVariableNodes;
+
+	// Rows generated since the last sample, sampled on the next Tick so they do not wait for the interval
+	bool bHasNewVisibleVariables = false;
+
+	// Seconds since the last sample
+	float SampleElapsedSeconds = 0.f;
 };
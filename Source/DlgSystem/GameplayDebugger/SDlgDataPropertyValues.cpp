@@ -8,6 +8,7 @@
 #include "Widgets/Input/SCheckBox.h"
 #include "Widgets/Input/SEditableTextBox.h"
 
+#include "DlgSystem/DlgDialogueParticipant.h"
 #include "DlgSystem/NYReflectionHelper.h"
 #include "UObject/TextProperty.h"
 
@@ -25,11 +26,6 @@ static FText ValidateNameLength(const FText& Text)
 	return FText::GetEmpty();
 }
 
-static FString BoolToFString(const bool Value)
-{
-	return Value ? TEXT("True") : TEXT("False");
-}
-
 static bool FStringToBool(const FString& Value)
 {
 	return FCString::ToBool(*Value);
@@ -45,8 +41,6 @@ void SDlgDataPropertyValue::Construct(const FArguments& InArgs, const TSharedPtr
 		return;
 	}
 
-	UpdateVariableNodeFromActor();
-
 	ChildSlot
 	[
 		SNew(STextBlock)
@@ -54,109 +48,11 @@ void SDlgDataPropertyValue::Construct(const FArguments& InArgs, const TSharedPtr
 	];
 }
 
-void SDlgDataPropertyValue::Tick(const FGeometry& AllottedGeometry, double InCurrentTime, float InDeltaTime)
-{
-	Super::Tick(AllottedGeometry, InCurrentTime, InDeltaTime);
-
-	// We only run this Tick only after TickUpdateTimeSeconds has passed
-	TickPassedDeltaTimeSeconds += InDeltaTime;
-	if (TickPassedDeltaTimeSeconds < TickUpdateTimeSeconds)
-	{
-		return;
-	}
-
-	// Update the value
-	TickPassedDeltaTimeSeconds = 0.f;
-	UpdateVariableNodeFromActor();
-}
-
 void SDlgDataPropertyValue::UpdateVariableNodeFromActor()
 {
-	if (!VariableNode.IsValid())
+	if (VariableNode.IsValid())
 	{
-		return;
-	}
-
-	TWeakObjectPtr<const AActor> Actor = VariableNode->GetParentActor();
-	if (!Actor.IsValid())
-	{
-		return;
-	}
-
-	const FName VariableName = VariableNode->GetVariableName();
-	switch (VariableNode->GetVariableType())
-	{
-		case EDlgDataDisplayVariableTreeNodeType::Integer:
-		{
-			const int32 Value = IDlgDialogueParticipant::Execute_GetIntValue(Actor.Get(), VariableName);
-			VariableNode->SetVariableValue(FString::FromInt(Value));
-			break;
-		}
-		case EDlgDataDisplayVariableTreeNodeType::Float:
-		{
-			const float Value = IDlgDialogueParticipant::Execute_GetFloatValue(Actor.Get(), VariableName);
-			VariableNode->SetVariableValue(FString::SanitizeFloat(Value));
-			break;
-		}
-		case EDlgDataDisplayVariableTreeNodeType::Bool:
-		{
-			const bool Value = IDlgDialogueParticipant::Execute_GetBoolValue(Actor.Get(), VariableName);
-			VariableNode->SetVariableValue(BoolToFString(Value));
-			break;
-		}
-		case EDlgDataDisplayVariableTreeNodeType::FName:
-		{
-			const FName Value = IDlgDialogueParticipant::Execute_GetNameValue(Actor.Get(), VariableName);
-			VariableNode->SetVariableValue(Value.ToString());
-			break;
-		}
-
-		case EDlgDataDisplayVariableTreeNodeType::ClassInteger:
-		{
-			const int32 Value = FNYReflectionHelper::GetVariable<FIntProperty, int32>(Actor.Get(), VariableName);
-			VariableNode->SetVariableValue(FString::FromInt(Value));
-			break;
-		}
-		case EDlgDataDisplayVariableTreeNodeType::ClassFloat:
-		{
-			const double Value = FNYReflectionHelper::GetVariable<FDoubleProperty, double>(Actor.Get(), VariableName);
-			VariableNode->SetVariableValue(FString::SanitizeFloat(Value));
-			break;
-		}
-		{
-		case EDlgDataDisplayVariableTreeNodeType::ClassBool:
-			const bool Value = FNYReflectionHelper::GetVariable<FBoolProperty, bool>(Actor.Get(), VariableName);
-			VariableNode->SetVariableValue(BoolToFString(Value));
-			break;
-		}
-		case EDlgDataDisplayVariableTreeNodeType::ClassFName:
-		{
-			const FName Value = FNYReflectionHelper::GetVariable<FNameProperty, FName>(Actor.Get(), VariableName);
-			VariableNode->SetVariableValue(Value.ToString());
-			break;
-		}
-		case EDlgDataDisplayVariableTreeNodeType::ClassFText:
-		{
-			const FText Value = FNYReflectionHelper::GetVariable<FTextProperty, FText>(Actor.Get(), VariableName);
-			VariableNode->SetVariableValue(Value.ToString());
-			break;
-		}
-
-		case EDlgDataDisplayVariableTreeNodeType::Event:
-		case EDlgDataDisplayVariableTreeNodeType::UnrealFunction:
-		{
-			// Event does not have any state value, ignore
-			break;
-		}
-		case EDlgDataDisplayVariableTreeNodeType::Condition:
-		{
-			const bool Value = IDlgDialogueParticipant::Execute_CheckCondition(Actor.Get(), nullptr, VariableName);
-			VariableNode->SetVariableValue(BoolToFString(Value));
-			break;
-		}
-		case EDlgDataDisplayVariableTreeNodeType::Default:
-		default:
-			VariableNode->SetVariableValue(TEXT("UNIMPLEMENTED - SHOULD NEVER HAPPEN"));
+		VariableNode->UpdateVariableValueFromActor();
 	}
 }
 
@@ -171,7 +67,6 @@ void SDlgDataTextPropertyValue::Construct(const FArguments& InArgs, const TShare
 		return;
 	}
 
-	UpdateVariableNodeFromActor();
 	bIsFNameProperty = VariableNode->GetVariableType() == EDlgDataDisplayVariableTreeNodeType::FName;
 
 	ChildSlot
@@ -376,7 +271,6 @@ void SDlgDataBoolPropertyValue::Construct(const FArguments& InArgs, const TShare
 		return;
 	}
 
-	UpdateVariableNodeFromActor();
 	ChildSlot
 	[
 		SAssignNew(CheckBoxWidget, SCheckBox)
@@ -19,19 +19,13 @@ public:
 	SLATE_BEGIN_ARGS(Self) {}
 	SLATE_END_ARGS()
 
+	// The values are read by the SDlgDataDisplay sampler for all the visible rows at once, nothing to do in the Tick
+	SDlgDataPropertyValue() { SetCanTick(false); }
+
 	void Construct(const FArguments& InArgs, const TSharedPtr<FDlgDataDisplayTreeVariableNode>& InVariableNode);
 
 	// SWidget Interface
 
-	/**
-	 * Ticks this widget with Geometry.  Override in derived classes, but always call the parent implementation.
-	 *
-	 * @param  AllottedGeometry The space allotted for this widget
-	 * @param  InCurrentTime  Current absolute real time
-	 * @param  InDeltaTime  Real time passed since last tick
-	 */
-	void Tick(const FGeometry& AllottedGeometry, double InCurrentTime, float InDeltaTime) override;
-
 	/**
 	 * Checks to see if this widget supports keyboard focus.  Override this in derived classes.
 	 *
@@ -65,7 +59,7 @@ public:
 	FText GetTextValue() const { return FText::FromString(VariableNode->GetVariableValue()); }
 
 protected:
-	/** Updates the VariableNode value from the Actor. */
+	/** Updates the VariableNode value from the Actor. Used after the value is modified so we do not wait for the next sample. */
 	void UpdateVariableNodeFromActor();
 
 protected:
@@ -74,11 +68,6 @@ protected:
 
 	/** Primary Widget of this PropertyValue */
 	TSharedPtr<SWidget> PrimaryWidget;
-
-	/** Number of seconds passed in the Tick */
-	float TickPassedDeltaTimeSeconds = 0.f;
-
-	static constexpr float TickUpdateTimeSeconds = 1.0f;
 };
 
 
@@ -117,12 +106,6 @@ public:
 
 	void Construct(const FArguments& InArgs, const TSharedPtr<FDlgDataDisplayTreeVariableNode>& InVariableNode);
 
-	// SWidget Interface
-	void Tick(const FGeometry& AllottedGeometry, double InCurrentTime, float InDeltaTime) override
-	{
-		SCompoundWidget::Tick(AllottedGeometry, InCurrentTime, InDeltaTime);
-	}
-
 protected:
 	FReply HandleTriggerEventClicked();
 	FReply HandleTriggerEventClicked_Function();
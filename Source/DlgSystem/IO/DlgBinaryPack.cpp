@@ -0,0 +1,90 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#include "DlgBinaryPack.h"
+
+#include "UObject/EnumProperty.h"
+#include "UObject/TextProperty.h"
+
+#include "DlgSystem/NYReflectionHelper.h"
+
+const FString FDlgBinaryPack::FileExtension(TEXT("dlgpack"));
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+EDlgBinaryValueType FDlgBinaryPack::GetValueType(const FProperty* Property)
+{
+	check(Property);
+
+	if (FNYReflectionHelper::CastProperty<FBoolProperty>(Property))
+	{
+		return EDlgBinaryValueType::Bool;
+	}
+	if (GetEnum(Property) != nullptr)
+	{
+		return EDlgBinaryValueType::Enum;
+	}
+	if (const auto* NumericProperty = FNYReflectionHelper::CastProperty<FNumericProperty>(Property))
+	{
+		return NumericProperty->IsFloatingPoint() ? EDlgBinaryValueType::Float : EDlgBinaryValueType::Integer;
+	}
+	if (FNYReflectionHelper::CastProperty<FNameProperty>(Property))
+	{
+		return EDlgBinaryValueType::Name;
+	}
+	if (FNYReflectionHelper::CastProperty<FStrProperty>(Property))
+	{
+		return EDlgBinaryValueType::String;
+	}
+	if (FNYReflectionHelper::CastProperty<FTextProperty>(Property))
+	{
+		return EDlgBinaryValueType::Text;
+	}
+	if (const auto* StructProperty = FNYReflectionHelper::CastProperty<FStructProperty>(Property))
+	{
+		// Same as the JSON writer, structs that know how to export themselves are written as text (FGuid, FGameplayTag, FDateTime...)
+		const UScriptStruct::ICppStructOps* CppStructOps = StructProperty->Struct->GetCppStructOps();
+		return CppStructOps && CppStructOps->HasExportTextItem() ? EDlgBinaryValueType::ExportedText : EDlgBinaryValueType::Struct;
+	}
+	if (FNYReflectionHelper::CastProperty<FObjectProperty>(Property))
+	{
+		return EDlgBinaryValueType::Object;
+	}
+	if (FNYReflectionHelper::CastProperty<FArrayProperty>(Property))
+	{
+		return EDlgBinaryValueType::Array;
+	}
+	if (FNYReflectionHelper::CastProperty<FSetProperty>(Property))
+	{
+		return EDlgBinaryValueType::Set;
+	}
+	if (FNYReflectionHelper::CastProperty<FMapProperty>(Property))
+	{
+		return EDlgBinaryValueType::Map;
+	}
+
+	return EDlgBinaryValueType::ExportedText;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+const UEnum* FDlgBinaryPack::GetEnum(const FProperty* Property)
+{
+	if (const auto* EnumProperty = FNYReflectionHelper::CastProperty<FEnumProperty>(Property))
+	{
+		return EnumProperty->GetEnum();
+	}
+	if (const auto* ByteProperty = FNYReflectionHelper::CastProperty<FByteProperty>(Property))
+	{
+		return ByteProperty->Enum;
+	}
+
+	return nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+const FNumericProperty* FDlgBinaryPack::GetEnumUnderlyingProperty(const FProperty* Property)
+{
+	if (const auto* EnumProperty = FNYReflectionHelper::CastProperty<FEnumProperty>(Property))
+	{
+		return EnumProperty->GetUnderlyingProperty();
+	}
+
+	return FNYReflectionHelper::CastProperty<FByteProperty>(Property);
+}
@@ -0,0 +1,151 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#pragma once
+
+#include "CoreTypes.h"
+#include "Serialization/Archive.h"
+#include "UObject/UnrealType.h"
+
+// Version of the binary pack layout, see FDlgBinaryPackHeader
+struct DLGSYSTEM_API FDlgBinaryPackVersion
+{
+	enum Type
+	{
+		// First version of the pack
+		Initial = 0,
+
+		// The header stores the byte size of the name and string tables
+		AddedTableSizes,
+
+		// -----<new versions can be added above this line>-------------------------------------------------
+		VersionPlusOne,
+		LatestVersion = VersionPlusOne - 1
+	};
+
+private:
+	FDlgBinaryPackVersion() {}
+};
+
+// How a property value is encoded inside the payload
+enum class EDlgBinaryValueType : uint8
+{
+	// uint8
+	Bool = 0,
+
+	// int64, used for every integer property
+	Integer,
+
+	// double, used for float and double properties
+	Float,
+
+	// Name table index of the enumerator name
+	Enum,
+
+	// Name table index
+	Name,
+
+	// String table index
+	String,
+
+	// String table index of the FText in the FTextStringHelper format (keeps the localization namespace and key)
+	Text,
+
+	// Nested property block
+	Struct,
+
+	// EDlgBinaryObjectKind followed by the reference path or the class name and the nested property block
+	Object,
+
+	// int32 Num followed by the elements
+	Array,
+	Set,
+	Map,
+
+	// String table index of the ExportText result, used for everything else (native structs, soft references, etc.)
+	ExportedText
+};
+
+// How an UObject is stored inside the payload, see IDlgWriter::CanSaveAsReference
+enum class EDlgBinaryObjectKind : uint8
+{
+	Null = 0,
+	Reference,
+	Inline
+};
+
+/**
+ * Header of a binary dialogue pack. The pack is one contiguous blob:
+ *	Header | Name table | String table | Payload
+ *
+ * The tables are the names and strings serialized as FString, one after the other.
+ *
+ * The Payload is a tree of property blocks, every block is:
+ *	int32 NumProperties, then for each property: int32 NameIndex, int32 ArrayIndex, uint8 EDlgBinaryValueType, int32 ByteSize, Value
+ * Properties are tagged and sized so that renamed/removed/retyped properties can be skipped on load.
+ * Container elements and nested values are not tagged, their type is known from the property.
+ */
+struct DLGSYSTEM_API FDlgBinaryPackHeader
+{
+public:
+	// 'DLGP'
+	static constexpr uint32 MagicValue = 0x50474C44;
+
+	uint32 Magic = MagicValue;
+	int32 Version = FDlgBinaryPackVersion::LatestVersion;
+
+	// Name table index of the root struct/class name
+	int32 RootNameIndex = INDEX_NONE;
+
+	int32 NameCount = 0;
+	int64 NameTableOffset = 0;
+
+	int32 StringCount = 0;
+	int64 StringTableOffset = 0;
+
+	int64 PayloadOffset = 0;
+	int64 PayloadSize = 0;
+
+	// Byte size of the tables, before AddedTableSizes each table ends where the next part starts
+	int64 NameTableSize = 0;
+	int64 StringTableSize = 0;
+
+	friend FArchive& operator<<(FArchive& Ar, FDlgBinaryPackHeader& Header)
+	{
+		Ar << Header.Magic;
+		Ar << Header.Version;
+		Ar << Header.RootNameIndex;
+		Ar << Header.NameCount;
+		Ar << Header.NameTableOffset;
+		Ar << Header.StringCount;
+		Ar << Header.StringTableOffset;
+		Ar << Header.PayloadOffset;
+		Ar << Header.PayloadSize;
+		if (Header.Version >= FDlgBinaryPackVersion::AddedTableSizes)
+		{
+			Ar << Header.NameTableSize;
+			Ar << Header.StringTableSize;
+		}
+		else if (Ar.IsLoading())
+		{
+			Header.NameTableSize = Header.StringTableOffset - Header.NameTableOffset;
+			Header.StringTableSize = Header.PayloadOffset - Header.StringTableOffset;
+		}
+		return Ar;
+	}
+};
+
+// Helpers shared by FDlgBinaryWriter and FDlgBinaryParser
+class DLGSYSTEM_API FDlgBinaryPack
+{
+public:
+	// File extension of the binary packs, without the dot
+	static const FString FileExtension;
+
+	// How the value of this property is encoded
+	static EDlgBinaryValueType GetValueType(const FProperty* Property);
+
+	// Gets the enum of an FEnumProperty or of an FByteProperty with an enum, nullptr otherwise
+	static const UEnum* GetEnum(const FProperty* Property);
+
+	// Gets the property that holds the numeric value of the enum, see GetEnum
+	static const FNumericProperty* GetEnumUnderlyingProperty(const FProperty* Property);
+};
@@ -0,0 +1,454 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#include "DlgBinaryParser.h"
+
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "UObject/EnumProperty.h"
+#include "UObject/TextProperty.h"
+#include "Internationalization/Text.h"
+
+#include "DlgSystem/NYReflectionHelper.h"
+#include "DlgSystem/NYEngineVersionHelpers.h"
+#include "DlgSystem/DlgStats.h"
+
+DEFINE_LOG_CATEGORY(LogDlgBinaryParser);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void FDlgBinaryParser::InitializeParser(const FString& FilePath)
+{
+	FileName = FPaths::GetBaseFilename(FilePath, true);
+
+	TArray<uint8> FileBytes;
+	if (!FFileHelper::LoadFileToArray(FileBytes, *FilePath))
+	{
+		UE_LOG(LogDlgBinaryParser, Error, TEXT("Failed to load binary pack %s"), *FilePath);
+		Bytes.Empty();
+		bIsValidFile = false;
+		return;
+	}
+
+	InitializeParserFromBytes(MoveTemp(FileBytes));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void FDlgBinaryParser::InitializeParserFromBytes(TArray<uint8>&& InBytes)
+{
+	Bytes = MoveTemp(InBytes);
+	bIsValidFile = ReadHeaderAndTables();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool FDlgBinaryParser::ReadHeaderAndTables()
+{
+	Names.Empty();
+	Strings.Empty();
+	Header = {};
+
+	FMemoryReader Ar(Bytes);
+	Ar << Header;
+	if (Ar.IsError() || Header.Magic != FDlgBinaryPackHeader::MagicValue)
+	{
+		UE_LOG(LogDlgBinaryParser, Error, TEXT("`%s` is not a binary dialogue pack"), *FileName);
+		return false;
+	}
+	if (Header.Version > FDlgBinaryPackVersion::LatestVersion)
+	{
+		UE_LOG(LogDlgBinaryParser, Error, TEXT("Binary pack `%s` has version %d but the latest supported version is %d"),
+			*FileName, Header.Version, static_cast<int32>(FDlgBinaryPackVersion::LatestVersion));
+		return false;
+	}
+
+	const int64 TotalSize = Bytes.Num();
+	auto IsValidRange = [TotalSize](int64 Offset, int64 Size)
+	{
+		return Offset >= 0 && Size >= 0 && Offset + Size <= TotalSize;
+	};
+	// Every table entry takes at least the int32 length
+	auto IsValidTable = [&IsValidRange](int64 Offset, int64 Size, int32 Count)
+	{
+		return IsValidRange(Offset, Size) && Count >= 0 && Count <= Size / static_cast<int64>(sizeof(int32));
+	};
+	if (!IsValidTable(Header.NameTableOffset, Header.NameTableSize, Header.NameCount) ||
+		!IsValidTable(Header.StringTableOffset, Header.StringTableSize, Header.StringCount) ||
+		!IsValidRange(Header.PayloadOffset, Header.PayloadSize))
+	{
+		UE_LOG(LogDlgBinaryParser, Error, TEXT("Binary pack `%s` is corrupted, the header offsets are out of range"), *FileName);
+		return false;
+	}
+
+	// Fixup pass, resolve the tables once so that the payload can reference them by index
+	const int64 NameTableEnd = Header.NameTableOffset + Header.NameTableSize;
+	Ar.Seek(Header.NameTableOffset);
+	Names.Reserve(Header.NameCount);
+	FString NameString;
+	bool bSucceeded = true;
+	for (int32 Index = 0; Index < Header.NameCount && bSucceeded; Index++)
+	{
+		bSucceeded = ReadTableString(Ar, NameTableEnd, NameString);
+		Names.Add(FName(*NameString));
+	}
+
+	const int64 StringTableEnd = Header.StringTableOffset + Header.StringTableSize;
+	Ar.Seek(Header.StringTableOffset);
+	Strings.SetNum(Header.StringCount);
+	for (int32 Index = 0; Index < Header.StringCount && bSucceeded; Index++)
+	{
+		bSucceeded = ReadTableString(Ar, StringTableEnd, Strings[Index]);
+	}
+
+	if (!bSucceeded || Ar.IsError() || !Names.IsValidIndex(Header.RootNameIndex))
+	{
+		UE_LOG(LogDlgBinaryParser, Error, TEXT("Binary pack `%s` is corrupted, failed to read the name and string tables"), *FileName);
+		return false;
+	}
+
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void FDlgBinaryParser::ReadAllProperty(const UStruct* ReferenceClass, void* TargetObject, UObject* DefaultObjectOuter)
+{
+	DLG_SCOPE_CYCLE_COUNTER(Parse);
+	DLG_LLM_SCOPE();
+	if (!bIsValidFile)
+	{
+		return;
+	}
+
+	if (Names[Header.RootNameIndex] != ReferenceClass->GetFName())
+	{
+		UE_LOG(LogDlgBinaryParser, Warning, TEXT("Binary pack `%s` was written from `%s` but it is read into `%s`"),
+			*FileName, *Names[Header.RootNameIndex].ToString(), *ReferenceClass->GetName());
+	}
+
+	FMemoryReader Ar(Bytes);
+	Ar.Seek(Header.PayloadOffset);
+	if (!ReadStruct(Ar, ReferenceClass, TargetObject, DefaultObjectOuter))
+	{
+		UE_LOG(LogDlgBinaryParser, Error, TEXT("Binary pack `%s` is corrupted, failed to read the payload"), *FileName);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool FDlgBinaryParser::ReadStruct(FArchive& Ar, const UStruct* StructDefinition, void* ContainerPtr, UObject* DefaultObjectOuter)
+{
+	int32 NumProperties = 0;
+	Ar << NumProperties;
+
+	for (int32 PropertyIndex = 0; PropertyIndex < NumProperties; PropertyIndex++)
+	{
+		int32 NameIndex = INDEX_NONE;
+		int32 ArrayIndex = 0;
+		uint8 ValueType = 0;
+		int32 ByteSize = 0;
+		Ar << NameIndex;
+		Ar << ArrayIndex;
+		Ar << ValueType;
+		Ar << ByteSize;
+
+		const int64 EndOffset = Ar.Tell() + ByteSize;
+		if (Ar.IsError() || ByteSize < 0 || EndOffset > Ar.TotalSize() || !Names.IsValidIndex(NameIndex))
+		{
+			return false;
+		}
+
+		// Skip the properties that do not exist anymore or changed their type
+		const FProperty* Property = StructDefinition->FindPropertyByName(Names[NameIndex]);
+		if (Property == nullptr || ArrayIndex < 0 || ArrayIndex >= Property->ArrayDim ||
+			static_cast<uint8>(FDlgBinaryPack::GetValueType(Property)) != ValueType)
+		{
+			if (bLogVerbose)
+			{
+				UE_LOG(LogDlgBinaryParser, Verbose, TEXT("ReadStruct - Skipping property `%s` of `%s` in `%s`, it does not exist or its type changed"),
+					*Names[NameIndex].ToString(), *StructDefinition->GetName(), *FileName);
+			}
+			Ar.Seek(EndOffset);
+			continue;
+		}
+
+		if (!ReadValue(Ar, Property, Property->ContainerPtrToValuePtr<void>(ContainerPtr, ArrayIndex), DefaultObjectOuter) || Ar.Tell() != EndOffset)
+		{
+			UE_LOG(LogDlgBinaryParser, Warning, TEXT("ReadStruct - Failed to read property `%s` of `%s` in `%s`"),
+				*Property->GetName(), *StructDefinition->GetName(), *FileName);
+			if (Ar.IsError())
+			{
+				return false;
+			}
+			Ar.Seek(EndOffset);
+		}
+	}
+
+	return !Ar.IsError();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool FDlgBinaryParser::ReadValue(FArchive& Ar, const FProperty* Property, void* ValuePtr, UObject* DefaultObjectOuter)
+{
+	switch (FDlgBinaryPack::GetValueType(Property))
+	{
+		case EDlgBinaryValueType::Bool:
+		{
+			uint8 bValue = 0;
+			Ar << bValue;
+			FNYReflectionHelper::CastProperty<FBoolProperty>(Property)->SetPropertyValue(ValuePtr, bValue != 0);
+			return true;
+		}
+		case EDlgBinaryValueType::Integer:
+		{
+			int64 Value = 0;
+			Ar << Value;
+			FNYReflectionHelper::CastProperty<FNumericProperty>(Property)->SetIntPropertyValue(ValuePtr, Value);
+			return true;
+		}
+		case EDlgBinaryValueType::Float:
+		{
+			double Value = 0.0;
+			Ar << Value;
+			FNYReflectionHelper::CastProperty<FNumericProperty>(Property)->SetFloatingPointPropertyValue(ValuePtr, Value);
+			return true;
+		}
+		case EDlgBinaryValueType::Enum:
+		{
+			FName EnumName;
+			if (!ReadName(Ar, EnumName))
+			{
+				return false;
+			}
+
+			const int64 Value = FDlgBinaryPack::GetEnum(Property)->GetValueByName(EnumName);
+			if (Value == INDEX_NONE)
+			{
+				UE_LOG(LogDlgBinaryParser, Warning, TEXT("ReadValue - Enum `%s` does not have the value `%s` anymore (binary pack `%s`)"),
+					*FDlgBinaryPack::GetEnum(Property)->GetName(), *EnumName.ToString(), *FileName);
+				return true;
+			}
+
+			FDlgBinaryPack::GetEnumUnderlyingProperty(Property)->SetIntPropertyValue(ValuePtr, Value);
+			return true;
+		}
+		case EDlgBinaryValueType::Name:
+		{
+			FName Name;
+			if (!ReadName(Ar, Name))
+			{
+				return false;
+			}
+
+			FNYReflectionHelper::CastProperty<FNameProperty>(Property)->SetPropertyValue(ValuePtr, Name);
+			return true;
+		}
+		case EDlgBinaryValueType::String:
+		{
+			const FString* String = nullptr;
+			if (!ReadString(Ar, String))
+			{
+				return false;
+			}
+
+			FNYReflectionHelper::CastProperty<FStrProperty>(Property)->SetPropertyValue(ValuePtr, *String);
+			return true;
+		}
+		case EDlgBinaryValueType::Text:
+		{
+			const FString* String = nullptr;
+			if (!ReadString(Ar, String))
+			{
+				return false;
+			}
+
+			FText Text;
+			if (FTextStringHelper::ReadFromBuffer(**String, Text) == nullptr)
+			{
+				Text = FText::FromString(*String);
+			}
+			FNYReflectionHelper::CastProperty<FTextProperty>(Property)->SetPropertyValue(ValuePtr, Text);
+			return true;
+		}
+		case EDlgBinaryValueType::Struct:
+		{
+			return ReadStruct(Ar, FNYReflectionHelper::CastProperty<FStructProperty>(Property)->Struct, ValuePtr, DefaultObjectOuter);
+		}
+		case EDlgBinaryValueType::Object:
+		{
+			const auto* ObjectProperty = FNYReflectionHelper::CastProperty<FObjectProperty>(Property);
+			ObjectProperty->SetObjectPropertyValue(ValuePtr, nullptr);
+
+			uint8 KindValue = 0;
+			Ar << KindValue;
+			switch (static_cast<EDlgBinaryObjectKind>(KindValue))
+			{
+				case EDlgBinaryObjectKind::Null:
+					return true;
+
+				case EDlgBinaryObjectKind::Reference:
+				{
+					// Special case, load by reference, See CanSaveAsReference
+					const FString* Path = nullptr;
+					if (!ReadString(Ar, Path))
+					{
+						return false;
+					}
+
+					ObjectProperty->SetObjectPropertyValue(ValuePtr, StaticLoadObject(UObject::StaticClass(), DefaultObjectOuter, **Path));
+					return true;
+				}
+
+				case EDlgBinaryObjectKind::Inline:
+				{
+					FName ClassName;
+					if (!ReadName(Ar, ClassName))
+					{
+						return false;
+					}
+
+					const UClass* ChildClass = GetChildClassFromName(ObjectProperty->PropertyClass, ClassName.ToString());
+					if (ChildClass == nullptr)
+					{
+						UE_LOG(LogDlgBinaryParser, Error, TEXT("ReadValue - Could not find class `%s` for FObjectProperty = `%s` (binary pack `%s`)"),
+							*ClassName.ToString(), *Property->GetName(), *FileName);
+						return false;
+					}
+
+					UObject* Object = CreateNewUObject(ChildClass, DefaultObjectOuter);
+					ObjectProperty->SetObjectPropertyValue(ValuePtr, Object);
+					return ReadStruct(Ar, ChildClass, Object, DefaultObjectOuter);
+				}
+
+				default:
+					return false;
+			}
+		}
+		case EDlgBinaryValueType::Array:
+		{
+			int32 Num = 0;
+			if (!ReadNum(Ar, Num))
+			{
+				return false;
+			}
+
+			const auto* ArrayProperty = FNYReflectionHelper::CastProperty<FArrayProperty>(Property);
+			FScriptArrayHelper Helper(ArrayProperty, ValuePtr);
+			Helper.EmptyAndAddValues(Num);
+			for (int32 Index = 0; Index < Num; Index++)
+			{
+				if (!ReadValue(Ar, ArrayProperty->Inner, Helper.GetRawPtr(Index), DefaultObjectOuter))
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+		case EDlgBinaryValueType::Set:
+		{
+			int32 Num = 0;
+			if (!ReadNum(Ar, Num))
+			{
+				return false;
+			}
+
+			FScriptSetHelper Helper(FNYReflectionHelper::CastProperty<FSetProperty>(Property), ValuePtr);
+			Helper.EmptyElements(Num);
+			bool bSucceeded = true;
+			for (int32 Index = 0; Index < Num && bSucceeded; Index++)
+			{
+				const int32 ElementIndex = Helper.AddDefaultValue_Invalid_NeedsRehash();
+				bSucceeded = ReadValue(Ar, Helper.ElementProp, Helper.GetElementPtr(ElementIndex), DefaultObjectOuter);
+			}
+			Helper.Rehash();
+			return bSucceeded;
+		}
+		case EDlgBinaryValueType::Map:
+		{
+			int32 Num = 0;
+			if (!ReadNum(Ar, Num))
+			{
+				return false;
+			}
+
+			FScriptMapHelper Helper(FNYReflectionHelper::CastProperty<FMapProperty>(Property), ValuePtr);
+			Helper.EmptyValues(Num);
+			bool bSucceeded = true;
+			for (int32 Index = 0; Index < Num && bSucceeded; Index++)
+			{
+				const int32 PairIndex = Helper.AddDefaultValue_Invalid_NeedsRehash();
+				bSucceeded = ReadValue(Ar, Helper.KeyProp, Helper.GetKeyPtr(PairIndex), DefaultObjectOuter) &&
+							 ReadValue(Ar, Helper.ValueProp, Helper.GetValuePtr(PairIndex), DefaultObjectOuter);
+			}
+			Helper.Rehash();
+			return bSucceeded;
+		}
+		case EDlgBinaryValueType::ExportedText:
+		default:
+		{
+			const FString* String = nullptr;
+			if (!ReadString(Ar, String))
+			{
+				return false;
+			}
+
+#if NY_ENGINE_VERSION >= 501
+			Property->ImportText_Direct(**String, ValuePtr, nullptr, PPF_None);
+#else
+			Property->ImportText(**String, ValuePtr, PPF_None, nullptr);
+#endif
+			return true;
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool FDlgBinaryParser::ReadName(FArchive& Ar, FName& OutName) const
+{
+	int32 Index = INDEX_NONE;
+	Ar << Index;
+	if (Ar.IsError() || !Names.IsValidIndex(Index))
+	{
+		return false;
+	}
+
+	OutName = Names[Index];
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool FDlgBinaryParser::ReadString(FArchive& Ar, const FString*& OutString) const
+{
+	int32 Index = INDEX_NONE;
+	Ar << Index;
+	if (Ar.IsError() || !Strings.IsValidIndex(Index))
+	{
+		return false;
+	}
+
+	OutString = &Strings[Index];
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool FDlgBinaryParser::ReadTableString(FArchive& Ar, int64 TableEnd, FString& OutString) const
+{
+	// Same length prefix as the FString serialization, negative for UTF-16, both include the null terminator
+	const int64 StartOffset = Ar.Tell();
+	int32 SaveNum = 0;
+	Ar << SaveNum;
+	const int64 NumBytes = SaveNum < 0 ? -static_cast<int64>(SaveNum) * sizeof(UTF16CHAR) : static_cast<int64>(SaveNum) * sizeof(ANSICHAR);
+	if (Ar.IsError() || NumBytes > FMath::Min(TableEnd, Ar.TotalSize()) - Ar.Tell())
+	{
+		return false;
+	}
+
+	// The length is trusted now
+	Ar.Seek(StartOffset);
+	Ar << OutString;
+	return !Ar.IsError() && Ar.Tell() <= TableEnd;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool FDlgBinaryParser::ReadNum(FArchive& Ar, int32& OutNum) const
+{
+	Ar << OutNum;
+
+	// Every element takes at least one byte, anything bigger is a corrupted pack
+	return !Ar.IsError() && OutNum >= 0 && OutNum <= Ar.TotalSize() - Ar.Tell();
+}
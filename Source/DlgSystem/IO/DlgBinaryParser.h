@@ -0,0 +1,69 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#pragma once
+
+#include "Logging/LogMacros.h"
+#include "UObject/UnrealType.h"
+
+#include "IDlgParser.h"
+#include "DlgBinaryPack.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogDlgBinaryParser, All, All);
+
+/**
+ * Reads a binary pack written by FDlgBinaryWriter, see FDlgBinaryPackHeader for the layout.
+ * The whole file is loaded with a single read, the name and string tables are resolved once (fixup pass)
+ * then the payload is walked and written into the target object.
+ */
+class DLGSYSTEM_API FDlgBinaryParser : public IDlgParser
+{
+public:
+	FDlgBinaryParser() {};
+	FDlgBinaryParser(const FString& FilePath) { InitializeParser(FilePath); };
+
+	// IDlgParser Interface
+	void InitializeParser(const FString& FilePath) override;
+	bool IsValidFile() const override { return bIsValidFile; }
+	void ReadAllProperty(const UStruct* ReferenceClass, void* TargetObject, UObject* DefaultObjectOuter = nullptr) override;
+
+	/** Initializes the parser with a pack that is already in memory */
+	void InitializeParserFromBytes(TArray<uint8>&& InBytes);
+
+	const FDlgBinaryPackHeader& GetHeader() const { return Header; }
+
+private:
+	/** Reads the header and resolves the name and string tables */
+	bool ReadHeaderAndTables();
+
+	/**
+	 * Reads a property block into the ContainerPtr.
+	 * Unknown or mismatched properties are skipped.
+	 * @return false only if the archive is corrupted
+	 */
+	bool ReadStruct(FArchive& Ar, const UStruct* StructDefinition, void* ContainerPtr, UObject* DefaultObjectOuter);
+
+	/** Reads a single value, ValuePtr points directly to the value of the Property */
+	bool ReadValue(FArchive& Ar, const FProperty* Property, void* ValuePtr, UObject* DefaultObjectOuter);
+
+	/** Reads a name/string table index from the archive */
+	bool ReadName(FArchive& Ar, FName& OutName) const;
+	bool ReadString(FArchive& Ar, const FString*& OutString) const;
+
+	/** Reads a string of the name or string table, its length must fit before the TableEnd offset */
+	bool ReadTableString(FArchive& Ar, int64 TableEnd, FString& OutString) const;
+
+	/** Reads the element count of a container */
+	bool ReadNum(FArchive& Ar, int32& OutNum) const;
+
+private:
+	TArray<uint8> Bytes;
+	FDlgBinaryPackHeader Header;
+
+	// Resolved tables
+	TArray<FName> Names;
+	TArray<FString> Strings;
+
+	bool bIsValidFile = false;
+
+	// Used only for logging
+	FString FileName;
+};
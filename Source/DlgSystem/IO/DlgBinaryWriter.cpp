@@ -0,0 +1,296 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#include "DlgBinaryWriter.h"
+
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryWriter.h"
+#include "UObject/EnumProperty.h"
+#include "UObject/TextProperty.h"
+#include "Internationalization/Text.h"
+
+#include "DlgSystem/NYReflectionHelper.h"
+#include "DlgSystem/NYEngineVersionHelpers.h"
+#include "DlgSystem/DlgStats.h"
+
+DEFINE_LOG_CATEGORY(LogDlgBinaryWriter);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void FDlgBinaryWriter::Write(const UStruct* StructDefinition, const void* Object)
+{
+	DLG_SCOPE_CYCLE_COUNTER(Write);
+	DLG_LLM_SCOPE();
+	Bytes.Empty();
+	Names.Empty();
+	NameIndices.Empty();
+	Strings.Empty();
+	StringIndices.Empty();
+
+	// Payload first, this fills the tables
+	TArray<uint8> Payload;
+	FMemoryWriter PayloadWriter(Payload);
+	FDlgBinaryPackHeader Header;
+	Header.RootNameIndex = GetNameIndex(StructDefinition->GetFName());
+	WriteStruct(PayloadWriter, StructDefinition, Object);
+
+	// Header | Name table | String table | Payload
+	FMemoryWriter Writer(Bytes);
+	Writer << Header;
+
+	Header.NameCount = Names.Num();
+	Header.NameTableOffset = Writer.Tell();
+	for (const FName& Name : Names)
+	{
+		FString NameString = Name.ToString();
+		Writer << NameString;
+	}
+	Header.NameTableSize = Writer.Tell() - Header.NameTableOffset;
+
+	Header.StringCount = Strings.Num();
+	Header.StringTableOffset = Writer.Tell();
+	for (FString& String : Strings)
+	{
+		Writer << String;
+	}
+	Header.StringTableSize = Writer.Tell() - Header.StringTableOffset;
+
+	Header.PayloadOffset = Writer.Tell();
+	Header.PayloadSize = Payload.Num();
+	Writer.Serialize(Payload.GetData(), Payload.Num());
+
+	// Now we know the offsets
+	Writer.Seek(0);
+	Writer << Header;
+
+	if (bLogVerbose)
+	{
+		UE_LOG(LogDlgBinaryWriter, Verbose, TEXT("Write - `%s` names = %d, strings = %d, payload = %lld bytes, total = %d bytes"),
+			*StructDefinition->GetName(), Names.Num(), Strings.Num(), Header.PayloadSize, Bytes.Num());
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool FDlgBinaryWriter::ExportToFile(const FString& FileName)
+{
+	return FFileHelper::SaveArrayToFile(Bytes, *FileName);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void FDlgBinaryWriter::WriteStruct(FArchive& Ar, const UStruct* StructDefinition, const void* ContainerPtr)
+{
+	// Number of properties is only known at the end
+	const int64 NumPropertiesOffset = Ar.Tell();
+	int32 NumProperties = 0;
+	Ar << NumProperties;
+
+	for (TFieldIterator<const FProperty> It(StructDefinition); It; ++It)
+	{
+		const FProperty* Property = *It;
+		if (CanSkipProperty(Property))
+		{
+			continue;
+		}
+
+		int32 NameIndex = GetNameIndex(Property->GetFName());
+		uint8 ValueType = static_cast<uint8>(FDlgBinaryPack::GetValueType(Property));
+		for (int32 ArrayIndex = 0; ArrayIndex < Property->ArrayDim; ArrayIndex++)
+		{
+			Ar << NameIndex;
+			Ar << ArrayIndex;
+			Ar << ValueType;
+
+			const int64 SizeOffset = Ar.Tell();
+			int32 ByteSize = 0;
+			Ar << ByteSize;
+
+			WriteValue(Ar, Property, Property->ContainerPtrToValuePtr<void>(ContainerPtr, ArrayIndex));
+
+			// Patch the size so that the parser can skip unknown properties
+			const int64 EndOffset = Ar.Tell();
+			ByteSize = static_cast<int32>(EndOffset - SizeOffset - sizeof(int32));
+			Ar.Seek(SizeOffset);
+			Ar << ByteSize;
+			Ar.Seek(EndOffset);
+
+			NumProperties++;
+		}
+	}
+
+	const int64 EndOffset = Ar.Tell();
+	Ar.Seek(NumPropertiesOffset);
+	Ar << NumProperties;
+	Ar.Seek(EndOffset);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void FDlgBinaryWriter::WriteValue(FArchive& Ar, const FProperty* Property, const void* ValuePtr)
+{
+	switch (FDlgBinaryPack::GetValueType(Property))
+	{
+		case EDlgBinaryValueType::Bool:
+		{
+			uint8 bValue = FNYReflectionHelper::CastProperty<FBoolProperty>(Property)->GetPropertyValue(ValuePtr) ? 1 : 0;
+			Ar << bValue;
+			break;
+		}
+		case EDlgBinaryValueType::Integer:
+		{
+			int64 Value = FNYReflectionHelper::CastProperty<FNumericProperty>(Property)->GetSignedIntPropertyValue(ValuePtr);
+			Ar << Value;
+			break;
+		}
+		case EDlgBinaryValueType::Float:
+		{
+			double Value = FNYReflectionHelper::CastProperty<FNumericProperty>(Property)->GetFloatingPointPropertyValue(ValuePtr);
+			Ar << Value;
+			break;
+		}
+		case EDlgBinaryValueType::Enum:
+		{
+			// Store the name, the values of an enum can be reordered
+			const UEnum* Enum = FDlgBinaryPack::GetEnum(Property);
+			const int64 Value = FDlgBinaryPack::GetEnumUnderlyingProperty(Property)->GetSignedIntPropertyValue(ValuePtr);
+			int32 NameIndex = GetNameIndex(Enum->GetNameByValue(Value));
+			Ar << NameIndex;
+			break;
+		}
+		case EDlgBinaryValueType::Name:
+		{
+			int32 NameIndex = GetNameIndex(FNYReflectionHelper::CastProperty<FNameProperty>(Property)->GetPropertyValue(ValuePtr));
+			Ar << NameIndex;
+			break;
+		}
+		case EDlgBinaryValueType::String:
+		{
+			int32 StringIndex = GetStringIndex(FNYReflectionHelper::CastProperty<FStrProperty>(Property)->GetPropertyValue(ValuePtr));
+			Ar << StringIndex;
+			break;
+		}
+		case EDlgBinaryValueType::Text:
+		{
+			FString TextString;
+			FTextStringHelper::WriteToBuffer(TextString, FNYReflectionHelper::CastProperty<FTextProperty>(Property)->GetPropertyValue(ValuePtr));
+			int32 StringIndex = GetStringIndex(TextString);
+			Ar << StringIndex;
+			break;
+		}
+		case EDlgBinaryValueType::Struct:
+		{
+			WriteStruct(Ar, FNYReflectionHelper::CastProperty<FStructProperty>(Property)->Struct, ValuePtr);
+			break;
+		}
+		case EDlgBinaryValueType::Object:
+		{
+			const auto* ObjectProperty = FNYReflectionHelper::CastProperty<FObjectProperty>(Property);
+			const UObject* Object = ObjectProperty->GetObjectPropertyValue(ValuePtr);
+
+			EDlgBinaryObjectKind Kind = EDlgBinaryObjectKind::Inline;
+			if (Object == nullptr || !Object->IsValidLowLevelFast())
+			{
+				Kind = EDlgBinaryObjectKind::Null;
+			}
+			else if (CanSaveAsReference(ObjectProperty, Object))
+			{
+				Kind = EDlgBinaryObjectKind::Reference;
+			}
+
+			uint8 KindValue = static_cast<uint8>(Kind);
+			Ar << KindValue;
+			if (Kind == EDlgBinaryObjectKind::Reference)
+			{
+				int32 StringIndex = GetStringIndex(Object->GetPathName());
+				Ar << StringIndex;
+			}
+			else if (Kind == EDlgBinaryObjectKind::Inline)
+			{
+				const UClass* ObjectClass = Object->GetClass();
+				int32 NameIndex = GetNameIndex(ObjectClass->GetFName());
+				Ar << NameIndex;
+				WriteStruct(Ar, ObjectClass, Object);
+			}
+			break;
+		}
+		case EDlgBinaryValueType::Array:
+		{
+			const auto* ArrayProperty = FNYReflectionHelper::CastProperty<FArrayProperty>(Property);
+			FScriptArrayHelper Helper(ArrayProperty, ValuePtr);
+			int32 Num = Helper.Num();
+			Ar << Num;
+			for (int32 Index = 0; Index < Num; Index++)
+			{
+				WriteValue(Ar, ArrayProperty->Inner, Helper.GetRawPtr(Index));
+			}
+			break;
+		}
+		case EDlgBinaryValueType::Set:
+		{
+			const auto* SetProperty = FNYReflectionHelper::CastProperty<FSetProperty>(Property);
+			FScriptSetHelper Helper(SetProperty, ValuePtr);
+			int32 Num = Helper.Num();
+			Ar << Num;
+			for (int32 Index = 0, Written = 0; Written < Num; Index++)
+			{
+				if (Helper.IsValidIndex(Index))
+				{
+					WriteValue(Ar, Helper.ElementProp, Helper.GetElementPtr(Index));
+					Written++;
+				}
+			}
+			break;
+		}
+		case EDlgBinaryValueType::Map:
+		{
+			const auto* MapProperty = FNYReflectionHelper::CastProperty<FMapProperty>(Property);
+			FScriptMapHelper Helper(MapProperty, ValuePtr);
+			int32 Num = Helper.Num();
+			Ar << Num;
+			for (int32 Index = 0, Written = 0; Written < Num; Index++)
+			{
+				if (Helper.IsValidIndex(Index))
+				{
+					WriteValue(Ar, Helper.KeyProp, Helper.GetKeyPtr(Index));
+					WriteValue(Ar, Helper.ValueProp, Helper.GetValuePtr(Index));
+					Written++;
+				}
+			}
+			break;
+		}
+		case EDlgBinaryValueType::ExportedText:
+		default:
+		{
+			FString ExportedString;
+#if NY_ENGINE_VERSION >= 501
+			Property->ExportTextItem_Direct(ExportedString, ValuePtr, nullptr, nullptr, PPF_None);
+#else
+			Property->ExportTextItem(ExportedString, ValuePtr, nullptr, nullptr, PPF_None);
+#endif
+			int32 StringIndex = GetStringIndex(ExportedString);
+			Ar << StringIndex;
+			break;
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int32 FDlgBinaryWriter::GetNameIndex(FName Name)
+{
+	if (const int32* IndexPtr = NameIndices.Find(Name))
+	{
+		return *IndexPtr;
+	}
+
+	const int32 Index = Names.Add(Name);
+	NameIndices.Add(Name, Index);
+	return Index;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int32 FDlgBinaryWriter::GetStringIndex(const FString& String)
+{
+	if (const int32* IndexPtr = StringIndices.Find(String))
+	{
+		return *IndexPtr;
+	}
+
+	const int32 Index = Strings.Add(String);
+	StringIndices.Add(String, Index);
+	return Index;
+}
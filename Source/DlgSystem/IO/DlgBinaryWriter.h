@@ -0,0 +1,67 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#pragma once
+
+#include "Logging/LogMacros.h"
+#include "UObject/UnrealType.h"
+
+#include "IDlgWriter.h"
+#include "DlgBinaryPack.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogDlgBinaryWriter, All, All);
+
+// The default FString key funcs ignore case, the string table must not
+struct FDlgBinaryStringKeyFuncs : BaseKeyFuncs<TPair<FString, int32>, FString, false>
+{
+	static const FString& GetSetKey(const TPair<FString, int32>& Element) { return Element.Key; }
+	static bool Matches(const FString& A, const FString& B) { return A.Equals(B, ESearchCase::CaseSensitive); }
+	static uint32 GetKeyHash(const FString& Key) { return FCrc::StrCrc32(*Key); }
+};
+
+/**
+ * Writes an UStruct/UObject into a binary pack, see FDlgBinaryPackHeader for the layout.
+ * Every FName and FString is stored once in the name/string tables, the payload only references them by index.
+ * See IDlgWriter for properties and METADATA specifiers.
+ */
+class DLGSYSTEM_API FDlgBinaryWriter : public IDlgWriter
+{
+public:
+	FDlgBinaryWriter() {};
+
+	// IDlgWriter Interface
+	void Write(const UStruct* StructDefinition, const void* Object) override;
+
+	/**
+	 * Save the pack to a binary file
+	 * @param FullName: Full path + file name + extension
+	 * @return	False on failure to write
+	 */
+	bool ExportToFile(const FString& FileName) override;
+
+	/** The pack is binary, always returns an empty string. Use GetAsBytes */
+	const FString& GetAsString() const override { return EmptyString; }
+
+	/** @return the whole pack, valid after Write */
+	const TArray<uint8>& GetAsBytes() const { return Bytes; }
+
+private:
+	/** Writes a property block: the number of properties then every tagged and sized property */
+	void WriteStruct(FArchive& Ar, const UStruct* StructDefinition, const void* ContainerPtr);
+
+	/** Writes a single value, ValuePtr points directly to the value of the Property */
+	void WriteValue(FArchive& Ar, const FProperty* Property, const void* ValuePtr);
+
+	/** Adds the name/string to the table if it is not yet there */
+	int32 GetNameIndex(FName Name);
+	int32 GetStringIndex(const FString& String);
+
+private:
+	TArray<uint8> Bytes;
+
+	TArray<FName> Names;
+	TMap<FName, int32> NameIndices;
+
+	TArray<FString> Strings;
+	TMap<FString, int32, FDefaultSetAllocator, FDlgBinaryStringKeyFuncs> StringIndices;
+
+	FString EmptyString;
+};
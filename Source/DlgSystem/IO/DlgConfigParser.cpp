@@ -9,6 +9,7 @@
 #include "UObject/TextProperty.h"
 
 #include "DlgSystem/NYReflectionHelper.h"
+#include "DlgSystem/DlgStats.h"
 
 DEFINE_LOG_CATEGORY(LogDlgConfigParser);
 
@@ -33,6 +34,8 @@ void FDlgConfigParser::InitializeParser(const FString& FilePath)
 	From = 0;
 	Len = 0;
 	bHasValidWord = false;
+	LineNumberCacheIndex = 0;
+	LineNumberCacheValue = 1;
 
 	if (!FFileHelper::LoadFileToString(String, *FilePath))
 	{
@@ -55,12 +58,16 @@ void FDlgConfigParser::InitializeParserFromString(const FString& Text)
 	From = 0;
 	Len = 0;
 	bHasValidWord = false;
+	LineNumberCacheIndex = 0;
+	LineNumberCacheValue = 1;
 	FindNextWord();
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 void FDlgConfigParser::ReadAllProperty(const UStruct* ReferenceClass, void* TargetObject, UObject* DefaultObjectOuter)
 {
+	DLG_SCOPE_CYCLE_COUNTER(Parse);
+	DLG_LLM_SCOPE();
 	while (ReadProperty(ReferenceClass, TargetObject, DefaultObjectOuter));
 }
 
@@ -82,8 +89,9 @@ bool FDlgConfigParser::ReadProperty(const UStruct* ReferenceClass, void* TargetO
 	}
 	check(From < String.Len());
 
-	const FString PropertyName = GetActiveWord();
-	auto* PropertyBase = ReferenceClass->FindPropertyByName(*PropertyName);
+	const FStringView PropertyNameView = GetActiveWordView();
+	const FName PropertyName = WordToName(PropertyNameView);
+	auto* PropertyBase = ReferenceClass->FindPropertyByName(PropertyName);
 	if (PropertyBase != nullptr)
 	{
 		// check primitive types and enums
@@ -107,7 +115,7 @@ bool FDlgConfigParser::ReadProperty(const UStruct* ReferenceClass, void* TargetO
 		}
 	}
 
-	auto* ComplexPropBase = ReferenceClass->FindPropertyByName(*PropertyName);
+	auto* ComplexPropBase = PropertyBase;
 
 	// struct
 	if (auto* StructProperty = FNYReflectionHelper::SmartCastProperty<FStructProperty>(ComplexPropBase))
@@ -120,14 +128,15 @@ bool FDlgConfigParser::ReadProperty(const UStruct* ReferenceClass, void* TargetO
 	}
 
 	// check complex object - type name has to be here as well (dynamic array)
-	const FString TypeName = PreTag + PropertyName;
+	FString TypeName = PreTag;
+	TypeName.Append(PropertyNameView.GetData(), PropertyNameView.Len());
 	if (!FindNextWord("block name"))
 	{
 		return false;
 	}
 
 	const bool bLoadByRef = IsNextWordString();
-	const FString VariableName = GetActiveWord();
+	const FStringView VariableName = GetActiveWordView();
 
 	// check if it is stored as reference
 	if (bLoadByRef)
@@ -142,7 +151,7 @@ bool FDlgConfigParser::ReadProperty(const UStruct* ReferenceClass, void* TargetO
 		*ObjectPtrPtr = nullptr; // reset first
 		if (!VariableName.TrimStartAndEnd().IsEmpty()) // null reference?
 		{
-			*ObjectPtrPtr = StaticLoadObject(UObject::StaticClass(), DefaultObjectOuter, *VariableName);
+			*ObjectPtrPtr = StaticLoadObject(UObject::StaticClass(), DefaultObjectOuter, *FString(VariableName));
 		}
 		FindNextWord();
 		return true;
@@ -153,11 +162,11 @@ bool FDlgConfigParser::ReadProperty(const UStruct* ReferenceClass, void* TargetO
 	// - nullptr - PropertyName ""
 	if (bHasNullptr)
 	{
-		ComplexPropBase = ReferenceClass->FindPropertyByName(*PropertyName);
+		ComplexPropBase = PropertyBase;
 	}
 	else
 	{
-		ComplexPropBase = ReferenceClass->FindPropertyByName(*VariableName);
+		ComplexPropBase = ReferenceClass->FindPropertyByName(WordToName(VariableName));
 	}
 	if (auto* ObjectProperty = FNYReflectionHelper::SmartCastProperty<FObjectProperty>(ComplexPropBase))
 	{
@@ -171,7 +180,7 @@ bool FDlgConfigParser::ReadProperty(const UStruct* ReferenceClass, void* TargetO
 	}
 
 	UE_LOG(LogDlgConfigParser, Warning, TEXT("Invalid token `%s` in script `%s` (line: %d) (Property expected for PropertyName = `%s`)"),
-		   *GetActiveWord(), *FileName, GetActiveLineNumber(), *PropertyName);
+		   *GetActiveWord(), *FileName, GetActiveLineNumber(), *PropertyName.ToString());
 	FindNextWord();
 	return false;
 }
@@ -179,14 +188,15 @@ bool FDlgConfigParser::ReadProperty(const UStruct* ReferenceClass, void* TargetO
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 bool FDlgConfigParser::ReadPurePropertyBlock(void* TargetObject, const UStruct* ReferenceClass, bool bBlockStartAlreadyRead, UObject* Outer)
 {
-	if (!bBlockStartAlreadyRead && !FindNextWordAndCheckIfBlockStart(ReferenceClass->GetName()))
+	const FString BlockName = ReferenceClass->GetName();
+	if (!bBlockStartAlreadyRead && !FindNextWordAndCheckIfBlockStart(BlockName))
 	{
 		return false;
 	}
 
 	// parse precondition properties
 	FindNextWord();
-	while (!CheckIfBlockEnd(ReferenceClass->GetName()))
+	while (!CheckIfBlockEnd(BlockName))
 	{
 		if (!bHasValidWord)
 		{
@@ -208,13 +218,13 @@ bool FDlgConfigParser::GetActiveWordAsFloat(float& FloatValue) const
 		return false;
 	}
 
-	const FString FloatString = String.Mid(From, Len);
-	if (FloatString.Len() == 0 || !FloatString.IsNumeric())
+	// The word always ends with a whitespace, '"' or the end of the string, so we can convert it in place
+	if (!IsNumeric(GetActiveWordView()))
 	{
 		return false;
 	}
 
-	FloatValue = FCString::Atof(*FloatString);
+	FloatValue = FCString::Atof(*String + From);
 	return true;
 }
 
@@ -226,13 +236,46 @@ bool FDlgConfigParser::GetActiveWordAsDouble(double& DoubleValue) const
 		return false;
 	}
 
-	const FString DoubleString = String.Mid(From, Len);
-	if (DoubleString.Len() == 0 || !DoubleString.IsNumeric())
+	if (!IsNumeric(GetActiveWordView()))
 	{
 		return false;
 	}
 
-	DoubleValue = FCString::Atod(*DoubleString);
+	DoubleValue = FCString::Atod(*String + From);
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool FDlgConfigParser::IsNumeric(FStringView Word)
+{
+	if (Word.Len() == 0)
+	{
+		return false;
+	}
+
+	int32 Index = 0;
+	if (Word[0] == '-' || Word[0] == '+')
+	{
+		Index++;
+	}
+
+	bool bHasDot = false;
+	for (; Index < Word.Len(); ++Index)
+	{
+		if (Word[Index] == '.')
+		{
+			if (bHasDot)
+			{
+				return false;
+			}
+			bHasDot = true;
+		}
+		else if (!FChar::IsDigit(Word[Index]))
+		{
+			return false;
+		}
+	}
+
 	return true;
 }
 
@@ -274,6 +317,7 @@ bool FDlgConfigParser::FindNextWord()
 {
 	bHasNullptr = false;
 	From += Len;
+	Len = 0;
 
 	// Skip " (aka the open of string)
 	if (bActiveIsString)
@@ -282,21 +326,38 @@ bool FDlgConfigParser::FindNextWord()
 	}
 	bActiveIsString = false;
 
-	// Skip whitespaces
-	while (From < String.Len() && FChar::IsWhitespace(String[From]))
+	const int32 StringLen = String.Len();
+	const TCHAR* Data = *String;
+	while (true)
 	{
-		From++;
+		// Skip whitespaces
+		while (From < StringLen && FChar::IsWhitespace(Data[From]))
+		{
+			From++;
+		}
+
+		// Skip comments //, advance past this line and look again
+		if (From + 1 < StringLen && Data[From] == '/' && Data[From + 1] == '/')
+		{
+			while (From < StringLen && Data[From] != '\n' && Data[From] != '\r')
+			{
+				From++;
+			}
+			continue;
+		}
+
+		break;
 	}
 
 	// Oh noeeeees
-	if (From >= String.Len())
+	if (From >= StringLen)
 	{
 		bHasValidWord = false;
 		return false;
 	}
 
 	// Handle "" as special empty string
-	if (From + 1 < String.Len() && String[From] == '"' && String[From + 1] == '"')
+	if (From + 1 < StringLen && Data[From] == '"' && Data[From + 1] == '"')
 	{
 		From += 2; // skip both characters for the next string
 		Len = 0;
@@ -306,12 +367,12 @@ bool FDlgConfigParser::FindNextWord()
 	}
 
 	// Handle special string case - read everything between two "
-	if (String[From] == '"')
+	if (Data[From] == '"')
 	{
 		Len = 1;
 		bActiveIsString = true;
 		// Find the closing "
-		while (From + Len < String.Len() && String[From + Len] != '"')
+		while (From + Len < StringLen && Data[From + Len] != '"')
 		{
 			Len++;
 		}
@@ -331,35 +392,20 @@ bool FDlgConfigParser::FindNextWord()
 		return true;
 	}
 
-	Len = 0;
 	// Is block begin/end
-	if (String[From] == '{' || String[From] == '}')
+	if (Data[From] == '{' || Data[From] == '}')
 	{
 		Len = 1;
 	}
 	else
 	{
 		// Count until we reach a whitespace char OR EOF
-		while (From + Len < String.Len() && !FChar::IsWhitespace(String[From + Len]))
+		while (From + Len < StringLen && !FChar::IsWhitespace(Data[From + Len]))
 		{
 			Len++;
 		}
 	}
 
-	// Skip comments //
-	if (Len > 1 && String[From] == '/' && String[From + 1] == '/')
-	{
-		// Advance past this line
-		while (From < String.Len() && String[From] != '\n' && String[From] != '\r')
-		{
-			From++;
-		}
-
-		// Use recursion to go to the next line
-		Len = 0;
-		return FindNextWord();
-	}
-
 	// Phew, valid word
 	bHasValidWord = true;
 	return true;
@@ -380,7 +426,7 @@ bool FDlgConfigParser::FindNextWord(const FString& ExpectedStuff)
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 bool FDlgConfigParser::FindNextWordAndCheckIfBlockStart(const FString& BlockName)
 {
-	if (!FindNextWord() || !CompareToActiveWord("{"))
+	if (!FindNextWord() || !CompareToActiveWord(TEXT("{")))
 	{
 		UE_LOG(LogDlgConfigParser, Warning, TEXT("Block start signal expected but not found for %s block in script %s (line: %d)"),
 											*BlockName, *FileName, GetActiveLineNumber());
@@ -414,7 +460,7 @@ bool FDlgConfigParser::CheckIfBlockEnd(const FString& BlockName)
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-bool FDlgConfigParser::CompareToActiveWord(const FString& StringToCompare) const
+bool FDlgConfigParser::CompareToActiveWord(FStringView StringToCompare) const
 {
 	// Length differs?
 	if (!bHasValidWord || StringToCompare.Len() != Len)
@@ -443,8 +489,16 @@ int32 FDlgConfigParser::GetActiveLineNumber() const
 		return INDEX_NONE;
 	}
 
-	int32 LineCount = 1;
-	for (int32 i = 0; i < String.Len() && i < From; ++i)
+	// Words are mostly queried in order, continue from the last position unless we went back
+	if (From < LineNumberCacheIndex)
+	{
+		LineNumberCacheIndex = 0;
+		LineNumberCacheValue = 1;
+	}
+
+	int32 LineCount = LineNumberCacheValue;
+	int32 i = LineNumberCacheIndex;
+	for (; i < String.Len() && i < From; ++i)
 	{
 		switch (String[i])
 		{
@@ -461,6 +515,8 @@ int32 FDlgConfigParser::GetActiveLineNumber() const
 		}
 	}
 
+	LineNumberCacheIndex = i;
+	LineNumberCacheValue = LineCount;
 	return LineCount;
 }
 
@@ -528,7 +584,7 @@ bool FDlgConfigParser::TryToReadEnum(void* Target, FProperty* PropertyBase)
 		}
 		else
 		{
-			Value = FName(*String.Mid(From, Len));
+			Value = WordToName(GetActiveWordView());
 		}
 
 		auto* Prop = FNYReflectionHelper::SmartCastProperty<FEnumProperty>(PropertyBase);
@@ -636,7 +692,7 @@ bool FDlgConfigParser::ReadMap(void* TargetObject, FMapProperty& Property, UObje
 			auto* StructVal = FNYReflectionHelper::CastProperty<FStructProperty>(Props[i]);
 			if (StructVal != nullptr)
 			{
-				if (!CompareToActiveWord("{"))
+				if (!CompareToActiveWord(TEXT("{")))
 				{
 					UE_LOG(LogDlgConfigParser, Warning, TEXT("Syntax error: missing struct block start '{' in script %s(:%d)"),
 							*FileName, GetActiveLineNumber());
@@ -713,7 +769,7 @@ void FDlgConfigParser::OnInvalidValue(const FString& PropType) const
 	{
 		const int32 LineNumber = GetActiveLineNumber();
 		UE_LOG(LogDlgConfigParser, Warning, TEXT("Invalid %s property value %s in script %s (line %d)"),
-			*PropType, *String.Mid(From, Len), *FileName, LineNumber);
+			*PropType, *GetActiveWord(), *FileName, LineNumber);
 	}
 	else
 		UE_LOG(LogDlgConfigParser, Warning, TEXT("Unexepcted end of file while expecting %s value in script %s"), *PropType, *FileName);
@@ -723,9 +779,9 @@ void FDlgConfigParser::OnInvalidValue(const FString& PropType) const
 bool FDlgConfigParser::GetAsBool() const
 {
 	bool bValue = false;
-	if (CompareToActiveWord("True"))
+	if (CompareToActiveWord(TEXT("True")))
 		bValue = true;
-	else if (!CompareToActiveWord("False"))
+	else if (!CompareToActiveWord(TEXT("False")))
 		OnInvalidValue("Bool");
 	return bValue;
 }
@@ -750,11 +806,10 @@ double FDlgConfigParser::GetAsDouble() const
 int32 FDlgConfigParser::GetAsInt32() const
 {
 	int32 Value = 0;
-	const FString IntString = String.Mid(From, Len);
-	if (IntString.Len() == 0 || (!IntString.IsNumeric()))
+	if (!IsNumeric(GetActiveWordView()))
 		OnInvalidValue("int32");
 	else
-		Value = FCString::Atoi(*IntString);
+		Value = FCString::Atoi(*String + From);
 	return Value;
 }
 
@@ -762,11 +817,10 @@ int32 FDlgConfigParser::GetAsInt32() const
 int64 FDlgConfigParser::GetAsInt64() const
 {
 	int64 Value = 0;
-	const FString IntString = String.Mid(From, Len);
-	if (IntString.Len() == 0 || (!IntString.IsNumeric()))
+	if (!IsNumeric(GetActiveWordView()))
 		OnInvalidValue("int64");
 	else
-		Value = FCString::Atoi64(*IntString);
+		Value = FCString::Atoi64(*String + From);
 	return Value;
 }
 
@@ -777,7 +831,7 @@ FName FDlgConfigParser::GetAsName() const
 	if (Len <= 0)
 		OnInvalidValue("FName");
 	else
-		Value = FName(*String.Mid(From, Len));
+		Value = WordToName(GetActiveWordView());
 	return Value;
 }
 
@@ -785,7 +839,7 @@ FName FDlgConfigParser::GetAsName() const
 FString FDlgConfigParser::GetAsString() const
 {
 	if (Len > 0)
-		return String.Mid(From, Len);
+		return FString(GetActiveWordView());
 
 	return "";
 }
@@ -795,7 +849,7 @@ FText FDlgConfigParser::GetAsText() const
 {
 	FString Input;
 	if (Len > 0)
-		Input = String.Mid(From, Len);
+		Input = FString(GetActiveWordView());
 
-	return FText::FromString(Input);
+	return FText::FromString(MoveTemp(Input));
 }
@@ -3,6 +3,7 @@
 
 #include <functional>
 #include "CoreTypes.h"
+#include "Containers/StringView.h"
 #include "Logging/LogMacros.h"
 
 #include "IDlgParser.h"
@@ -15,6 +16,7 @@ DECLARE_LOG_CATEGORY_EXTERN(LogDlgConfigParser, Log, All);
  * Because there is always another config format
  * Parser can be used to process the config word by word
  * 'word' is defined here as the thing between whitespaces
+ * Words are views (From, Len) into the loaded config string, a new string is only allocated for the values that are actually stored
  * '{' and '}' are exceptions:
  *		they can be in block and treated separately as *first* character recursively (e.g. "}}}}" is valid but "Name}" is not
  * Default functionality can read a whole data structure from the proper config format
@@ -101,6 +103,7 @@ private:
 
 	/**
 	 * Jumps to the next word in the parsed config
+	 * Whitespaces and comments (// until the end of the line) are skipped
 	 *
 	 * @return Whether a new word was found (false -> end of file)
 	 */
@@ -147,11 +150,11 @@ private:
 	 *
 	 * @return Whether the word and the strings are equal
 	 */
-	bool CompareToActiveWord(const FString& StringToCompare) const;
+	bool CompareToActiveWord(FStringView StringToCompare) const;
 
 	/**
 	 * Calculates the line count for the current word
-	 * TODO: could be counted on the fly
+	 * Counted from the last queried position, as the words are mostly queried in order
 	 * @return Active line index, or INDEX_NONE if there is no valid word
 	 */
 	int32 GetActiveLineNumber() const;
@@ -160,10 +163,19 @@ private:
 	bool HasValidWord() const { return bHasValidWord; }
 
 	/**
-	 * Should be avoided whenever possible (use CompareToActiveWord)
+	 * Should be avoided whenever possible (use CompareToActiveWord or GetActiveWordView)
 	 * @return the active word, or an empty string if there isn't any
 	 */
-	FString GetActiveWord() const { return bHasValidWord ? String.Mid(From, Len) : ""; }
+	FString GetActiveWord() const { return FString(GetActiveWordView()); }
+
+	/** @return the active word as a view into the config string (no allocation), or an empty view if there isn't any */
+	FStringView GetActiveWordView() const { return bHasValidWord ? FStringView(*String + From, Len) : FStringView(); }
+
+	/** Same as FCString::IsNumeric but does not need a null terminated string */
+	static bool IsNumeric(FStringView Word);
+
+	/** Creates a name from the word without creating a temporary string */
+	static FName WordToName(FStringView Word) { return FName(Word.Len(), Word.GetData()); }
 
 	/**
 	 * @param FloatValue: out float value if the call succeeds
@@ -272,6 +284,10 @@ private:
 
 	/** used to skip the closing '"' */
 	bool bActiveIsString = false;
+
+	/** GetActiveLineNumber cache: the line number at the LineNumberCacheIndex character */
+	mutable int32 LineNumberCacheIndex = 0;
+	mutable int32 LineNumberCacheValue = 1;
 };
 
 
@@ -298,10 +314,11 @@ bool FDlgConfigParser::ReadPrimitiveProperty(void* Target,
 
 		TArray<Type>* Array = ArrayProp->ContainerPtrToValuePtr<TArray<Type>>(Target);
 		Array->Empty();
-		if (FindNextWordAndCheckIfBlockStart(TypeName + "Array"))
+		const FString BlockName = TypeName + TEXT("Array");
+		if (FindNextWordAndCheckIfBlockStart(BlockName))
 		{
 			// read values until the block ends
-			while (!FindNextWordAndCheckIfBlockEnd(TypeName + "Array"))
+			while (!FindNextWordAndCheckIfBlockEnd(BlockName))
 			{
 				if (!bHasValidWord && !bCanBeEmpty)
 				{
@@ -352,32 +369,35 @@ bool FDlgConfigParser::ReadComplexProperty(void* Target,
 		// Array
 		FScriptArrayHelper Helper(ArrayProp, ArrayProp->ContainerPtrToValuePtr<uint8>(Target));
 		Helper.EmptyValues();
-		if (!FindNextWordAndCheckIfBlockStart(ReferenceType->GetName() + "Array element") || !FindNextWord("{ or }"))
+		const FString BlockName = ReferenceType->GetName() + TEXT("Array element");
+		if (!FindNextWordAndCheckIfBlockStart(BlockName) || !FindNextWord("{ or }"))
 		{
 			return false;
 		}
 
-		while (!CheckIfBlockEnd(ReferenceType->GetName() + "Array element"))
+		while (!CheckIfBlockEnd(BlockName))
 		{
 			const UClass* ReferenceClass = Cast<UClass>(ReferenceType);
 			if (ReferenceClass != nullptr)
 			{
 				if (IsActualWordString() && ArrayProp->Inner != nullptr) // UObject by reference
 				{
-					const FString Path = GetActiveWord();
+					const FStringView Path = GetActiveWordView();
 					void* TargetPtr = Helper.GetRawPtr(Helper.AddValue());
 					auto* ObjectPtrPtr = static_cast<UObject**>(TargetPtr);
 					*ObjectPtrPtr = nullptr; // reset first
 					if (!Path.TrimStartAndEnd().IsEmpty()) // null reference ?
 					{
-						*ObjectPtrPtr = StaticLoadObject(UObject::StaticClass(), Outer, *Path);
+						*ObjectPtrPtr = StaticLoadObject(UObject::StaticClass(), Outer, *FString(Path));
 					}
 
 					FindNextWord();
 					continue;
 				}
 
-				const FString TypeName = PreTag + GetActiveWord();
+				const FStringView ClassName = GetActiveWordView();
+				FString TypeName = PreTag;
+				TypeName.Append(ClassName.GetData(), ClassName.Len());
 				ReferenceClass = GetChildClassFromName(ReferenceClass, TypeName);
 				if (ReferenceClass == nullptr)
 				{
@@ -386,7 +406,7 @@ bool FDlgConfigParser::ReadComplexProperty(void* Target,
 					return false;
 				}
 			}
-			else if (!CompareToActiveWord("{"))
+			else if (!CompareToActiveWord(TEXT("{")))
 			{
 				if (!bHasValidWord)
 				{
@@ -7,6 +7,7 @@
 
 #include "DlgSystem/DlgHelper.h"
 #include "DlgSystem/NYReflectionHelper.h"
+#include "DlgSystem/DlgStats.h"
 
 DEFINE_LOG_CATEGORY(LogDlgConfigWriter);
 
@@ -27,6 +28,8 @@ FDlgConfigWriter::FDlgConfigWriter(const FString InComplexNamePrefix,
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 void FDlgConfigWriter::Write(const UStruct* const StructDefinition, const void* const Object)
 {
+	DLG_SCOPE_CYCLE_COUNTER(Write);
+	DLG_LLM_SCOPE();
 	TopLevelObjectPtr = Object;
 	WriteComplexMembersToString(StructDefinition, Object, "", EOL, ConfigText);
 }
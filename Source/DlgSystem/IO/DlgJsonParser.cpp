@@ -18,6 +18,7 @@
 #include "Misc/FeedbackContext.h"
 
 #include "DlgSystem/NYReflectionHelper.h"
+#include "DlgSystem/DlgStats.h"
 
 
 DEFINE_LOG_CATEGORY(LogDlgJsonParser);
@@ -94,6 +95,8 @@ void FDlgJsonParser::InitializeParserFromString(const FString& Text)
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 void FDlgJsonParser::ReadAllProperty( const UStruct* ReferenceClass, void* TargetObject, UObject* InDefaultObjectOuter)
 {
+	DLG_SCOPE_CYCLE_COUNTER(Parse);
+	DLG_LLM_SCOPE();
 	if (!IsValidFile())
 	{
 		return;
@@ -11,12 +11,15 @@
 
 #include "DlgSystem/DlgHelper.h"
 #include "DlgSystem/NYReflectionHelper.h"
+#include "DlgSystem/DlgStats.h"
 
 DEFINE_LOG_CATEGORY(LogDlgJsonWriter);
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 void FDlgJsonWriter::Write(const UStruct* StructDefinition, const void* ContainerPtr)
 {
+	DLG_SCOPE_CYCLE_COUNTER(Write);
+	DLG_LLM_SCOPE();
 	DlgJsonWriterOptions WriterOptions;
 	WriterOptions.bPrettyPrint = true;
 	WriterOptions.InitialIndent = 0;
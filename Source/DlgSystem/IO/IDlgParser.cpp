@@ -0,0 +1,89 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#include "IDlgParser.h"
+
+#include "UObject/UObjectHash.h"
+#include "UObject/UObjectIterator.h"
+
+#include "DlgSystem/Nodes/DlgNode.h"
+#include "DlgSystem/DlgConditionCustom.h"
+#include "DlgSystem/DlgEventCustom.h"
+#include "DlgSystem/DlgTextArgumentCustom.h"
+#include "DlgSystem/DlgNodeData.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+const UClass* IDlgParser::GetChildClassFromName(const UClass* ParentClass, const FString& Name)
+{
+	if (!bClassCacheInitialized)
+	{
+		InitializeClassCache();
+	}
+
+	const FName ClassName(*Name);
+	if (UClass** ClassPtr = ClassCache.Find(ClassName))
+	{
+		UClass* Class = *ClassPtr;
+		if (IsValid(Class) && Class->IsChildOf(ParentClass))
+		{
+			return Class;
+		}
+	}
+
+	// Already searched for it, does not exist
+	const TPair<const UClass*, FName> MissingKey(ParentClass, ClassName);
+	if (MissingClasses.Contains(MissingKey))
+	{
+		return nullptr;
+	}
+
+	// Not one of the known hierarchies (or loaded since), this might be heavy on performance
+	for (TObjectIterator<UClass> It; It; ++It)
+	{
+		if (It->IsChildOf(ParentClass) && !It->HasAnyClassFlags(CLASS_Abstract) && It->GetFName() == ClassName)
+		{
+			ClassCache.Add(ClassName, *It);
+			return *It;
+		}
+	}
+
+	MissingClasses.Add(MissingKey);
+	return nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void IDlgParser::InitializeClassCache()
+{
+	bClassCacheInitialized = true;
+	ClassCache.Empty();
+	MissingClasses.Empty();
+
+	const UClass* SeedClasses[] = {
+		UDlgNode::StaticClass(),
+		UDlgConditionCustom::StaticClass(),
+		UDlgEventCustom::StaticClass(),
+		UDlgTextArgumentCustom::StaticClass(),
+		UDlgNodeData::StaticClass()
+	};
+
+	TArray<UClass*> DerivedClasses;
+	for (const UClass* SeedClass : SeedClasses)
+	{
+		DerivedClasses.Reset();
+		GetDerivedClasses(SeedClass, DerivedClasses, true);
+		DerivedClasses.Add(const_cast<UClass*>(SeedClass));
+
+		for (UClass* Class : DerivedClasses)
+		{
+			if (Class->HasAnyClassFlags(CLASS_Abstract))
+			{
+				continue;
+			}
+
+			// Keep the first one, same as the class walk would
+			const FName ClassName = Class->GetFName();
+			if (!ClassCache.Contains(ClassName))
+			{
+				ClassCache.Add(ClassName, Class);
+			}
+		}
+	}
+}
@@ -1,8 +1,9 @@
 // Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
 #pragma once
 
-#include "UObject/UObjectIterator.h"
 #include "Containers/Array.h"
+#include "Containers/Map.h"
+#include "Containers/Set.h"
 #include "UObject/Object.h"
 
 class DLGSYSTEM_API IDlgParser
@@ -41,27 +42,14 @@ protected:
 	 *
 	 * @return the class, or nullptr if it does not exist
 	 */
-	const UClass* GetChildClassFromName(const UClass* ParentClass, const FString& Name)
-	{
-		for (UClass* Class : StructCache)
-		{
-			if (Class->IsChildOf(ParentClass) && Class->GetName() == Name)
-			{
-				return Class;
-			}
-		}
-
-		for (TObjectIterator<UClass> It; It; ++It)
-		{
-			if (It->IsChildOf(ParentClass) && !It->HasAnyClassFlags(CLASS_Abstract) && (*It)->GetName() == Name)
-			{
-				StructCache.Add(*It);
-				return *It;
-			}
-		}
+	const UClass* GetChildClassFromName(const UClass* ParentClass, const FString& Name);
 
-		return nullptr;
-	}
+	/**
+	 * Fills the ClassCache with every loaded, not abstract child class of the classes the dialogue uses polymorphically
+	 * (nodes, custom conditions/events/text arguments, node data).
+	 * Called once per parser (parse session) on the first class lookup.
+	 */
+	void InitializeClassCache();
 
 	/**
 	 * Default way to create new objects
@@ -73,8 +61,14 @@ protected:
 	}
 
 protected:
-	/** each time a class is read it also cached here, so next time when it has to be found based on name it can be found faster */
-	TArray<UClass*> StructCache;
+	/** Class name -> class, pre-seeded by InitializeClassCache, each class found later by name is also cached here */
+	TMap<FName, UClass*> ClassCache;
+
+	/** (ParentClass, Name) lookups that failed even after the full class walk, so we do not walk again for them */
+	TSet<TPair<const UClass*, FName>> MissingClasses;
+
+	// Was InitializeClassCache already called?
+	bool bClassCacheInitialized = false;
 
 	// Should this class verbose log?
 	bool bLogVerbose = false;
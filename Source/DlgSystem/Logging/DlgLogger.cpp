@@ -35,6 +35,7 @@ FDlgLogger& FDlgLogger::SyncWithSettings()
 	SetRedirectMessageLogLevelsHigherThan(Settings->RedirectMessageLogLevelsHigherThan);
 	SetOpenMessageLogLevelsHigherThan(Settings->OpenMessageLogLevelsHigherThan);
 	SetMessageLogOpenOnNewMessage(Settings->bMessageLogOpen);
+	SetMaxLogLevel(Settings->MaxLogLevel);
 
 	return *this;
 }
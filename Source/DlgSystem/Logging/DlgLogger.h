@@ -29,4 +29,19 @@ public:
 
 	static void OnStart();
 	static void OnShutdown();
+
+	// Minimum time between two messages of the same rate limited call site, see DLG_LOG_RATE_LIMITED
+	static constexpr double RateLimitSeconds = 1.0;
 };
+
+// Level gated logging with the dialogue logger, the arguments are only evaluated if the level is enabled
+#define DLG_LOG_ERROR(Fmt, ...) NY_LOG(FDlgLogger::Get(), ENYLoggerLogLevel::Error, Fmt, ##__VA_ARGS__)
+#define DLG_LOG_WARNING(Fmt, ...) NY_LOG(FDlgLogger::Get(), ENYLoggerLogLevel::Warning, Fmt, ##__VA_ARGS__)
+#define DLG_LOG_INFO(Fmt, ...) NY_LOG(FDlgLogger::Get(), ENYLoggerLogLevel::Info, Fmt, ##__VA_ARGS__)
+#define DLG_LOG_DEBUG(Fmt, ...) NY_LOG(FDlgLogger::Get(), ENYLoggerLogLevel::Debug, Fmt, ##__VA_ARGS__)
+
+// For the runtime messages that can fire every frame (e.g. from conditions or text arguments)
+#define DLG_LOG_ERROR_RATE_LIMITED(Fmt, ...) \
+	NY_LOG_RATE_LIMITED(FDlgLogger::Get(), ENYLoggerLogLevel::Error, FDlgLogger::RateLimitSeconds, Fmt, ##__VA_ARGS__)
+#define DLG_LOG_WARNING_RATE_LIMITED(Fmt, ...) \
+	NY_LOG_RATE_LIMITED(FDlgLogger::Get(), ENYLoggerLogLevel::Warning, FDlgLogger::RateLimitSeconds, Fmt, ##__VA_ARGS__)
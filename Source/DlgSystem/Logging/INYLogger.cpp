@@ -222,6 +222,10 @@ void INYLogger::Log(ENYLoggerLogLevel Level, const FString& Message)
 
 	// No logging, abort
 #if !NO_LOGGING
+	if (!IsLogLevelEnabled(Level))
+	{
+		return;
+	}
 	if (IsClientConsoleEnabled())
 	{
 		LogClientConsole(Level, Message);
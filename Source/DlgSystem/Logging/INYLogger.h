@@ -1,7 +1,10 @@
 // Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
 #pragma once
 
+#include <atomic>
+
 #include "CoreMinimal.h"
+#include "HAL/PlatformTime.h"
 #include "Logging/TokenizedMessage.h"
 #include "Logging/LogCategory.h"
 
@@ -69,6 +72,35 @@ enum class ENYLoggerLogLevel : uint8
 };
 
 
+/**
+ * Allows one message every IntervalSeconds, counts the messages dropped in between.
+ * One static instance per call site, see NY_LOG_RATE_LIMITED.
+ */
+struct FNYLogRateLimiter
+{
+	// Returns true if the message should be logged, OutNumSuppressed is the number of messages dropped since the last one
+	bool ShouldLog(double IntervalSeconds, int32& OutNumSuppressed)
+	{
+		const uint64 NowCycles = FPlatformTime::Cycles64();
+		const uint64 IntervalCycles = static_cast<uint64>(IntervalSeconds / FPlatformTime::GetSecondsPerCycle64());
+		uint64 LastCycles = LastLogCycles.load(std::memory_order_relaxed);
+		if ((LastCycles != 0 && NowCycles - LastCycles < IntervalCycles) ||
+			!LastLogCycles.compare_exchange_strong(LastCycles, NowCycles, std::memory_order_relaxed))
+		{
+			NumSuppressed.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+
+		OutNumSuppressed = NumSuppressed.exchange(0, std::memory_order_relaxed);
+		return true;
+	}
+
+private:
+	std::atomic<uint64> LastLogCycles{0};
+	std::atomic<int32> NumSuppressed{0};
+};
+
+
 /**
  * The following output are available:
  * - output log, also file on your filesystem which corresponds to the output log
@@ -293,6 +325,44 @@ public:
 	FORCEINLINE bool IsOutputLogEnabled() const { return bOutputLog; }
 	FORCEINLINE bool IsMessageLogEnabled() const { return bMessageLog; }
 
+	//
+	// Log levels
+	//
+
+	// Enables all the levels up to and including MaxLevel, NoLogging disables everything
+	Self& SetMaxLogLevel(ENYLoggerLogLevel MaxLevel)
+	{
+		EnabledLogLevelsMask = 0;
+		for (uint8 Level = static_cast<uint8>(ENYLoggerLogLevel::Error); Level <= static_cast<uint8>(MaxLevel); Level++)
+		{
+			EnabledLogLevelsMask |= 1 << Level;
+		}
+		return *this;
+	}
+	Self& SetLogLevelEnabled(ENYLoggerLogLevel Level, bool bEnabled)
+	{
+		if (bEnabled)
+		{
+			EnabledLogLevelsMask |= 1 << static_cast<uint8>(Level);
+		}
+		else
+		{
+			EnabledLogLevelsMask &= ~(1 << static_cast<uint8>(Level));
+		}
+		return *this;
+	}
+
+	// Would a message of this Level end up anywhere? Checked before formatting, see NY_LOG
+	FORCEINLINE bool IsLogLevelEnabled(ENYLoggerLogLevel Level) const
+	{
+#if NO_LOGGING
+		return false;
+#else
+		return (EnabledLogLevelsMask & (1 << static_cast<uint8>(Level))) != 0
+			&& (bClientConsole || bOnScreen || bOutputLog || bMessageLog);
+#endif // NO_LOGGING
+	}
+
 	template <typename FmtType, typename... Types>
 	void Logf(ENYLoggerLogLevel Level, const FmtType& Fmt, Types... Args)
 	{
@@ -302,7 +372,10 @@ public:
 		static_assert(TIsArrayOrRefOfType<FmtType, TCHAR>::Value, "Formatting string must be a TCHAR array.");
 #endif
 		static_assert(TAnd<TIsValidVariadicFunctionArg<Types>...>::Value, "Invalid argument(s) passed to INYLogger::Logf");
-		LogfImplementation(Level, Fmt, Args...);
+		if (IsLogLevelEnabled(Level))
+		{
+			LogfImplementation(Level, Fmt, Args...);
+		}
 	}
 
 	template <typename FmtType, typename... Types>
@@ -411,6 +484,9 @@ protected:
 	static FOutputDevice* GetOutputDeviceFromLogLevel(ENYLoggerLogLevel Level);
 
 protected:
+	// Bit (1 << Level) is set for every enabled ENYLoggerLogLevel, all levels are enabled by default
+	uint8 EnabledLogLevelsMask = 0xFF;
+
 	//
 	// On screen
 	//
@@ -492,3 +568,32 @@ protected:
 	FColor ColorDebug = FColor::Blue;
 	FColor ColorTrace = FColor::Cyan;
 };
+
+
+// Logs with Logger (INYLogger or child), the arguments are NOT evaluated if the Level is not enabled
+#define NY_LOG(Logger, Level, Fmt, ...) \
+	do \
+	{ \
+		INYLogger& NYLogger_ = (Logger); \
+		if (NYLogger_.IsLogLevelEnabled(Level)) \
+		{ \
+			NYLogger_.Logf(Level, Fmt, ##__VA_ARGS__); \
+		} \
+	} while (0)
+
+// Same as NY_LOG but logs at most once every IntervalSeconds from this call site, for messages that can fire every frame
+#define NY_LOG_RATE_LIMITED(Logger, Level, IntervalSeconds, Fmt, ...) \
+	do \
+	{ \
+		INYLogger& NYLogger_ = (Logger); \
+		static FNYLogRateLimiter NYRateLimiter_; \
+		int32 NYNumSuppressed_ = 0; \
+		if (NYLogger_.IsLogLevelEnabled(Level) && NYRateLimiter_.ShouldLog(IntervalSeconds, NYNumSuppressed_)) \
+		{ \
+			NYLogger_.Logf(Level, Fmt, ##__VA_ARGS__); \
+			if (NYNumSuppressed_ > 0) \
+			{ \
+				NYLogger_.Logf(Level, TEXT("(%d more messages like the one above were suppressed)"), NYNumSuppressed_); \
+			} \
+		} \
+	} while (0)
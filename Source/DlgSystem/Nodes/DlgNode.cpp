@@ -5,16 +5,32 @@
 #include "EngineUtils.h"
 #include "Sound/SoundWave.h"
 
+#include "DlgSystem/DlgConditionProgram.h"
 #include "DlgSystem/DlgContext.h"
 #include "DlgSystem/Logging/DlgLogger.h"
 #include "DlgSystem/DlgLocalizationHelper.h"
 #include "DlgSystem/DlgHelper.h"
+#include "DlgSystem/DlgStats.h"
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Begin UObject interface
 void UDlgNode::Serialize(FArchive& Ar)
 {
+#if WITH_EDITOR
+	// Only the cooked package gets the folded conditions
+	const bool bSerializeCookedData = bHasCookedData && Ar.IsSaving() && Ar.IsCooking();
+	if (bSerializeCookedData)
+	{
+		SwapCookedData();
+	}
+	Super::Serialize(Ar);
+	if (bSerializeCookedData)
+	{
+		SwapCookedData();
+	}
+#else
 	Super::Serialize(Ar);
+#endif // WITH_EDITOR
 #if NY_ENGINE_VERSION >= 500
 	const auto CurrentVersion = Ar.UEVer();
 #else
@@ -58,6 +74,7 @@ void UDlgNode::AddReferencedObjects(UObject* InThis, FReferenceCollector& Collec
 void UDlgNode::PostLoad()
 {
 	Super::PostLoad();
+	InvalidateConditionPrograms();
 
 	// NOTE: We don't this here but instead we do it in the compile phase
 	// Create thew new GUID
@@ -83,6 +100,7 @@ void UDlgNode::PostInitProperties()
 void UDlgNode::PostDuplicate(bool bDuplicateForPIE)
 {
 	Super::PostDuplicate(bDuplicateForPIE);
+	InvalidateConditionPrograms();
 
 	// Used when duplicating Nodes.
 	// We only generate a new GUID is the existing one is valid, otherwise it will be set in the compile phase
@@ -95,6 +113,7 @@ void UDlgNode::PostDuplicate(bool bDuplicateForPIE)
 void UDlgNode::PostEditImport()
 {
 	Super::PostEditImport();
+	InvalidateConditionPrograms();
 
 	// Used when duplicating Nodes.
 	// We only generate a new GUID is the existing one is valid, otherwise it will be set in the compile phase
@@ -108,6 +127,7 @@ void UDlgNode::PostEditImport()
 void UDlgNode::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
 {
 	Super::PostEditChangeProperty(PropertyChangedEvent);
+	InvalidateConditionPrograms();
 
 	// Signal to the listeners
 	OnDialogueNodePropertyChanged.Broadcast(PropertyChangedEvent, BroadcastPropertyEdgeIndexChanged);
@@ -159,16 +179,27 @@ void UDlgNode::FireNodeEnterEvents(UDlgContext& Context)
 	}
 }
 
+void UDlgNode::InvalidateConditionPrograms() const
+{
+	EnterConditionsProgram.Reset();
+	for (const FDlgEdge& Edge : Children)
+	{
+		Edge.InvalidateConditionProgram();
+	}
+}
+
 bool UDlgNode::ReevaluateChildren(UDlgContext& Context, TSet<const UDlgNode*> AlreadyEvaluated)
 {
+	DLG_TRACE_SCOPE(DlgNode_ReevaluateChildren);
 	TArray<FDlgEdge>& AvailableOptions = Context.GetMutableOptionsArray();
 	TArray<FDlgEdgeData>& AllOptions = Context.GetAllMutableOptionsArray();
 	AvailableOptions.Empty();
 	AllOptions.Empty();
 
+	const TSet<const UDlgNode*> VisitedNodes = GetChildrenEvaluationVisitedNodes();
 	for (const FDlgEdge& Edge : Children)
 	{
-		const bool bSatisfied = Edge.Evaluate(Context, { this });
+		const bool bSatisfied = Edge.Evaluate(Context, VisitedNodes, this);
 
 		if (bSatisfied || Edge.bIncludeInAllOptionListIfUnsatisfied)
 		{
@@ -186,7 +217,7 @@ bool UDlgNode::ReevaluateChildren(UDlgContext& Context, TSet<const UDlgNode*> Al
 		switch (GetDefault<UDlgSystemSettings>()->NoSatisfiedChildBehavior)
 		{
 			case EDlgNoSatisfiedChildBehavior::PrintErrorAndEndDialogue:
-				FDlgLogger::Get().Errorf(
+				DLG_LOG_ERROR_RATE_LIMITED(
 					TEXT("ReevaluateChildren (ReevaluateOptions) - no valid child option for a NODE.\nContext:\n\t%s"),
 					*Context.GetContextString());
 
@@ -206,13 +237,17 @@ bool UDlgNode::ReevaluateChildren(UDlgContext& Context, TSet<const UDlgNode*> Al
 
 bool UDlgNode::CheckNodeEnterConditions(const UDlgContext& Context, TSet<const UDlgNode*> AlreadyVisitedNodes) const
 {
-	if (AlreadyVisitedNodes.Contains(this))
+	// Only the nodes that can be reached again need the guard against endless recursion
+	if (bInEvaluationCycle)
 	{
-		return true;
+		if (AlreadyVisitedNodes.Contains(this))
+		{
+			return true;
+		}
+		AlreadyVisitedNodes.Add(this);
 	}
 
-	AlreadyVisitedNodes.Add(this);
-	if (!FDlgCondition::EvaluateArray(Context, EnterConditions, OwnerTag))
+	if (!FDlgConditionProgram::EvaluateCached(EnterConditionsProgram, Context, EnterConditions, OwnerTag))
 	{
 		return false;
 	}
@@ -254,7 +289,7 @@ bool UDlgNode::HasAnySatisfiedChild(const UDlgContext& Context, TSet<const UDlgN
 	for (const FDlgEdge& Edge : Children)
 	{
 		// Found at least one valid child
-		if (Edge.Evaluate(Context, AlreadyVisitedNodes))
+		if (Edge.Evaluate(Context, AlreadyVisitedNodes, this))
 		{
 			return true;
 		}
@@ -313,11 +348,11 @@ const TArray<int32> UDlgNode::GetNodeOpenChildren_DEPRECATED() const
 
 FDlgEdge* UDlgNode::GetMutableNodeChildForTargetIndex(int32 TargetIndex)
 {
-	for (FDlgEdge& Edge : Children)
+	for (int32 EdgeIndex = 0; EdgeIndex < Children.Num(); EdgeIndex++)
 	{
-		if (Edge.TargetIndex == TargetIndex)
+		if (Children[EdgeIndex].TargetIndex == TargetIndex)
 		{
-			return &Edge;
+			return OnChildrenModified(EdgeIndex);
 		}
 	}
 
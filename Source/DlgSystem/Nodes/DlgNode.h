@@ -18,6 +18,7 @@
 
 class UDlgSystemSettings;
 class UDlgContext;
+struct FDlgConditionProgram;
 class UDlgNode;
 class USoundBase;
 class USoundWave;
@@ -148,12 +149,19 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Dialogue|Node")
 	virtual const TArray<FDlgCondition>& GetNodeEnterConditions() const { return EnterConditions; }
 
-	virtual void SetNodeEnterConditions(const TArray<FDlgCondition>& InEnterConditions) { EnterConditions = InEnterConditions; }
+	EDlgEntryRestriction GetNodeEnterRestriction() const { return EnterRestriction; }
+
+	virtual void SetNodeEnterConditions(const TArray<FDlgCondition>& InEnterConditions)
+	{
+		EnterConditions = InEnterConditions;
+		EnterConditionsProgram.Reset();
+	}
 
 	// Gets the mutable enter condition at location EnterConditionIndex.
 	virtual FDlgCondition* GetMutableEnterConditionAt(int32 EnterConditionIndex)
 	{
 		check(EnterConditions.IsValidIndex(EnterConditionIndex));
+		EnterConditionsProgram.Reset();
 		return &EnterConditions[EnterConditionIndex];
 	}
 
@@ -177,7 +185,12 @@ public:
 
 	UFUNCTION(BlueprintPure, Category = "Dialogue|Node")
 	virtual const TArray<FDlgEdge>& GetNodeChildren() const { return Children; }
-	virtual void SetNodeChildren(const TArray<FDlgEdge>& InChildren) { Children = InChildren; }
+	virtual void SetNodeChildren(const TArray<FDlgEdge>& InChildren)
+	{
+		Children = InChildren;
+		InvalidateConditionPrograms();
+		OnChildrenModified();
+	}
 
 	UFUNCTION(BlueprintPure, Category = "Dialogue|Node")
 	virtual int32 GetNumNodeChildren() const { return Children.Num(); }
@@ -186,29 +199,42 @@ public:
 	virtual const FDlgEdge& GetNodeChildAt(int32 EdgeIndex) const { return Children[EdgeIndex]; }
 
 	// Adds an Edge to the end of the Children Array.
-	virtual void AddNodeChild(const FDlgEdge& InChild) { Children.Add(InChild); }
+	virtual void AddNodeChild(const FDlgEdge& InChild)
+	{
+		Children.Add(InChild);
+		OnChildrenModified();
+	}
 
 	// Removes the Edge at the specified EdgeIndex location.
 	virtual void RemoveChildAt(int32 EdgeIndex)
 	{
 		check(Children.IsValidIndex(EdgeIndex));
 		Children.RemoveAt(EdgeIndex);
+		OnChildrenModified();
 	}
 
 	// Removes all edges/children
-	virtual void RemoveAllChildren() { Children.Empty(); }
+	virtual void RemoveAllChildren()
+	{
+		Children.Empty();
+		OnChildrenModified();
+	}
 
 	// Gets the mutable edge/child at location EdgeIndex.
 	virtual FDlgEdge* GetSafeMutableNodeChildAt(int32 EdgeIndex)
 	{
 		check(Children.IsValidIndex(EdgeIndex));
-		return &Children[EdgeIndex];
+		return OnChildrenModified(EdgeIndex);
 	}
 
 	// Unsafe version, can be null
 	virtual FDlgEdge* GetMutableNodeChildAt(int32 EdgeIndex)
 	{
-		return Children.IsValidIndex(EdgeIndex) ? &Children[EdgeIndex] : nullptr;
+		if (!Children.IsValidIndex(EdgeIndex))
+		{
+			return nullptr;
+		}
+		return OnChildrenModified(EdgeIndex);
 	}
 
 	// Gets the mutable Edge that corresponds to the provided TargetIndex or nullptr if nothing was found.
@@ -249,6 +275,11 @@ public:
 
 	UFUNCTION(BlueprintPure, Category = "Dialogue|Node")
 	virtual bool GetCheckChildrenOnEvaluation() const { return bCheckChildrenOnEvaluation; }
+	virtual void SetCheckChildrenOnEvaluation(bool bValue)
+	{
+		bCheckChildrenOnEvaluation = bValue;
+		bInEvaluationCycle = true;
+	}
 
 	/**
 	 * Gets the Raw unformatted Text of this Node. Usually the same as GetNodeText but in case the node supports formatted string this
@@ -281,6 +312,16 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Dialogue|Node")
 	virtual UDlgNodeData* GetNodeData() const { return nullptr; }
 
+	// Getters for the state of Context (e.g. the text constructed for it, the active entry of a speech sequence),
+	// the getters above use the state of the context that entered this node last. Used by the UDlgContext::GetActiveNode... getters.
+	virtual const FText& GetNodeTextForContext(const UDlgContext& Context) const { return GetNodeText(); }
+	virtual UDlgNodeData* GetNodeDataForContext(const UDlgContext& Context) const { return GetNodeData(); }
+	virtual USoundBase* GetNodeVoiceSoundBaseForContext(const UDlgContext& Context) const { return GetNodeVoiceSoundBase(); }
+	virtual UDialogueWave* GetNodeVoiceDialogueWaveForContext(const UDlgContext& Context) const { return GetNodeVoiceDialogueWave(); }
+	virtual FName GetSpeakerStateForContext(const UDlgContext& Context) const { return GetSpeakerState(); }
+	virtual UObject* GetNodeGenericDataForContext(const UDlgContext& Context) const { return GetNodeGenericData(); }
+	virtual FGameplayTag GetNodeParticipantTagForContext(const UDlgContext& Context) const { return GetNodeParticipantTag(); }
+
 	// Helper method to get directly the Dialogue (which is our parent)
 	UDlgDialogue* GetDialogue() const;
 
@@ -300,6 +341,50 @@ public:
 	// Fires this Node enter Events
 	void FireNodeEnterEvents(UDlgContext& Context);
 
+	// Resets the compiled enter conditions and edge conditions, they are compiled again on the next evaluation
+	void InvalidateConditionPrograms() const;
+
+	// Set by UDlgDialogue::UpdateAndRefreshData, see bInEvaluationCycle
+	bool IsInEvaluationCycle() const { return bInEvaluationCycle; }
+	void SetInEvaluationCycle(bool bValue) { bInEvaluationCycle = bValue; }
+
+#if WITH_EDITOR
+	// Set by UDlgDialogue::FoldConstantConditionsForCook, Serialize writes these to the cooked package instead of EnterConditions and Children
+	void SetCookedData(TArray<FDlgCondition>&& InEnterConditions, TArray<FDlgEdge>&& InChildren)
+	{
+		CookedEnterConditions = MoveTemp(InEnterConditions);
+		CookedChildren = MoveTemp(InChildren);
+		bHasCookedData = true;
+	}
+
+	void ResetCookedData()
+	{
+		CookedEnterConditions.Empty();
+		CookedChildren.Empty();
+		bHasCookedData = false;
+	}
+
+	bool HasCookedData() const { return bHasCookedData; }
+
+	// Swaps the cooked data with EnterConditions and Children, Serialize does this around saving the cooked package
+	void SwapCookedData()
+	{
+		Swap(EnterConditions, CookedEnterConditions);
+		Swap(Children, CookedChildren);
+	}
+#endif // WITH_EDITOR
+
+	// The visited nodes the evaluation of the children starts with, empty if the evaluation can not reach this node again
+	TSet<const UDlgNode*> GetChildrenEvaluationVisitedNodes() const
+	{
+		TSet<const UDlgNode*> VisitedNodes;
+		if (bInEvaluationCycle)
+		{
+			VisitedNodes.Add(this);
+		}
+		return VisitedNodes;
+	}
+
 protected:
 #if WITH_EDITORONLY_DATA
 	// Node's Graph representation, used to get position.
@@ -346,4 +431,35 @@ protected:
 	// Edges that point to Children of this Node
 	UPROPERTY(VisibleAnywhere, EditFixedSize, AdvancedDisplay, Category = "Dialogue|Node")
 	TArray<FDlgEdge> Children;
+
+	// EnterConditions compiled on the first CheckNodeEnterConditions, see FDlgConditionProgram
+	mutable TSharedPtr<const FDlgConditionProgram> EnterConditionsProgram;
+
+	// False if the recursive evaluation (CheckNodeEnterConditions, HasAnySatisfiedChild) started from this node or from its children
+	// can never reach this node again, then it is not tracked in the visited nodes. True until the dialogue analyzed its nodes.
+	bool bInEvaluationCycle = true;
+
+#if WITH_EDITOR
+	// See SetCookedData, the authored data is never modified
+	TArray<FDlgCondition> CookedEnterConditions;
+	TArray<FDlgEdge> CookedChildren;
+	bool bHasCookedData = false;
+#endif // WITH_EDITOR
+
+private:
+	// Called by every function that modifies the children or gives mutable access to the child at EdgeIndex (if valid).
+	// The evaluation cycles are not known anymore and the edge has to be compiled again.
+	FDlgEdge* OnChildrenModified(int32 EdgeIndex = INDEX_NONE)
+	{
+		bInEvaluationCycle = true;
+		if (!Children.IsValidIndex(EdgeIndex))
+		{
+			return nullptr;
+		}
+
+		FDlgEdge& Edge = Children[EdgeIndex];
+		Edge.InvalidateConditionProgram();
+		Edge.bAlwaysSatisfied = false;
+		return &Edge;
+	}
 };
@@ -21,7 +21,31 @@ bool UDlgNode_Proxy::HandleNodeEnter(UDlgContext& Context, TSet<const UDlgNode*>
 	}
 	NodesEnteredWithThisStep.Add(this);
 
-	return Context.EnterNode(NodeIndex, NodesEnteredWithThisStep);
+	if (!IsResolvedProxyChainCurrent(Context))
+	{
+		return Context.EnterNode(NodeIndex, NodesEnteredWithThisStep);
+	}
+
+	// Step through the rest of the chain without entering the proxies one by one, the result is the same
+	for (const int32 ProxyIndex : ResolvedProxyChain)
+	{
+		UDlgNode* Proxy = Context.GetMutableNodeFromIndex(ProxyIndex);
+		check(Proxy);
+		Context.PassThroughNode(ProxyIndex, *Proxy);
+		Proxy->FireNodeEnterEvents(Context);
+
+		if (NodesEnteredWithThisStep.Contains(Proxy))
+		{
+			FDlgLogger::Get().Errorf(
+				TEXT("ProxyNode::HandleNodeEnter - Failed to enter proxy node, it was entered multiple times in a single step. Dialogue is terminated.\nContext:\n\t%s"),
+				*Context.GetContextString()
+			);
+			return false;
+		}
+		NodesEnteredWithThisStep.Add(Proxy);
+	}
+
+	return Context.EnterNode(ResolvedNodeIndex, NodesEnteredWithThisStep);
 }
 
 bool UDlgNode_Proxy::CheckNodeEnterConditions(const UDlgContext& Context, TSet<const UDlgNode*> AlreadyVisitedNodes) const
@@ -31,15 +55,57 @@ bool UDlgNode_Proxy::CheckNodeEnterConditions(const UDlgContext& Context, TSet<c
 		return false;
 	}
 
-	const UDlgNode* Node = Context.GetNodeFromIndex(NodeIndex);
+	if (!IsResolvedProxyChainCurrent(Context))
+	{
+		const UDlgNode* Node = Context.GetNodeFromIndex(NodeIndex);
+		check(Node);
+		return Node->CheckNodeEnterConditions(Context, AlreadyVisitedNodes);
+	}
+
+	// Same as the recursion through the chain: the own conditions of every proxy, then the final node
+	for (const int32 ProxyIndex : ResolvedProxyChain)
+	{
+		const UDlgNode* Proxy = Context.GetNodeFromIndex(ProxyIndex);
+		check(Proxy);
+		if (!Proxy->UDlgNode::CheckNodeEnterConditions(Context, AlreadyVisitedNodes))
+		{
+			return false;
+		}
+	}
+
+	const UDlgNode* Node = Context.GetNodeFromIndex(ResolvedNodeIndex);
 	check(Node);
 	return Node->CheckNodeEnterConditions(Context, AlreadyVisitedNodes);
 }
 
+bool UDlgNode_Proxy::IsResolvedProxyChainCurrent(const UDlgContext& Context) const
+{
+	if (!HasResolvedProxyChain() || ResolvedFromNodeIndex != NodeIndex)
+	{
+		return false;
+	}
+
+	int32 TargetIndex = NodeIndex;
+	for (const int32 ProxyIndex : ResolvedProxyChain)
+	{
+		const UDlgNode_Proxy* Proxy = Cast<UDlgNode_Proxy>(Context.GetNodeFromIndex(ProxyIndex));
+		if (ProxyIndex != TargetIndex || Proxy == nullptr)
+		{
+			return false;
+		}
+		TargetIndex = Proxy->GetTargetNodeIndex();
+	}
+	return TargetIndex == ResolvedNodeIndex;
+}
+
 void UDlgNode_Proxy::RemapOldIndicesWithNew(const TMap<int32, int32>& OldToNewIndexMap)
 {
 	if (const int32* NewIndexPtr = OldToNewIndexMap.Find(NodeIndex))
 	{
 		NodeIndex = *NewIndexPtr;
 	}
+
+	// Resolved again by UDlgDialogue::UpdateAndRefreshData
+	ResetResolvedProxyChain();
+	bInEvaluationCycle = true;
 }
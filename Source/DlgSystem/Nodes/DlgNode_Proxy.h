@@ -45,6 +45,40 @@ public:
 
 	// return with the index of the target in the UDlgDialogue::Nodes array
 	int32 GetTargetNodeIndex() const { return NodeIndex; }
+	void SetTargetNodeIndex(int32 InNodeIndex)
+	{
+		NodeIndex = InNodeIndex;
+		ResetResolvedProxyChain();
+		bInEvaluationCycle = true;
+	}
+
+	/**
+	 * Called by UDlgDialogue::UpdateAndRefreshData.
+	 * @param InProxyChain			the proxies between this proxy and the final node, in order
+	 * @param InResolvedNodeIndex	the first node reached from this proxy that is not a proxy
+	 */
+	void SetResolvedProxyChain(TArray<int32>&& InProxyChain, int32 InResolvedNodeIndex)
+	{
+		ResolvedProxyChain = MoveTemp(InProxyChain);
+		ResolvedNodeIndex = InResolvedNodeIndex;
+		ResolvedFromNodeIndex = NodeIndex;
+	}
+
+	// Not resolved (cycle of proxies, invalid target or the target changed), each proxy is entered one by one
+	void ResetResolvedProxyChain()
+	{
+		ResolvedProxyChain.Empty();
+		ResolvedNodeIndex = INDEX_NONE;
+		ResolvedFromNodeIndex = INDEX_NONE;
+	}
+
+	bool HasResolvedProxyChain() const { return ResolvedNodeIndex != INDEX_NONE; }
+
+	// NodeIndex can be written without SetTargetNodeIndex (Blueprints, the details panel), the chain is only used
+	// while this proxy and every proxy in the chain still point to the nodes the chain was resolved from
+	bool IsResolvedProxyChainCurrent(const UDlgContext& Context) const;
+	const TArray<int32>& GetResolvedProxyChain() const { return ResolvedProxyChain; }
+	int32 GetResolvedNodeIndex() const { return ResolvedNodeIndex; }
 
 
 	// Helper functions to get the names of some properties. Used by the DlgSystemEditor module.
@@ -55,4 +89,13 @@ protected:
 	// Index of the node the Proxy represents (in UDlgDialogue::Nodes)
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dialogue")
 	int32 NodeIndex = 0;
+
+	// Proxies between this one and ResolvedNodeIndex, their conditions are checked and their enter events are fired in this order
+	TArray<int32> ResolvedProxyChain;
+
+	// Final node of the proxy chain starting with this proxy, INDEX_NONE if it is not resolved
+	int32 ResolvedNodeIndex = INDEX_NONE;
+
+	// NodeIndex when the chain was resolved
+	int32 ResolvedFromNodeIndex = INDEX_NONE;
 };
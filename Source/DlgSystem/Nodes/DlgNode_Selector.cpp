@@ -59,10 +59,11 @@ bool UDlgNode_Selector::HandleNodeEnter(UDlgContext& Context, TSet<const UDlgNod
 	{
 		case EDlgNodeSelectorType::First:
 		{
-			// Find first child with satisfies conditions
+			// Find first child with satisfies conditions, the children after it are not evaluated
+			const TSet<const UDlgNode*> VisitedNodes = GetChildrenEvaluationVisitedNodes();
 			for (const FDlgEdge& Edge : Children)
 			{
-				if (Edge.Evaluate(Context, { this }))
+				if (Edge.Evaluate(Context, VisitedNodes, this))
 				{
 					return Context.EnterNode(Edge.TargetIndex, NodesEnteredWithThisStep);
 				}
@@ -72,12 +73,15 @@ bool UDlgNode_Selector::HandleNodeEnter(UDlgContext& Context, TSet<const UDlgNod
 
 		case EDlgNodeSelectorType::Random:
 		{
-			// Select Random
-			const int32 ChildNodeIndex = GetRandomChildNodeIndex(Context);
+			// Evaluated once per enter, every pick of the random cycle reads from the same result
+			TBitArray<> SatisfiedChildren;
+			EvaluateChildren(Context, SatisfiedChildren);
+			const int32 ChildNodeIndex = GetRandomChildNodeIndex(Context, SatisfiedChildren);
 			if (ChildNodeIndex != INDEX_NONE)
 			{
 				return Context.EnterNode(ChildNodeIndex, NodesEnteredWithThisStep);
 			}
+			break;
 		}
 
 		default:
@@ -91,74 +95,143 @@ bool UDlgNode_Selector::HandleNodeEnter(UDlgContext& Context, TSet<const UDlgNod
 	return false;
 }
 
-int32 UDlgNode_Selector::GetRandomChildNodeIndex(UDlgContext& Context)
+void UDlgNode_Selector::EvaluateChildren(const UDlgContext& Context, TBitArray<>& OutSatisfiedChildren) const
 {
-	FDlgNodeSavedData& SavedData = Context.GetNodeSavedData(NodeGUID);
-
-	// The list of all valid children (ones with satisfied condition)
-	TArray<int32> Candidates;
-
-	// List of possible candidates if we want to avoid repetition based on the booleans
-	TArray<int32> CandidatesLimited;
-
+	OutSatisfiedChildren.Init(false, Children.Num());
+	const TSet<const UDlgNode*> VisitedNodes = GetChildrenEvaluationVisitedNodes();
 	for (int32 EdgeIndex = 0; EdgeIndex < Children.Num(); ++EdgeIndex)
 	{
-		if (Children[EdgeIndex].Evaluate(Context, { this }))
+		if (Children[EdgeIndex].Evaluate(Context, VisitedNodes, this))
 		{
-			Candidates.Add(EdgeIndex);
-
-			const FGuid ChildNodeGUID = Context.GetNodeGUIDForIndex(Children[EdgeIndex].TargetIndex);
-			if (!SavedData.GUIDList.Contains(ChildNodeGUID))
-			{
-				CandidatesLimited.Add(EdgeIndex);
-			}
+			OutSatisfiedChildren[EdgeIndex] = true;
 		}
 	}
+}
 
+int32 UDlgNode_Selector::GetRandomChildNodeIndex(UDlgContext& Context, const TBitArray<>& SatisfiedChildren)
+{
 	// No candidates :(
-	if (Candidates.Num() == 0)
+	const int32 NumCandidates = SatisfiedChildren.CountSetBits();
+	if (NumCandidates == 0)
 	{
 		return INDEX_NONE;
 	}
 
+	FDlgNodeSavedData& SavedData = Context.GetNodeSavedData(NodeGUID);
+	UpdateSavedDataToChildren(Context, SavedData);
+
+	int32 SelectedEdgeIndex = PickRandomUnusedChild(Context, SavedData, SatisfiedChildren);
+
 	// Option cycle is over or something is wrong with the setup
-	if (CandidatesLimited.Num() == 0)
+	if (SelectedEdgeIndex == INDEX_NONE)
 	{
 		// Only allow to preserve last option in list if it is needed and we are sure that
 		// a valid option can be picked even if it stays there
-		const bool bTempBlockLast = bAvoidPickingSameOptionTwiceInARow && Candidates.Num() > 1;
-		if (bTempBlockLast)
+		const bool bTempBlockLast = bAvoidPickingSameOptionTwiceInARow && NumCandidates > 1 && SavedData.LastUsedEdgeIndex != INDEX_NONE;
+		const int32 TempBlockedEdgeIndex = bTempBlockLast ? SavedData.LastUsedEdgeIndex : INDEX_NONE;
+		SavedData.ResetUsedEdges();
+		if (TempBlockedEdgeIndex != INDEX_NONE)
 		{
-			const FGuid TempBlockedEntry = SavedData.GUIDList.Last();
-			SavedData.GUIDList.Empty();
-			SavedData.GUIDList.Add(TempBlockedEntry);
-			const int32 RandomChildNodeIndex = GetRandomChildNodeIndex(Context);
-			SavedData.GUIDList.Remove(TempBlockedEntry);
-			return RandomChildNodeIndex;
+			SetChildUsed(SavedData, TempBlockedEdgeIndex, true);
+			SelectedEdgeIndex = PickRandomUnusedChild(Context, SavedData, SatisfiedChildren);
+			SetChildUsed(SavedData, TempBlockedEdgeIndex, false);
 		}
-		else
+
+		// Every satisfied child leads to the blocked node
+		if (SelectedEdgeIndex == INDEX_NONE)
 		{
-			SavedData.GUIDList.Empty();
-			return GetRandomChildNodeIndex(Context);
+			SelectedEdgeIndex = PickRandomUnusedChild(Context, SavedData, SatisfiedChildren);
 		}
 	}
-
-	// Select Random
-	const int32 SelectedIndex = FMath::RandHelper(CandidatesLimited.Num());
-	const int32 TargetNodeIndex = Children[CandidatesLimited[SelectedIndex]].TargetIndex;
-	const FGuid TargetNodeGUID = Context.GetNodeGUIDForIndex(TargetNodeIndex);
+	check(SelectedEdgeIndex != INDEX_NONE);
 
 	// if we cycle through everything the list of picked nodes is needed
 	if (bCycleThroughSatisfiedOptionsWithoutRepetition)
 	{
 		// add the currently picked node to the disallow list, it will be cleared on selection if all valid options are added
-		SavedData.GUIDList.Add(TargetNodeGUID);
+		SetChildUsed(SavedData, SelectedEdgeIndex, true);
+		SavedData.LastUsedEdgeIndex = SelectedEdgeIndex;
 	}
 	else if (bAvoidPickingSameOptionTwiceInARow)
 	{
 		// only disallow the currently picked node for the next selection
-		SavedData.GUIDList = { TargetNodeGUID };
+		SavedData.ResetUsedEdges();
+		SetChildUsed(SavedData, SelectedEdgeIndex, true);
+		SavedData.LastUsedEdgeIndex = SelectedEdgeIndex;
+	}
+
+	return Children[SelectedEdgeIndex].TargetIndex;
+}
+
+int32 UDlgNode_Selector::PickRandomUnusedChild(UDlgContext& Context, const FDlgNodeSavedData& SavedData, const TBitArray<>& SatisfiedChildren) const
+{
+	// Reservoir sampling, the k-th candidate replaces the selected one with 1/k chance
+	FRandomStream& RandomStream = Context.GetRandomStream();
+	int32 NumCandidatesLimited = 0;
+	int32 SelectedEdgeIndex = INDEX_NONE;
+	for (TConstSetBitIterator<> It(SatisfiedChildren); It; ++It)
+	{
+		const int32 EdgeIndex = It.GetIndex();
+		if (!SavedData.IsEdgeUsed(EdgeIndex))
+		{
+			NumCandidatesLimited++;
+			if (RandomStream.RandHelper(NumCandidatesLimited) == 0)
+			{
+				SelectedEdgeIndex = EdgeIndex;
+			}
+		}
+	}
+	return SelectedEdgeIndex;
+}
+
+void UDlgNode_Selector::SetChildUsed(FDlgNodeSavedData& SavedData, int32 EdgeIndex, bool bUsed) const
+{
+	// The same node is only picked once per cycle even if more edges lead to it
+	const int32 TargetIndex = Children[EdgeIndex].TargetIndex;
+	for (int32 Index = 0; Index < Children.Num(); ++Index)
+	{
+		if (Children[Index].TargetIndex == TargetIndex)
+		{
+			SavedData.SetEdgeUsed(Index, bUsed);
+		}
+	}
+}
+
+void UDlgNode_Selector::UpdateSavedDataToChildren(const UDlgContext& Context, FDlgNodeSavedData& SavedData) const
+{
+	const int32 EdgesSignature = GetEdgesSignature(Context);
+	if (SavedData.GUIDList.Num() > 0)
+	{
+		SavedData.ResetUsedEdges();
+		for (int32 EdgeIndex = 0; EdgeIndex < Children.Num(); ++EdgeIndex)
+		{
+			const FGuid ChildNodeGUID = Context.GetNodeGUIDForIndex(Children[EdgeIndex].TargetIndex);
+			if (SavedData.GUIDList.Contains(ChildNodeGUID))
+			{
+				SavedData.SetEdgeUsed(EdgeIndex, true);
+				if (ChildNodeGUID == SavedData.GUIDList.Last())
+				{
+					SavedData.LastUsedEdgeIndex = EdgeIndex;
+				}
+			}
+		}
+		SavedData.GUIDList.Empty();
+		SavedData.EdgesSignature = EdgesSignature;
 	}
 
-	return TargetNodeIndex;
+	if (SavedData.EdgesSignature != EdgesSignature)
+	{
+		SavedData.ResetUsedEdges();
+		SavedData.EdgesSignature = EdgesSignature;
+	}
+}
+
+int32 UDlgNode_Selector::GetEdgesSignature(const UDlgContext& Context) const
+{
+	uint32 Signature = GetTypeHash(Children.Num());
+	for (const FDlgEdge& Edge : Children)
+	{
+		Signature = HashCombine(Signature, GetTypeHash(Context.GetNodeGUIDForIndex(Edge.TargetIndex)));
+	}
+	return static_cast<int32>(Signature);
 }
@@ -6,6 +6,7 @@
 
 #include "DlgNode_Selector.generated.h"
 
+struct FDlgNodeSavedData;
 
 UENUM(BlueprintType)
 enum class EDlgNodeSelectorType : uint8
@@ -66,6 +67,9 @@ public:
 	// Sets the Selector Type
 	void SetSelectorType(EDlgNodeSelectorType InType) { SelectorType = InType; }
 
+	void SetAvoidPickingSameOptionTwiceInARow(bool bValue) { bAvoidPickingSameOptionTwiceInARow = bValue; }
+	void SetCycleThroughSatisfiedOptionsWithoutRepetition(bool bValue) { bCycleThroughSatisfiedOptionsWithoutRepetition = bValue; }
+
 	// Helper functions to get the names of some properties. Used by the DlgSystemEditor module.
 	static FName GetMemberNameSelectorType() { return GET_MEMBER_NAME_CHECKED(UDlgNode_Selector, SelectorType); }
 	static FName GetMemberNameAvoidPickingSameOptionTwiceInARow() { return GET_MEMBER_NAME_CHECKED(UDlgNode_Selector, bAvoidPickingSameOptionTwiceInARow); }
@@ -73,7 +77,22 @@ public:
 
 protected:
 
-	int32 GetRandomChildNodeIndex(UDlgContext& Context);
+	// Evaluates every child once, bit EdgeIndex is set if the child is satisfied
+	void EvaluateChildren(const UDlgContext& Context, TBitArray<>& OutSatisfiedChildren) const;
+
+	int32 GetRandomChildNodeIndex(UDlgContext& Context, const TBitArray<>& SatisfiedChildren);
+
+	// Picks uniformly among the satisfied children not used yet, INDEX_NONE if there is none
+	int32 PickRandomUnusedChild(UDlgContext& Context, const FDlgNodeSavedData& SavedData, const TBitArray<>& SatisfiedChildren) const;
+
+	// Marks the child edge and every other child edge leading to the same node as (un)used
+	void SetChildUsed(FDlgNodeSavedData& SavedData, int32 EdgeIndex, bool bUsed) const;
+
+	// Converts the GUIDList of old saves to the used edge bits, resets the bits if the children changed since they were written
+	void UpdateSavedDataToChildren(const UDlgContext& Context, FDlgNodeSavedData& SavedData) const;
+
+	// See FDlgNodeSavedData::EdgesSignature
+	int32 GetEdgesSignature(const UDlgContext& Context) const;
 
 protected:
 	// Defines the type of selector this node represents
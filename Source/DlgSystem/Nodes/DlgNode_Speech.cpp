@@ -6,6 +6,7 @@
 #include "DlgSystem/DlgHelper.h"
 #include "DlgSystem/Logging/DlgLogger.h"
 #include "DlgSystem/DlgLocalizationHelper.h"
+#include "DlgSystem/DlgStats.h"
 
 
 void UDlgNode_Speech::OnCreatedInEditor()
@@ -50,11 +51,13 @@ void UDlgNode_Speech::UpdateTextsNamespacesAndKeys(const UDlgSystemSettings& Set
 
 void UDlgNode_Speech::RebuildConstructedText(const UDlgContext& Context)
 {
+	DLG_SCOPE_CYCLE_COUNTER(RebuildText);
 	if (TextArguments.Num() <= 0)
 	{
 		return;
 	}
 
+	DLG_INC_COUNTER(TextsFormatted);
 	FFormatNamedArguments OrderedArguments;
 	for (const FDlgTextArgument& DlgArgument : TextArguments)
 	{
@@ -63,9 +66,19 @@ void UDlgNode_Speech::RebuildConstructedText(const UDlgContext& Context)
 	ConstructedText = FText::AsCultureInvariant(FText::Format(Text, OrderedArguments));
 }
 
+const FText& UDlgNode_Speech::GetNodeTextForContext(const UDlgContext& Context) const
+{
+	const FText* ContextText = Context.GetActiveNode() == this ? Context.GetActiveNodeConstructedText() : nullptr;
+	return ContextText != nullptr && !ContextText->IsEmpty() ? *ContextText : Text;
+}
+
 bool UDlgNode_Speech::HandleNodeEnter(UDlgContext& Context, TSet<const UDlgNode*> NodesEnteredWithThisStep)
 {
 	RebuildConstructedText(Context);
+	if (TextArguments.Num() > 0)
+	{
+		Context.SetActiveNodeConstructedTexts({ ConstructedText });
+	}
 	const bool bResult = Super::HandleNodeEnter(Context, NodesEnteredWithThisStep);
 
 	// Handle virtual parent enter events for direct children
@@ -111,10 +124,11 @@ bool UDlgNode_Speech::ReevaluateChildren(UDlgContext& Context, TSet<const UDlgNo
 
 		AlreadyEvaluated.Add(this);
 
+		const TSet<const UDlgNode*> VisitedNodes = GetChildrenEvaluationVisitedNodes();
 		for (const FDlgEdge& Edge : Children)
 		{
 			// Find first satisfied child
-			if (Edge.Evaluate(Context, { this }))
+			if (Edge.Evaluate(Context, VisitedNodes, this))
 			{
 				if (UDlgNode* Node = Context.GetMutableNodeFromIndex(Edge.TargetIndex))
 				{
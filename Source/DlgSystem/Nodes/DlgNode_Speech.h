@@ -71,6 +71,7 @@ public:
 		return Text;
 	}
 	const FText& GetNodeUnformattedText() const override { return Text; }
+	const FText& GetNodeTextForContext(const UDlgContext& Context) const override;
 	UDlgNodeData* GetNodeData() const override { return NodeData; }
 
 	// stuff we have to keep for legacy reason (but would make more sense to remove them from the plugin as they could be created in NodeData):
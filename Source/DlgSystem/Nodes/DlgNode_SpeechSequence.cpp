@@ -4,6 +4,7 @@
 #include "DlgSystem/DlgContext.h"
 #include "DlgSystem/DlgLocalizationHelper.h"
 #include "DlgSystem/DlgHelper.h"
+#include "DlgSystem/DlgStats.h"
 
 
 #if WITH_EDITOR
@@ -87,10 +88,18 @@ void UDlgNode_SpeechSequence::UpdateTextsNamespacesAndKeys(const UDlgSystemSetti
 
 bool UDlgNode_SpeechSequence::HandleNodeEnter(UDlgContext& Context, TSet<const UDlgNode*> NodesEnteredWithThisStep)
 {
-	ActualIndex = 0;
+	SetActualIndex(Context, 0);
 
 	RebuildConstructedText(Context);
 
+	TArray<FText> ContextTexts;
+	ContextTexts.Reserve(SpeechSequence.Num());
+	for (const FDlgSpeechSequenceEntry& Entry : SpeechSequence)
+	{
+		ContextTexts.Add(Entry.GetNodeText());
+	}
+	Context.SetActiveNodeConstructedTexts(MoveTemp(ContextTexts));
+
 	return Super::HandleNodeEnter(Context, NodesEnteredWithThisStep);
 }
 
@@ -102,14 +111,15 @@ bool UDlgNode_SpeechSequence::ReevaluateChildren(UDlgContext& Context, TSet<cons
 	AllOptions.Empty();
 
 	// If the last entry is active the real edges are used
-	if (ActualIndex == SpeechSequence.Num() - 1)
+	const int32 ContextIndex = Context.GetActiveSpeechSequenceIndex();
+	if (ContextIndex == SpeechSequence.Num() - 1)
 		return Super::ReevaluateChildren(Context, AlreadyEvaluated);
 
 	// give the context the fake inner edge
-	if (InnerEdges.IsValidIndex(ActualIndex))
+	if (InnerEdges.IsValidIndex(ContextIndex))
 	{
-		Options.Add(InnerEdges[ActualIndex]);
-		AllOptions.Add(FDlgEdgeData{ true, InnerEdges[ActualIndex] });
+		Options.Add(InnerEdges[ContextIndex]);
+		AllOptions.Add(FDlgEdgeData{ true, InnerEdges[ContextIndex] });
 		return true;
 	}
 
@@ -119,14 +129,15 @@ bool UDlgNode_SpeechSequence::ReevaluateChildren(UDlgContext& Context, TSet<cons
 bool UDlgNode_SpeechSequence::OptionSelected(int32 OptionIndex, bool bFromAll, UDlgContext& Context)
 {
 	// Actual index is valid, and not the last node in the speech sequence, increment
-	if (ActualIndex >= 0 && ActualIndex < SpeechSequence.Num() - 1)
+	const int32 ContextIndex = Context.GetActiveSpeechSequenceIndex();
+	if (ContextIndex >= 0 && ContextIndex < SpeechSequence.Num() - 1)
 	{
-		ActualIndex += 1;
+		SetActualIndex(Context, ContextIndex + 1);
 		return ReevaluateChildren(Context, {this});
 	}
 
 	// node finished -> generate true children
-	ActualIndex = 0;
+	SetActualIndex(Context, 0);
 	Super::ReevaluateChildren(Context, { this });
 	return Super::OptionSelected(OptionIndex, bFromAll, Context);
 }
@@ -135,7 +146,7 @@ void UDlgNode_SpeechSequence::RebuildConstructedText(const UDlgContext& Context)
 {
 	for (FDlgSpeechSequenceEntry& entry : SpeechSequence)
 	{
-		entry.RebuildConstructedText(Context, GetNodeParticipantTag());
+		entry.RebuildConstructedText(Context, GetNodeParticipantTagForContext(Context));
 	}	
 }
 
@@ -156,16 +167,22 @@ bool UDlgNode_SpeechSequence::OptionSelectedFromReplicated(int32 OptionIndex, bo
 	// Is the new option index valid? set that for the actual index
 	if (SpeechSequence.IsValidIndex(OptionIndex))
 	{
-		ActualIndex = OptionIndex;
+		SetActualIndex(Context, OptionIndex);
 		return ReevaluateChildren(Context, { this });
 	}
 
 	// node finished -> generate true children
-	ActualIndex = 0;
+	SetActualIndex(Context, 0);
 	Super::ReevaluateChildren(Context, { this });
 	return Super::OptionSelected(OptionIndex, bFromAll, Context);
 }
 
+void UDlgNode_SpeechSequence::SetActualIndex(UDlgContext& Context, int32 NewIndex)
+{
+	ActualIndex = NewIndex;
+	Context.SetActiveSpeechSequenceIndex(NewIndex);
+}
+
 const FText& UDlgNode_SpeechSequence::GetNodeText() const
 {
 	if (SpeechSequence.IsValidIndex(ActualIndex))
@@ -226,6 +243,60 @@ FName UDlgNode_SpeechSequence::GetSpeakerState() const
 	return NAME_None;
 }
 
+const FDlgSpeechSequenceEntry* UDlgNode_SpeechSequence::GetContextEntry(const UDlgContext& Context) const
+{
+	const int32 ContextIndex = Context.GetActiveNode() == this ? Context.GetActiveSpeechSequenceIndex() : INDEX_NONE;
+	return SpeechSequence.IsValidIndex(ContextIndex) ? &SpeechSequence[ContextIndex] : nullptr;
+}
+
+const FText& UDlgNode_SpeechSequence::GetNodeTextForContext(const UDlgContext& Context) const
+{
+	const FDlgSpeechSequenceEntry* Entry = GetContextEntry(Context);
+	if (Entry == nullptr)
+	{
+		return FText::GetEmpty();
+	}
+
+	const FText* ContextText = Context.GetActiveNodeConstructedText(Context.GetActiveSpeechSequenceIndex());
+	return ContextText != nullptr && !ContextText->IsEmpty() ? *ContextText : Entry->GetNodeUnformattedText();
+}
+
+UDlgNodeData* UDlgNode_SpeechSequence::GetNodeDataForContext(const UDlgContext& Context) const
+{
+	const FDlgSpeechSequenceEntry* Entry = GetContextEntry(Context);
+	return Entry != nullptr ? Entry->NodeData : nullptr;
+}
+
+USoundBase* UDlgNode_SpeechSequence::GetNodeVoiceSoundBaseForContext(const UDlgContext& Context) const
+{
+	const FDlgSpeechSequenceEntry* Entry = GetContextEntry(Context);
+	return Entry != nullptr ? Entry->VoiceSoundWave : nullptr;
+}
+
+UDialogueWave* UDlgNode_SpeechSequence::GetNodeVoiceDialogueWaveForContext(const UDlgContext& Context) const
+{
+	const FDlgSpeechSequenceEntry* Entry = GetContextEntry(Context);
+	return Entry != nullptr ? Entry->VoiceDialogueWave : nullptr;
+}
+
+FName UDlgNode_SpeechSequence::GetSpeakerStateForContext(const UDlgContext& Context) const
+{
+	const FDlgSpeechSequenceEntry* Entry = GetContextEntry(Context);
+	return Entry != nullptr ? Entry->SpeakerState : NAME_None;
+}
+
+UObject* UDlgNode_SpeechSequence::GetNodeGenericDataForContext(const UDlgContext& Context) const
+{
+	const FDlgSpeechSequenceEntry* Entry = GetContextEntry(Context);
+	return Entry != nullptr ? Entry->GenericData : nullptr;
+}
+
+FGameplayTag UDlgNode_SpeechSequence::GetNodeParticipantTagForContext(const UDlgContext& Context) const
+{
+	const FDlgSpeechSequenceEntry* Entry = GetContextEntry(Context);
+	return Entry != nullptr ? Entry->SpeakerTag : OwnerTag;
+}
+
 void UDlgNode_SpeechSequence::AddAllSpeakerStatesIntoSet(TSet<FName>& OutStates) const
 {
 	for (const auto& SpeechEntry : SpeechSequence)
@@ -287,11 +358,13 @@ const FText& FDlgSpeechSequenceEntry::GetNodeText() const
 
 void FDlgSpeechSequenceEntry::RebuildConstructedText(const UDlgContext& Context, const FGameplayTag& OwnerTag)
 {
+	DLG_SCOPE_CYCLE_COUNTER(RebuildText);
 	if (TextArguments.Num() <= 0)
 	{
 		return;
 	}
 
+	DLG_INC_COUNTER(TextsFormatted);
 	FFormatNamedArguments OrderedArguments;
 	for (const FDlgTextArgument& DlgArgument : TextArguments)
 	{
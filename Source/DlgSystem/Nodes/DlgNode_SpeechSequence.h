@@ -127,6 +127,15 @@ public:
 	FGameplayTag GetNodeParticipantTag() const override;
 	void GetAssociatedParticipants(TArray<FGameplayTag>& OutArray) const override;
 
+	// Context getters, they use the active entry of the context (UDlgContext::GetActiveSpeechSequenceIndex)
+	const FText& GetNodeTextForContext(const UDlgContext& Context) const override;
+	UDlgNodeData* GetNodeDataForContext(const UDlgContext& Context) const override;
+	USoundBase* GetNodeVoiceSoundBaseForContext(const UDlgContext& Context) const override;
+	UDialogueWave* GetNodeVoiceDialogueWaveForContext(const UDlgContext& Context) const override;
+	FName GetSpeakerStateForContext(const UDlgContext& Context) const override;
+	UObject* GetNodeGenericDataForContext(const UDlgContext& Context) const override;
+	FGameplayTag GetNodeParticipantTagForContext(const UDlgContext& Context) const override;
+
 #if WITH_EDITOR
 	FString GetNodeTypeString() const override { return TEXT("Speech Sequence"); }
 
@@ -161,6 +170,13 @@ public:
 	// Helper functions to get the names of some properties. Used by the DlgSystemEditor module.
 	static FName GetMemberNameSpeechSequence() { return GET_MEMBER_NAME_CHECKED(UDlgNode_SpeechSequence, SpeechSequence); }
 
+protected:
+	// Sets the active index of the Context and the ActualIndex
+	void SetActualIndex(UDlgContext& Context, int32 NewIndex);
+
+	// The active entry of Context, nullptr if this is not the active node of Context
+	const FDlgSpeechSequenceEntry* GetContextEntry(const UDlgContext& Context) const;
+
 protected:
 	// Array of important stuff to say
 	UPROPERTY(EditAnywhere, Category = "Dialogue|Node")
@@ -170,7 +186,8 @@ protected:
 	UPROPERTY()
 	TArray<FDlgEdge> InnerEdges;
 
-	// The current active index in the SpeechSequence array
+	// The active index in the SpeechSequence array of the context that stepped this node last,
+	// used by the getters without a context. The flow only uses UDlgContext::GetActiveSpeechSequenceIndex
 	int32 ActualIndex = INDEX_NONE;
 
 private:
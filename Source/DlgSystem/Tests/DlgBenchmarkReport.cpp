@@ -0,0 +1,97 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#include "DlgBenchmarkReport.h"
+
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonWriter.h"
+#include "Serialization/JsonSerializer.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/CommandLine.h"
+#include "Misc/DateTime.h"
+#include "Misc/EngineVersion.h"
+#include "HAL/PlatformMisc.h"
+
+DEFINE_LOG_CATEGORY(LogDlgBenchmark);
+
+const FDlgBenchmarkResult& FDlgBenchmarkReport::AddResult(const FString& Name, int64 Iterations, double TotalSeconds)
+{
+	FDlgBenchmarkResult& Result = Results.AddDefaulted_GetRef();
+	Result.Name = Name;
+	Result.Iterations = Iterations;
+	Result.TotalSeconds = TotalSeconds;
+
+	UE_LOG(LogDlgBenchmark, Display, TEXT("%s.%s: %.1f ns/op (%lld iterations in %.3f ms)"),
+		*SuiteName, *Name, Result.GetNanosecondsPerOperation(), Iterations, TotalSeconds * 1000.0);
+	return Result;
+}
+
+FString FDlgBenchmarkReport::GetOutputDirectory()
+{
+	FString Directory;
+	if (FParse::Value(FCommandLine::Get(), TEXT("DlgBenchmarkDir="), Directory))
+	{
+		return Directory;
+	}
+
+	return FPaths::ProjectSavedDir() / TEXT("DlgSystem") / TEXT("Benchmarks");
+}
+
+bool FDlgBenchmarkReport::Save() const
+{
+	auto SaveFile = [](const FString& FilePath, const FString& Content) -> bool
+	{
+		if (!FFileHelper::SaveStringToFile(Content, *FilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+		{
+			UE_LOG(LogDlgBenchmark, Error, TEXT("Could not write benchmark results to %s"), *FilePath);
+			return false;
+		}
+
+		UE_LOG(LogDlgBenchmark, Display, TEXT("Wrote benchmark results to %s"), *FilePath);
+		return true;
+	};
+
+	const FString BasePath = GetOutputDirectory() / SuiteName;
+	const bool bSavedCSV = SaveFile(BasePath + TEXT(".csv"), ToCSV());
+	const bool bSavedJSON = SaveFile(BasePath + TEXT(".json"), ToJSON());
+	return bSavedCSV && bSavedJSON;
+}
+
+FString FDlgBenchmarkReport::ToCSV() const
+{
+	FString CSV = TEXT("Name,Iterations,TotalMs,NsPerOp,OpsPerSecond\n");
+	for (const FDlgBenchmarkResult& Result : Results)
+	{
+		CSV += FString::Printf(TEXT("%s,%lld,%.4f,%.2f,%.1f\n"),
+			*Result.Name, Result.Iterations, Result.TotalSeconds * 1000.0, Result.GetNanosecondsPerOperation(), Result.GetOperationsPerSecond());
+	}
+
+	return CSV;
+}
+
+FString FDlgBenchmarkReport::ToJSON() const
+{
+	TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+	Root->SetStringField(TEXT("Suite"), SuiteName);
+	Root->SetStringField(TEXT("Timestamp"), FDateTime::UtcNow().ToIso8601());
+	Root->SetStringField(TEXT("EngineVersion"), FEngineVersion::Current().ToString());
+	Root->SetStringField(TEXT("Platform"), FPlatformProperties::IniPlatformName());
+	Root->SetStringField(TEXT("CPU"), FPlatformMisc::GetCPUBrand().TrimStartAndEnd());
+
+	TArray<TSharedPtr<FJsonValue>> ResultValues;
+	for (const FDlgBenchmarkResult& Result : Results)
+	{
+		TSharedRef<FJsonObject> ResultObject = MakeShared<FJsonObject>();
+		ResultObject->SetStringField(TEXT("Name"), Result.Name);
+		ResultObject->SetNumberField(TEXT("Iterations"), Result.Iterations);
+		ResultObject->SetNumberField(TEXT("TotalMs"), Result.TotalSeconds * 1000.0);
+		ResultObject->SetNumberField(TEXT("NsPerOp"), Result.GetNanosecondsPerOperation());
+		ResultObject->SetNumberField(TEXT("OpsPerSecond"), Result.GetOperationsPerSecond());
+		ResultValues.Add(MakeShared<FJsonValueObject>(ResultObject));
+	}
+	Root->SetArrayField(TEXT("Results"), ResultValues);
+
+	FString JSON;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JSON);
+	FJsonSerializer::Serialize(Root, Writer);
+	return JSON;
+}
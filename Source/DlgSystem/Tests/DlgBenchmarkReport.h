@@ -0,0 +1,65 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformTime.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogDlgBenchmark, All, All);
+
+
+struct FDlgBenchmarkResult
+{
+	FString Name;
+	int64 Iterations = 0;
+	double TotalSeconds = 0.0;
+
+	double GetNanosecondsPerOperation() const { return Iterations > 0 ? TotalSeconds * 1e9 / Iterations : 0.0; }
+	double GetOperationsPerSecond() const { return TotalSeconds > 0.0 ? Iterations / TotalSeconds : 0.0; }
+};
+
+
+/**
+ * Collects the timings of one benchmark suite and saves them as <SuiteName>.csv and <SuiteName>.json
+ * into -DlgBenchmarkDir= (default: Saved/DlgSystem/Benchmarks), so runs can be compared between builds.
+ * The benchmarks only use fixed seeds, run them with:
+ *	UnrealEditor-Cmd <Project> -nullrhi -unattended -ExecCmds="Automation RunTests DlgSystem.Benchmarks; Quit"
+ */
+class FDlgBenchmarkReport
+{
+public:
+	FDlgBenchmarkReport(const FString& InSuiteName) : SuiteName(InSuiteName) {}
+
+	// Runs Function Iterations times (after a short warm up) and records the result
+	template <typename FunctionType>
+	const FDlgBenchmarkResult& Run(const FString& Name, int64 Iterations, FunctionType&& Function)
+	{
+		const int64 WarmUpIterations = FMath::Max<int64>(Iterations / 10, 1);
+		for (int64 Index = 0; Index < WarmUpIterations; Index++)
+		{
+			Function();
+		}
+
+		const double StartTime = FPlatformTime::Seconds();
+		for (int64 Index = 0; Index < Iterations; Index++)
+		{
+			Function();
+		}
+		return AddResult(Name, Iterations, FPlatformTime::Seconds() - StartTime);
+	}
+
+	const FDlgBenchmarkResult& AddResult(const FString& Name, int64 Iterations, double TotalSeconds);
+	const TArray<FDlgBenchmarkResult>& GetResults() const { return Results; }
+
+	// Writes the CSV and JSON files, returns false if any of them could not be written
+	bool Save() const;
+
+	static FString GetOutputDirectory();
+
+private:
+	FString ToCSV() const;
+	FString ToJSON() const;
+
+private:
+	FString SuiteName;
+	TArray<FDlgBenchmarkResult> Results;
+};
@@ -0,0 +1,93 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#include "DlgBenchmarkTypes.h"
+
+#include "Math/RandomStream.h"
+#include "UObject/Package.h"
+
+#include "DlgSystem/DlgContext.h"
+#include "DlgSystem/DlgDialogue.h"
+#include "DlgSystem/DlgDialogueGenerator.h"
+#include "DlgSystem/DlgManager.h"
+#include "DlgSystem/DlgMemory.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// FDlgBenchmarkFixture
+static FDlgDialogueGeneratorOptions MakeBenchmarkOptions(int32 NumNodes, int32 NumParticipants, int32 Seed)
+{
+	FDlgDialogueGeneratorOptions Options;
+	Options.Seed = Seed;
+	Options.NumNodes = NumNodes;
+	Options.NumParticipants = NumParticipants;
+	return Options;
+}
+
+FDlgBenchmarkFixture::FDlgBenchmarkFixture(int32 NumNodes, int32 NumParticipants, int32 Seed)
+	: FDlgBenchmarkFixture(MakeBenchmarkOptions(NumNodes, NumParticipants, Seed))
+{
+}
+
+FDlgBenchmarkFixture::FDlgBenchmarkFixture(const FDlgDialogueGeneratorOptions& Options)
+{
+	Dialogue = FDlgDialogueGenerator::GenerateNewDialogue(Options);
+	Dialogue->AddToRoot();
+
+	for (const FGameplayTag& ParticipantTag : Dialogue->GetParticipantTags())
+	{
+		UDlgBenchmarkParticipant* Participant = NewObject<UDlgBenchmarkParticipant>(GetTransientPackage(), NAME_None, RF_Transient);
+		Participant->SetParticipantTag(ParticipantTag);
+		Participant->AddToRoot();
+		Participants.Add(Participant);
+	}
+}
+
+FDlgBenchmarkFixture::~FDlgBenchmarkFixture()
+{
+	FDlgMemory::Get().Empty();
+	for (UObject* Participant : Participants)
+	{
+		Participant->RemoveFromRoot();
+	}
+	Dialogue->RemoveFromRoot();
+}
+
+UDlgContext* FDlgBenchmarkFixture::StartDialogue(const TOptional<int32>& RandomSeed)
+{
+	if (RandomSeed.IsSet())
+	{
+		return UDlgManager::StartDialogueWithRandomSeed(Dialogue, Participants, RandomSeed.GetValue());
+	}
+	return UDlgManager::StartDialogue(Dialogue, Participants);
+}
+
+TArray<int32> FDlgBenchmarkFixture::Walk(const FDlgBenchmarkWalkOptions& Options, TFunctionRef<void(const UDlgContext&, TArray<int32>&)> AddToTrace)
+{
+	TArray<int32> Trace;
+	FRandomStream Stream(Options.ChoiceSeed);
+	for (int32 WalkIndex = 0; WalkIndex < Options.NumWalks; WalkIndex++)
+	{
+		FDlgMemory::Get().Empty();
+		UDlgContext* Context = StartDialogue(Options.FirstRandomSeed + WalkIndex);
+		if (!Context)
+		{
+			Trace.Add(INDEX_NONE);
+			continue;
+		}
+
+		AddToTrace(*Context, Trace);
+		for (int32 Step = 0; Step < Options.NumSteps && ChooseRandomOption(*Context, Stream); Step++)
+		{
+			AddToTrace(*Context, Trace);
+		}
+	}
+	return Trace;
+}
+
+bool FDlgBenchmarkFixture::ChooseRandomOption(UDlgContext& Context, FRandomStream& Stream)
+{
+	if (Context.HasDialogueEnded() || Context.GetOptionsNum() == 0)
+	{
+		return false;
+	}
+	Context.ChooseOption(Stream.RandHelper(Context.GetOptionsNum()));
+	return true;
+}
@@ -0,0 +1,190 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+
+#include "DlgSystem/DlgDialogueParticipant.h"
+#include "DlgSystem/DlgNativeParticipant.h"
+#include "DlgSystem/DlgConditionCustom.h"
+#include "DlgSystem/DlgEventCustom.h"
+
+#include "DlgBenchmarkTypes.generated.h"
+
+class UDlgDialogue;
+class UDlgContext;
+struct FDlgDialogueGeneratorOptions;
+struct FRandomStream;
+struct FDlgBenchmarkWalkOptions;
+
+
+/**
+ * Participant used by the runtime benchmarks.
+ * Answers every interface call with a constant so only the dialogue system itself is measured.
+ * Has a couple of properties before the variables so the reflection lookups are not a best case.
+ */
+UCLASS(Transient)
+class UDlgBenchmarkParticipant : public UObject, public IDlgDialogueParticipant
+{
+	GENERATED_BODY()
+
+public:
+	void SetParticipantTag(const FGameplayTag& InParticipantTag) { ParticipantTag = InParticipantTag; }
+
+	// IDlgDialogueParticipant Interface
+	FGameplayTag GetParticipantTag_Implementation() const override { return ParticipantTag; }
+	FText GetParticipantDisplayName_Implementation(const FGameplayTag& ActiveSpeaker) const override { return DisplayName; }
+	ETextGender GetParticipantGender_Implementation() const override { return ETextGender::Neuter; }
+	UTexture2D* GetParticipantIcon_Implementation(const FGameplayTag& ActiveSpeaker, FName ActiveSpeakerState) const override { return nullptr; }
+
+	bool CheckCondition_Implementation(const UDlgContext* Context, FName ConditionName) const override { return true; }
+	float GetFloatValue_Implementation(FName ValueName) const override { return 5.f; }
+	int32 GetIntValue_Implementation(FName ValueName) const override { NumGetIntValueCalls++; return 5; }
+	bool GetBoolValue_Implementation(FName ValueName) const override { return true; }
+	FName GetNameValue_Implementation(FName ValueName) const override { return ValueName; }
+
+	bool OnDialogueEvent_Implementation(UDlgContext* Context, FName EventName) override { return true; }
+	bool ModifyFloatValue_Implementation(FName ValueName, bool bDelta, float Value) override { return true; }
+	bool ModifyIntValue_Implementation(FName ValueName, bool bDelta, int32 Value) override { return true; }
+	bool ModifyBoolValue_Implementation(FName ValueName, bool bNewValue) override { return true; }
+	bool ModifyNameValue_Implementation(FName ValueName, FName NameValue) override { return true; }
+
+	// Called by EDlgEventType::UnrealFunction
+	UFUNCTION()
+	void BenchmarkFunction() { NumBenchmarkFunctionCalls++; }
+
+public:
+	UPROPERTY()
+	FGameplayTag ParticipantTag;
+
+	UPROPERTY()
+	FText DisplayName = FText::FromString(TEXT("Benchmark"));
+
+	UPROPERTY()
+	int32 UnusedInt0 = 0;
+
+	UPROPERTY()
+	int32 UnusedInt1 = 0;
+
+	UPROPERTY()
+	double UnusedFloat0 = 0.0;
+
+	UPROPERTY()
+	FName UnusedName0;
+
+	UPROPERTY()
+	int32 IntVariable = 5;
+
+	UPROPERTY()
+	double FloatVariable = 5.0;
+
+	UPROPERTY()
+	bool bBoolVariable = true;
+
+	UPROPERTY()
+	FName NameVariable = TEXT("Value");
+
+	UPROPERTY()
+	FText TextVariable = FText::FromString(TEXT("Value"));
+
+	int32 NumBenchmarkFunctionCalls = 0;
+	mutable int32 NumGetIntValueCalls = 0;
+};
+
+
+/**
+ * Benchmark participant that also reads its values through IDlgNativeParticipant.
+ * Answers with the same constants as UDlgBenchmarkParticipant.
+ */
+UCLASS(Transient)
+class UDlgBenchmarkNativeParticipant : public UDlgBenchmarkParticipant, public IDlgNativeParticipant
+{
+	GENERATED_BODY()
+
+public:
+	// IDlgNativeParticipant Interface
+	void GetDialogueValues(const UDlgContext& Context, TArrayView<FDlgParticipantValue> Values) const override
+	{
+		NumGetDialogueValuesCalls++;
+		NumValuesRead += Values.Num();
+		for (FDlgParticipantValue& Value : Values)
+		{
+			Value.bBoolValue = true;
+			Value.IntValue = 5;
+			Value.FloatValue = 5.f;
+			Value.NameValue = Value.Name;
+		}
+	}
+
+public:
+	mutable int32 NumGetDialogueValuesCalls = 0;
+	mutable int32 NumValuesRead = 0;
+};
+
+
+UCLASS(Transient)
+class UDlgBenchmarkConditionCustom : public UDlgConditionCustom
+{
+	GENERATED_BODY()
+
+public:
+	bool IsConditionMet_Implementation(const UDlgContext* Context, const UObject* Participant) override { return true; }
+};
+
+
+UCLASS(Transient)
+class UDlgBenchmarkEventCustom : public UDlgEventCustom
+{
+	GENERATED_BODY()
+
+public:
+	void EnterEvent_Implementation(UDlgContext* Context, UObject* Participant) override {}
+};
+
+
+/**
+ * Generated dialogue and one benchmark participant for each of its participant tags.
+ * Everything is rooted while the fixture is alive, so the benchmarks can collect garbage.
+ */
+struct FDlgBenchmarkFixture
+{
+public:
+	static constexpr int32 DefaultSeed = 1337;
+
+	FDlgBenchmarkFixture(int32 NumNodes, int32 NumParticipants = 2, int32 Seed = DefaultSeed);
+	explicit FDlgBenchmarkFixture(const FDlgDialogueGeneratorOptions& Options);
+	~FDlgBenchmarkFixture();
+
+	// RandomSeed seeds the random stream of the context if it is set
+	UDlgContext* StartDialogue(const TOptional<int32>& RandomSeed = {});
+
+	/**
+	 * Seeded random walks of the dialogue, the memory is emptied before every walk.
+	 * AddToTrace is called with the context after the start and after every chosen option,
+	 * the traces of two runs are equal if the dialogue behaved the same.
+	 */
+	TArray<int32> Walk(const FDlgBenchmarkWalkOptions& Options, TFunctionRef<void(const UDlgContext&, TArray<int32>&)> AddToTrace);
+
+	// Chooses a random option of the context, returns false instead if the walk is over
+	static bool ChooseRandomOption(UDlgContext& Context, FRandomStream& Stream);
+
+public:
+	UDlgDialogue* Dialogue = nullptr;
+	TArray<UObject*> Participants;
+};
+
+
+struct FDlgBenchmarkWalkOptions
+{
+public:
+	int32 NumWalks = 1;
+
+	// Maximum number of options chosen in one walk
+	int32 NumSteps = 32;
+
+	// Walk N seeds the random stream of its context with FirstRandomSeed + N
+	int32 FirstRandomSeed = 0;
+
+	// Seed of the stream the options are chosen from, shared by all the walks
+	int32 ChoiceSeed = FDlgBenchmarkFixture::DefaultSeed;
+};
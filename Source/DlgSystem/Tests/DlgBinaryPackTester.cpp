@@ -0,0 +1,120 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+
+#include "CoreTypes.h"
+#include "Misc/AutomationTest.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "UObject/Package.h"
+
+#include "DlgSystem/DlgDialogue.h"
+#include "DlgSystem/Nodes/DlgNode_Speech.h"
+#include "DlgSystem/IO/DlgBinaryWriter.h"
+#include "DlgSystem/IO/DlgBinaryParser.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgBinaryPackAutomationTest,
+	"DlgSystem.IO.BinaryPack",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter
+)
+
+bool FDlgBinaryPackAutomationTest::RunTest(const FString& Parameters)
+{
+	// Small dialogue, every node has a text, a condition on the edge and an enter event
+	UDlgDialogue* ExportedDialogue = NewObject<UDlgDialogue>(GetTransientPackage(), NAME_None, RF_Transient);
+	static constexpr int32 NumNodes = 16;
+	for (int32 NodeIndex = 0; NodeIndex < NumNodes; NodeIndex++)
+	{
+		UDlgNode_Speech* Node = ExportedDialogue->ConstructDialogueNode<UDlgNode_Speech>();
+		Node->RegenerateGUID();
+		Node->SetNodeText(FText::FromString(FString::Printf(TEXT("Line %d"), NodeIndex)), {});
+
+		FDlgEdge Edge((NodeIndex + 1) % NumNodes);
+		FDlgCondition Condition;
+		Condition.ConditionType = EDlgConditionType::WasNodeVisited;
+		Condition.IntValue = NodeIndex;
+		Condition.bBoolValue = NodeIndex % 2 == 0;
+		Edge.Conditions.Add(Condition);
+		Node->AddNodeChild(Edge);
+
+		FDlgEvent Event;
+		Event.EventType = EDlgEventType::ModifyInt;
+		Event.EventName = FName(*FString::Printf(TEXT("Counter_%d"), NodeIndex));
+		Event.IntValue = NodeIndex;
+		Node->SetNodeEnterEvents({ Event });
+
+		ExportedDialogue->AddNode(Node);
+	}
+	UDlgNode_Speech* StartNode = ExportedDialogue->ConstructDialogueNode<UDlgNode_Speech>();
+	StartNode->AddNodeChild(FDlgEdge(0));
+	ExportedDialogue->AddStartNode(StartNode);
+
+	FDlgBinaryWriter Writer;
+	Writer.Write(ExportedDialogue->GetClass(), ExportedDialogue);
+	const TArray<UDlgNode*>& ExportedNodes = ExportedDialogue->GetNodes();
+
+	// Round trip
+	{
+		FDlgBinaryParser Parser;
+		TArray<uint8> Bytes = Writer.GetAsBytes();
+		Parser.InitializeParserFromBytes(MoveTemp(Bytes));
+		TestTrue(TEXT("Binary pack is valid"), Parser.IsValidFile());
+
+		UDlgDialogue* ImportedDialogue = NewObject<UDlgDialogue>(GetTransientPackage(), NAME_None, RF_Transient);
+		Parser.ReadAllProperty(ImportedDialogue->GetClass(), ImportedDialogue, ImportedDialogue);
+
+		const TArray<UDlgNode*>& ImportedNodes = ImportedDialogue->GetNodes();
+		TestEqual(TEXT("Number of nodes"), ImportedNodes.Num(), NumNodes);
+		TestEqual(TEXT("Number of start nodes"), ImportedDialogue->GetStartNodes().Num(), 1);
+		for (int32 NodeIndex = 0; NodeIndex < FMath::Min(NumNodes, ImportedNodes.Num()); NodeIndex++)
+		{
+			const UDlgNode& Exported = *ExportedNodes[NodeIndex];
+			const UDlgNode& Imported = *ImportedNodes[NodeIndex];
+			TestTrue(TEXT("Node class"), Imported.IsA<UDlgNode_Speech>());
+			TestEqual(TEXT("Node GUID"), Imported.GetGUID(), Exported.GetGUID());
+			TestEqual(TEXT("Node text"), Imported.GetNodeUnformattedText().ToString(), Exported.GetNodeUnformattedText().ToString());
+			TestTrue(TEXT("Node edges"), Imported.GetNodeChildren() == Exported.GetNodeChildren());
+			TestTrue(TEXT("Node enter events"), Imported.GetNodeEnterEvents() == Exported.GetNodeEnterEvents());
+		}
+	}
+
+	// Corrupted packs are rejected
+	{
+		TArray<uint8> Truncated = Writer.GetAsBytes();
+		Truncated.SetNum(Truncated.Num() / 2);
+		FDlgBinaryParser Parser;
+		Parser.InitializeParserFromBytes(MoveTemp(Truncated));
+		UDlgDialogue* ImportedDialogue = NewObject<UDlgDialogue>(GetTransientPackage(), NAME_None, RF_Transient);
+		Parser.ReadAllProperty(ImportedDialogue->GetClass(), ImportedDialogue, ImportedDialogue);
+		TestTrue(TEXT("Truncated pack does not crash"), ImportedDialogue->GetNodes().Num() <= NumNodes);
+
+		TArray<uint8> BadMagic = Writer.GetAsBytes();
+		BadMagic[0] = 0;
+		Parser.InitializeParserFromBytes(MoveTemp(BadMagic));
+		TestFalse(TEXT("Pack with invalid magic is invalid"), Parser.IsValidFile());
+
+		// The counts and lengths must fit in their table
+		TArray<uint8> BadNameCount = Writer.GetAsBytes();
+		FDlgBinaryPackHeader Header;
+		FMemoryReader HeaderReader(BadNameCount);
+		HeaderReader << Header;
+		Header.NameCount = Header.NameTableSize;
+		FMemoryWriter HeaderWriter(BadNameCount);
+		HeaderWriter << Header;
+		Parser.InitializeParserFromBytes(MoveTemp(BadNameCount));
+		TestFalse(TEXT("Pack with a name count bigger than the name table is invalid"), Parser.IsValidFile());
+
+		TArray<uint8> BadStringLength = Writer.GetAsBytes();
+		FMemoryWriter LengthWriter(BadStringLength);
+		LengthWriter.Seek(Header.StringTableOffset);
+		int32 SaveNum = MAX_int32;
+		LengthWriter << SaveNum;
+		Parser.InitializeParserFromBytes(MoveTemp(BadStringLength));
+		TestFalse(TEXT("Pack with a string longer than the string table is invalid"), Parser.IsValidFile());
+	}
+
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
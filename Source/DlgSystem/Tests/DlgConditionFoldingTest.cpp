@@ -0,0 +1,76 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+
+#include "CoreTypes.h"
+#include "Misc/AutomationTest.h"
+
+#include "DlgSystem/DlgCondition.h"
+#include "DlgSystem/DlgConditionProgram.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace DlgConditionFolding
+{
+	// IntValue is the constant result of the condition, 0 = Unknown, 1 = AlwaysTrue, 2 = AlwaysFalse
+	static FDlgCondition Make(EDlgConditionConstant Constant, EDlgConditionStrength Strength = EDlgConditionStrength::Strong)
+	{
+		FDlgCondition Condition;
+		Condition.Strength = Strength;
+		Condition.IntValue = static_cast<int32>(Constant);
+		return Condition;
+	}
+
+	static EDlgConditionConstant Fold(TArray<FDlgCondition>& Conditions)
+	{
+		return FDlgConditionProgram::FoldConstants(Conditions, [](const FDlgCondition& Condition)
+		{
+			return static_cast<EDlgConditionConstant>(Condition.IntValue);
+		});
+	}
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgConditionFoldingTest,
+	"DlgSystem.Conditions.FoldConstants",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter
+)
+
+bool FDlgConditionFoldingTest::RunTest(const FString& Parameters)
+{
+	using namespace DlgConditionFolding;
+	static constexpr EDlgConditionConstant Unknown = EDlgConditionConstant::Unknown;
+	static constexpr EDlgConditionConstant True = EDlgConditionConstant::AlwaysTrue;
+	static constexpr EDlgConditionConstant False = EDlgConditionConstant::AlwaysFalse;
+	static constexpr EDlgConditionStrength Weak = EDlgConditionStrength::Weak;
+
+	TArray<FDlgCondition> Conditions;
+	TestEqual(TEXT("Empty array"), Fold(Conditions), True);
+
+	Conditions = { Make(True), Make(Unknown), Make(True) };
+	TestEqual(TEXT("Satisfied strong conditions are removed"), Fold(Conditions), Unknown);
+	TestEqual(TEXT("Only the unknown strong condition is kept"), Conditions.Num(), 1);
+
+	Conditions = { Make(True), Make(True) };
+	TestEqual(TEXT("Every strong condition is satisfied"), Fold(Conditions), True);
+	TestEqual(TEXT("Nothing is kept"), Conditions.Num(), 0);
+
+	Conditions = { Make(Unknown), Make(False), Make(Unknown, Weak) };
+	TestEqual(TEXT("Never satisfied strong condition"), Fold(Conditions), False);
+	TestTrue(TEXT("Only the deciding condition is kept"), Conditions.Num() == 1 && Conditions[0].IntValue == static_cast<int32>(False));
+
+	Conditions = { Make(Unknown), Make(Unknown, Weak), Make(True, Weak) };
+	TestEqual(TEXT("Always satisfied weak condition"), Fold(Conditions), Unknown);
+	TestTrue(TEXT("Every weak condition is removed"), Conditions.Num() == 1 && Conditions[0].Strength == EDlgConditionStrength::Strong);
+
+	Conditions = { Make(Unknown, Weak), Make(False, Weak) };
+	TestEqual(TEXT("Never satisfied weak condition next to an unknown one"), Fold(Conditions), Unknown);
+	TestTrue(TEXT("The never satisfied weak condition is removed"), Conditions.Num() == 1 && Conditions[0].IntValue == static_cast<int32>(Unknown));
+
+	Conditions = { Make(Unknown), Make(False, Weak), Make(False, Weak) };
+	TestEqual(TEXT("No weak condition can be satisfied"), Fold(Conditions), False);
+	TestTrue(TEXT("One weak condition is kept"), Conditions.Num() == 1 && Conditions[0].Strength == EDlgConditionStrength::Weak);
+
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
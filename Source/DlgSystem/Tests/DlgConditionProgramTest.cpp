@@ -0,0 +1,129 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+
+#include "CoreTypes.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+
+#include "DlgSystem/DlgCondition.h"
+#include "DlgSystem/DlgConditionProgram.h"
+#include "DlgSystem/DlgContext.h"
+#include "DlgSystem/DlgDialogue.h"
+
+#include "DlgBenchmarkTypes.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace DlgConditionProgram
+{
+	static constexpr int32 NumArrays = 512;
+	static constexpr int32 MaxConditions = 6;
+
+	// Conditions with a known result for UDlgBenchmarkParticipant, both satisfied and unsatisfied ones
+	static TArray<FDlgCondition> MakeConditionPool(const FGameplayTag& ParticipantTag)
+	{
+		TArray<FDlgCondition> Pool;
+		auto Add = [&Pool, &ParticipantTag](EDlgConditionType ConditionType) -> FDlgCondition&
+		{
+			FDlgCondition& Condition = Pool.AddDefaulted_GetRef();
+			Condition.ConditionType = ConditionType;
+			Condition.ParticipantTag = ParticipantTag;
+			Condition.CallbackName = TEXT("Value");
+			return Condition;
+		};
+
+		Add(EDlgConditionType::IntCall).IntValue = 5;
+		Add(EDlgConditionType::IntCall).IntValue = 6;
+		Add(EDlgConditionType::BoolCall).bBoolValue = true;
+		Add(EDlgConditionType::BoolCall).bBoolValue = false;
+		FDlgCondition& Greater = Add(EDlgConditionType::FloatCall);
+		Greater.Operation = EDlgOperation::Greater;
+		Greater.FloatValue = 4.f;
+		FDlgCondition& Less = Add(EDlgConditionType::FloatCall);
+		Less.Operation = EDlgOperation::Less;
+		Less.FloatValue = 4.f;
+		Add(EDlgConditionType::NameCall).NameValue = TEXT("Value");
+		Add(EDlgConditionType::NameCall).NameValue = TEXT("Wrong");
+		Add(EDlgConditionType::EventCall).bBoolValue = true;
+
+		FDlgCondition& Visited = Add(EDlgConditionType::WasNodeVisited);
+		Visited.IntValue = 0;
+		Visited.bBoolValue = true;
+		Visited.bLongTermMemory = false;
+		return Pool;
+	}
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgConditionProgramTest,
+	"DlgSystem.Conditions.ConditionProgram",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter
+)
+
+bool FDlgConditionProgramTest::RunTest(const FString& Parameters)
+{
+	using namespace DlgConditionProgram;
+
+	FDlgBenchmarkFixture Fixture(20, 1);
+	const UDlgContext* Context = Fixture.StartDialogue();
+	if (!TestNotNull(TEXT("Context"), Context))
+	{
+		return false;
+	}
+
+	const FGameplayTag ParticipantTag = Fixture.Dialogue->GetParticipantTags().First();
+	const TArray<FDlgCondition> Pool = MakeConditionPool(ParticipantTag);
+
+	// Mixed strong and weak arrays, the program reorders them by cost
+	FRandomStream Stream(FDlgBenchmarkFixture::DefaultSeed);
+	int32 NumSatisfied = 0;
+	for (int32 ArrayIndex = 0; ArrayIndex < NumArrays; ArrayIndex++)
+	{
+		TArray<FDlgCondition> Conditions;
+		const int32 NumConditions = Stream.RandRange(0, MaxConditions);
+		for (int32 Index = 0; Index < NumConditions; Index++)
+		{
+			FDlgCondition& Condition = Conditions.Add_GetRef(Pool[Stream.RandHelper(Pool.Num())]);
+			Condition.Strength = Stream.FRand() < 0.5f ? EDlgConditionStrength::Strong : EDlgConditionStrength::Weak;
+		}
+
+		const bool bExpected = FDlgCondition::EvaluateArray(*Context, Conditions);
+		TSharedPtr<const FDlgConditionProgram> Program;
+		if (!TestEqual(FString::Printf(TEXT("Array %d"), ArrayIndex), FDlgConditionProgram::EvaluateCached(Program, *Context, Conditions), bExpected))
+		{
+			break;
+		}
+		NumSatisfied += bExpected ? 1 : 0;
+	}
+	TestTrue(TEXT("Some arrays are satisfied and some are not"), NumSatisfied > 0 && NumSatisfied < NumArrays);
+
+	// The cached program follows the array
+	const FDlgCondition& Satisfied = Pool[0];
+	const FDlgCondition& Unsatisfied = Pool[1];
+	TArray<FDlgCondition> Conditions = { Satisfied };
+	TSharedPtr<const FDlgConditionProgram> Program;
+	TestTrue(TEXT("Compiled"), FDlgConditionProgram::EvaluateCached(Program, *Context, Conditions));
+	// Kept alive so a new program can not get the same address
+	const TSharedPtr<const FDlgConditionProgram> FirstProgram = Program;
+
+	Conditions.Add(Unsatisfied);
+	TestFalse(TEXT("Resized array"), FDlgConditionProgram::EvaluateCached(Program, *Context, Conditions));
+	TestTrue(TEXT("Resized array is compiled again"), Program != FirstProgram);
+	const TSharedPtr<const FDlgConditionProgram> ResizedProgram = Program;
+
+	TArray<FDlgCondition> Reallocated = Conditions;
+	Reallocated[1].Strength = EDlgConditionStrength::Weak;
+	Reallocated[0].Strength = EDlgConditionStrength::Weak;
+	TestTrue(TEXT("Reallocated array"), FDlgConditionProgram::EvaluateCached(Program, *Context, Reallocated));
+	TestTrue(TEXT("Reallocated array is compiled again"), Program != ResizedProgram);
+
+	// Modified in place, only caught if the owner resets the program
+	Reallocated[0] = Unsatisfied;
+	Reallocated[0].Strength = EDlgConditionStrength::Weak;
+	Program.Reset();
+	TestEqual(TEXT("Modified in place"), FDlgConditionProgram::EvaluateCached(Program, *Context, Reallocated), FDlgCondition::EvaluateArray(*Context, Reallocated));
+
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
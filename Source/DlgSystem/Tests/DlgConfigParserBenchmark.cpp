@@ -0,0 +1,59 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+
+#include "CoreTypes.h"
+#include "Containers/UnrealString.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+
+#include "DlgSystem/DlgDialogue.h"
+#include "DlgSystem/DlgDialogueGenerator.h"
+#include "DlgSystem/IO/DlgConfigWriter.h"
+#include "DlgSystem/IO/DlgConfigParser.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogDlgConfigParserBenchmark, All, All);
+DEFINE_LOG_CATEGORY(LogDlgConfigParserBenchmark);
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgConfigParserBenchmarkTest,
+	"DlgSystem.IO.Benchmarks.ConfigParser",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter
+)
+
+bool FDlgConfigParserBenchmarkTest::RunTest(const FString& Parameters)
+{
+	static constexpr int32 NumNodes = 10000;
+
+	FDlgDialogueGeneratorOptions Options;
+	Options.NumNodes = NumNodes;
+	const UDlgDialogue* ExportedDialogue = FDlgDialogueGenerator::GenerateNewDialogue(Options);
+	FDlgConfigWriter Writer(TEXT("Dlg"));
+	Writer.Write(ExportedDialogue->GetClass(), ExportedDialogue);
+	const FString DlgString = Writer.GetAsString();
+
+	UDlgDialogue* ImportedDialogue = NewObject<UDlgDialogue>(GetTransientPackage(), NAME_None, RF_Transient);
+	const double StartTime = FPlatformTime::Seconds();
+
+	FDlgConfigParser Parser(TEXT("Dlg"));
+	Parser.InitializeParserFromString(DlgString);
+	Parser.ReadAllProperty(ImportedDialogue->GetClass(), ImportedDialogue, ImportedDialogue);
+
+	const double ElapsedSeconds = FPlatformTime::Seconds() - StartTime;
+	UE_LOG(LogDlgConfigParserBenchmark, Display, TEXT("Parsed %d nodes (%d characters) in %.3f ms (%.2f MB/s)"),
+		NumNodes, DlgString.Len(), ElapsedSeconds * 1000.0, DlgString.Len() * sizeof(TCHAR) / (1024.0 * 1024.0) / FMath::Max(ElapsedSeconds, SMALL_NUMBER));
+
+	TestEqual(TEXT("Number of imported nodes"), ImportedDialogue->GetNodes().Num(), NumNodes);
+	TestEqual(TEXT("Number of imported start nodes"), ImportedDialogue->GetStartNodes().Num(), 1);
+	if (ImportedDialogue->GetNodes().Num() == NumNodes)
+	{
+		const UDlgNode* LastNode = ImportedDialogue->GetNodes().Last();
+		TestEqual(TEXT("Last node GUID"), LastNode->GetGUID(), ExportedDialogue->GetNodes().Last()->GetGUID());
+		TestEqual(TEXT("Last node children"), LastNode->GetNodeChildren().Num(), ExportedDialogue->GetNodes().Last()->GetNodeChildren().Num());
+	}
+
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,64 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+
+#include "CoreTypes.h"
+#include "Misc/AutomationTest.h"
+
+#include "DlgSystem/DlgContext.h"
+
+#include "DlgBenchmarkTypes.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace DlgContextRandomSeed
+{
+	static constexpr int32 NumSteps = 200;
+
+	// Active node after every step, the choices come from ChoiceSeed and the global random is scrambled between the steps
+	static TArray<int32> Walk(FDlgBenchmarkFixture& Fixture, int32 RandomSeed, int32 ChoiceSeed, int32 GlobalSeed)
+	{
+		FDlgBenchmarkWalkOptions Options;
+		Options.NumSteps = NumSteps;
+		Options.FirstRandomSeed = RandomSeed;
+		Options.ChoiceSeed = ChoiceSeed;
+
+		FMath::RandInit(GlobalSeed);
+		int32 Step = 0;
+		return Fixture.Walk(Options, [GlobalSeed, &Step](const UDlgContext& Context, TArray<int32>& Trace)
+		{
+			Trace.Add(Context.GetActiveNodeIndex());
+			FMath::RandInit(GlobalSeed + Step++);
+		});
+	}
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgContextRandomSeedTest,
+	"DlgSystem.Context.RandomSeed",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter
+)
+
+bool FDlgContextRandomSeedTest::RunTest(const FString& Parameters)
+{
+	using namespace DlgContextRandomSeed;
+
+	FDlgBenchmarkFixture Fixture(200);
+	UDlgContext* Context = Fixture.StartDialogue(42);
+	if (!TestNotNull(TEXT("Context"), Context))
+	{
+		return false;
+	}
+	TestTrue(TEXT("Context has the random seed"), Context->HasRandomSeed());
+	TestEqual(TEXT("Random seed"), Context->GetRandomSeed(), 42);
+
+	for (int32 RandomSeed = 0; RandomSeed < 8; RandomSeed++)
+	{
+		const TArray<int32> Expected = Walk(Fixture, RandomSeed, RandomSeed, 1);
+		const TArray<int32> Actual = Walk(Fixture, RandomSeed, RandomSeed, 1000);
+		TestTrue(FString::Printf(TEXT("Seed = %d: same traversal with a different global random"), RandomSeed), Expected == Actual);
+	}
+
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
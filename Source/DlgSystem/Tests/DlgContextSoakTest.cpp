@@ -0,0 +1,212 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+
+#include "CoreTypes.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "UObject/UObjectArray.h"
+#include "UObject/UObjectGlobals.h"
+
+#include "DlgSystem/DlgContext.h"
+#include "DlgSystem/DlgMemory.h"
+
+#include "DlgBenchmarkReport.h"
+#include "DlgBenchmarkTypes.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace DlgContextSoak
+{
+	static constexpr int32 NumContexts = 10000;
+	static constexpr int32 NumSteps = 48;
+	static constexpr int32 NumDialogues = 16;
+	static constexpr int32 NumNodes = 200;
+	static constexpr int32 SampleEverySteps = 8;
+	static constexpr int32 TraceRestart = -2;
+
+	/**
+	 * One dialogue walk with its own seed, restarted every time the dialogue ends.
+	 * The trace is the active node index, the active speech sequence index and the hash of the active text and speaker after every step.
+	 *
+	 * The long term memory (FDlgMemory) is global by design, so before every step the memory is emptied,
+	 * this way only the per context state can make the interleaved run differ from the single context run.
+	 * The random selectors use the random stream of the context, seeded from the walker's own stream.
+	 */
+	struct FWalker
+	{
+		FWalker(FDlgBenchmarkFixture& InFixture, int32 Seed) : Fixture(&InFixture), Stream(Seed) {}
+
+		void Start()
+		{
+			FDlgMemory::Get().Empty();
+			SetContext(Fixture->StartDialogue(Stream.RandHelper(MAX_int32)));
+			Trace.Add(TraceRestart);
+			AddToTrace();
+		}
+
+		void Step()
+		{
+			FDlgMemory::Get().Empty();
+			if (!Context || !FDlgBenchmarkFixture::ChooseRandomOption(*Context, Stream))
+			{
+				Start();
+				return;
+			}
+			AddToTrace();
+		}
+
+		void Finish() { SetContext(nullptr); }
+
+		void SetContext(UDlgContext* NewContext)
+		{
+			if (Context)
+			{
+				Context->RemoveFromRoot();
+			}
+			Context = NewContext;
+			if (Context)
+			{
+				Context->AddToRoot();
+			}
+		}
+
+		void AddToTrace()
+		{
+			const bool bHasActiveNode = Context && Context->GetActiveNode() != nullptr;
+			Trace.Add(Context ? Context->GetActiveNodeIndex() : INDEX_NONE);
+			Trace.Add(Context ? Context->GetActiveSpeechSequenceIndex() : INDEX_NONE);
+			Trace.Add(bHasActiveNode ? static_cast<int32>(GetTypeHash(Context->GetActiveNodeText().ToString())) : 0);
+			Trace.Add(bHasActiveNode ? static_cast<int32>(GetTypeHash(Context->GetActiveNodeParticipantTag())) : 0);
+		}
+
+		FDlgBenchmarkFixture* Fixture = nullptr;
+		FRandomStream Stream;
+		UDlgContext* Context = nullptr;
+		TArray<int32> Trace;
+	};
+
+	struct FSample
+	{
+		int32 Step = 0;
+		uint64 UsedPhysicalMB = 0;
+		int32 NumUObjects = 0;
+		double GCMilliseconds = 0.0;
+	};
+
+	static FSample TakeSample(int32 Step)
+	{
+		FSample Sample;
+		Sample.Step = Step;
+
+		const double StartTime = FPlatformTime::Seconds();
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+		Sample.GCMilliseconds = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+		Sample.UsedPhysicalMB = FPlatformMemory::GetStats().UsedPhysical / (1024 * 1024);
+		Sample.NumUObjects = GUObjectArray.GetObjectArrayNumMinusAvailable();
+		return Sample;
+	}
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgContextSoakTest,
+	"DlgSystem.Soak.Contexts",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::StressFilter
+)
+
+bool FDlgContextSoakTest::RunTest(const FString& Parameters)
+{
+	using namespace DlgContextSoak;
+
+	TArray<TUniquePtr<FDlgBenchmarkFixture>> Fixtures;
+	for (int32 DialogueIndex = 0; DialogueIndex < NumDialogues; DialogueIndex++)
+	{
+		Fixtures.Add(MakeUnique<FDlgBenchmarkFixture>(NumNodes, 2, FDlgBenchmarkFixture::DefaultSeed + DialogueIndex));
+	}
+
+	FString CSV = TEXT("Mode,Step,UsedPhysicalMB,NumUObjects,GCMs\n");
+	for (const bool bSameDialogue : { true, false })
+	{
+		const TCHAR* Mode = bSameDialogue ? TEXT("SameDialogue") : TEXT("DifferentDialogues");
+		auto MakeWalker = [&](int32 ContextIndex)
+		{
+			FDlgBenchmarkFixture& Fixture = *Fixtures[bSameDialogue ? 0 : ContextIndex % NumDialogues];
+			return FWalker(Fixture, FDlgBenchmarkFixture::DefaultSeed + ContextIndex);
+		};
+
+		// Reference, every context runs alone
+		TArray<TArray<int32>> ExpectedTraces;
+		ExpectedTraces.Reserve(NumContexts);
+		for (int32 ContextIndex = 0; ContextIndex < NumContexts; ContextIndex++)
+		{
+			FWalker Walker = MakeWalker(ContextIndex);
+			Walker.Start();
+			for (int32 Step = 0; Step < NumSteps; Step++)
+			{
+				Walker.Step();
+			}
+			Walker.Finish();
+			ExpectedTraces.Add(MoveTemp(Walker.Trace));
+		}
+
+		// Every context is alive, one step each in turns
+		TArray<FWalker> Walkers;
+		Walkers.Reserve(NumContexts);
+		for (int32 ContextIndex = 0; ContextIndex < NumContexts; ContextIndex++)
+		{
+			Walkers.Add(MakeWalker(ContextIndex));
+			Walkers.Last().Start();
+		}
+
+		TArray<FSample> Samples;
+		Samples.Add(TakeSample(0));
+		for (int32 Step = 0; Step < NumSteps; Step++)
+		{
+			for (FWalker& Walker : Walkers)
+			{
+				Walker.Step();
+			}
+			if ((Step + 1) % SampleEverySteps == 0)
+			{
+				Samples.Add(TakeSample(Step + 1));
+			}
+		}
+
+		int32 NumMismatches = 0;
+		for (int32 ContextIndex = 0; ContextIndex < NumContexts; ContextIndex++)
+		{
+			Walkers[ContextIndex].Finish();
+			if (Walkers[ContextIndex].Trace != ExpectedTraces[ContextIndex])
+			{
+				if (NumMismatches == 0)
+				{
+					AddError(FString::Printf(TEXT("%s: context = %d behaves differently when interleaved with other contexts"), Mode, ContextIndex));
+				}
+				NumMismatches++;
+			}
+		}
+		TestEqual(FString::Printf(TEXT("%s: number of contexts that are not deterministic"), Mode), NumMismatches, 0);
+
+		for (const FSample& Sample : Samples)
+		{
+			UE_LOG(LogDlgBenchmark, Display, TEXT("%s step %d: used physical = %llu MB, UObjects = %d, GC = %.2f ms"),
+				Mode, Sample.Step, Sample.UsedPhysicalMB, Sample.NumUObjects, Sample.GCMilliseconds);
+			CSV += FString::Printf(TEXT("%s,%d,%llu,%d,%.3f\n"), Mode, Sample.Step, Sample.UsedPhysicalMB, Sample.NumUObjects, Sample.GCMilliseconds);
+		}
+		UE_LOG(LogDlgBenchmark, Display, TEXT("%s: memory growth = %lld MB, UObject growth = %d"),
+			Mode, static_cast<int64>(Samples.Last().UsedPhysicalMB) - static_cast<int64>(Samples[0].UsedPhysicalMB), Samples.Last().NumUObjects - Samples[0].NumUObjects);
+	}
+
+	const FString FilePath = FDlgBenchmarkReport::GetOutputDirectory() / TEXT("ContextSoak.csv");
+	if (!FFileHelper::SaveStringToFile(CSV, *FilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+	{
+		AddWarning(FString::Printf(TEXT("Could not write %s"), *FilePath));
+	}
+
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,111 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+
+#include "CoreTypes.h"
+#include "Dom/JsonObject.h"
+#include "Misc/AutomationTest.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+#include "DlgSystem/DlgContext.h"
+#include "DlgSystem/DlgContextTrace.h"
+#include "DlgSystem/DlgDialogue.h"
+#include "DlgSystem/Nodes/DlgNode.h"
+
+#include "DlgBenchmarkTypes.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && DLG_WITH_CONTEXT_TRACE
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgContextTraceTest,
+	"DlgSystem.ContextTrace",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter
+)
+
+bool FDlgContextTraceTest::RunTest(const FString& Parameters)
+{
+	// Ring buffer keeps the newest entries
+	FDlgContextTrace Trace(4);
+	for (int32 NodeIndex = 0; NodeIndex < 10; NodeIndex++)
+	{
+		Trace.AddEnterNode(NodeIndex);
+	}
+	TestEqual(TEXT("Number of entries is capped by the capacity"), Trace.Num(), 4);
+	TestEqual(TEXT("Number of recorded entries"), Trace.GetNumRecorded(), static_cast<int64>(10));
+	TestEqual(TEXT("Oldest entry"), Trace.Get(0).NodeIndex, 6);
+	TestEqual(TEXT("Newest entry"), Trace.Get(3).NodeIndex, 9);
+
+	// Running context
+	FDlgBenchmarkFixture Fixture(50);
+	FDlgContextTrace::SetCapacityForNewContexts(FDlgContextTrace::DefaultCapacity);
+	UDlgContext* Context = Fixture.StartDialogue();
+	FDlgContextTrace::SetCapacityForNewContexts(0);
+	if (!TestNotNull(TEXT("Context"), Context))
+	{
+		return false;
+	}
+	Context->AddToRoot();
+
+	TestTrue(TEXT("New contexts are traced"), Context->IsTraceEnabled());
+	for (int32 Step = 0; Step < 8 && !Context->HasDialogueEnded() && Context->GetOptionsNum() > 0; Step++)
+	{
+		Context->ChooseOption(0);
+	}
+
+	// The recursive evaluation checks the edges of other nodes, every edge must be recorded with the node it belongs to
+	auto IsEdgeOf = [Context](int32 NodeIndex, int32 TargetIndex)
+	{
+		const UDlgDialogue* Dialogue = Context->GetDialogue();
+		TArray<const UDlgNode*> Nodes;
+		if (NodeIndex == INDEX_NONE)
+		{
+			Nodes.Append(Dialogue->GetStartNodes());
+		}
+		else if (Dialogue->IsValidNodeIndex(NodeIndex))
+		{
+			Nodes.Add(Dialogue->GetNodes()[NodeIndex]);
+		}
+
+		for (const UDlgNode* Node : Nodes)
+		{
+			if (Node->GetNodeChildren().ContainsByPredicate([TargetIndex](const FDlgEdge& Edge) { return Edge.TargetIndex == TargetIndex; }))
+			{
+				return true;
+			}
+		}
+		return false;
+	};
+
+	bool bHasEnterNode = false;
+	bool bHasEdge = false;
+	int32 NumEdgesOfOtherNodes = 0;
+	const FDlgContextTrace* ContextTrace = Context->GetTrace();
+	for (int32 Index = 0; Index < ContextTrace->Num(); Index++)
+	{
+		const FDlgContextTraceEntry& Entry = ContextTrace->Get(Index);
+		bHasEnterNode |= Entry.Type == EDlgContextTraceEntryType::EnterNode;
+		if (Entry.Type == EDlgContextTraceEntryType::EvaluateEdge)
+		{
+			bHasEdge = true;
+			NumEdgesOfOtherNodes += IsEdgeOf(Entry.NodeIndex, Entry.TargetIndex) ? 0 : 1;
+		}
+	}
+	TestTrue(TEXT("Recorded the node enters"), bHasEnterNode);
+	TestTrue(TEXT("Recorded the edge evaluations"), bHasEdge);
+	TestEqual(TEXT("Edges are recorded with the node they belong to"), NumEdgesOfOtherNodes, 0);
+
+	TSharedPtr<FJsonObject> Root;
+	const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Context->GetTraceAsJsonString());
+	if (TestTrue(TEXT("Trace JSON is valid"), FJsonSerializer::Deserialize(Reader, Root) && Root.IsValid()))
+	{
+		TestEqual(TEXT("JSON has every entry"), Root->GetArrayField(TEXT("Entries")).Num(), ContextTrace->Num());
+	}
+
+	Context->DisableTrace();
+	TestFalse(TEXT("Trace disabled"), Context->IsTraceEnabled());
+	TestTrue(TEXT("Disabled trace JSON is empty"), Context->GetTraceAsJsonString().IsEmpty());
+
+	Context->RemoveFromRoot();
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS && DLG_WITH_CONTEXT_TRACE
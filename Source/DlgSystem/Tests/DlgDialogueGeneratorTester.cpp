@@ -0,0 +1,85 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+
+#include "CoreTypes.h"
+#include "Containers/Queue.h"
+#include "Misc/AutomationTest.h"
+
+#include "DlgSystem/DlgDialogue.h"
+#include "DlgSystem/DlgDialogueGenerator.h"
+#include "DlgSystem/Nodes/DlgNode_Proxy.h"
+#include "DlgSystem/Nodes/DlgNode_End.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgDialogueGeneratorAutomationTest,
+	"DlgSystem.Generator",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter
+)
+
+bool FDlgDialogueGeneratorAutomationTest::RunTest(const FString& Parameters)
+{
+	FDlgDialogueGeneratorOptions Options;
+	Options.NumNodes = 500;
+	Options.NumStartNodes = 2;
+	Options.NumParticipants = 3;
+	Options.ProxyRatio = 0.15f;
+	Options.EndRatio = 0.15f;
+
+	for (int32 Seed = 0; Seed < 8; Seed++)
+	{
+		Options.Seed = Seed;
+		const UDlgDialogue* Dialogue = FDlgDialogueGenerator::GenerateNewDialogue(Options);
+		const TArray<UDlgNode*>& Nodes = Dialogue->GetNodes();
+		TestEqual(TEXT("Number of nodes"), Nodes.Num(), Options.NumNodes);
+		TestEqual(TEXT("Number of start nodes"), Dialogue->GetStartNodes().Num(), Options.NumStartNodes);
+		TestTrue(TEXT("Has participants"), Dialogue->GetParticipantsData().Num() > 0);
+		TestTrue(TEXT("Last node is an end node"), Nodes.Last()->IsA<UDlgNode_End>());
+
+		// Same seed same dialogue
+		const UDlgDialogue* SameDialogue = FDlgDialogueGenerator::GenerateNewDialogue(Options);
+		for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); NodeIndex++)
+		{
+			if (Nodes[NodeIndex]->GetClass() != SameDialogue->GetNodes()[NodeIndex]->GetClass() ||
+				!(Nodes[NodeIndex]->GetNodeChildren() == SameDialogue->GetNodes()[NodeIndex]->GetNodeChildren()))
+			{
+				AddError(FString::Printf(TEXT("Seed = %d is not deterministic at node index = %d"), Seed, NodeIndex));
+				break;
+			}
+		}
+
+		// Every edge points to a valid node and every node is reachable from the first start node
+		TArray<bool> Visited;
+		Visited.SetNumZeroed(Nodes.Num());
+		TQueue<int32> Queue;
+		Queue.Enqueue(Dialogue->GetStartNodes()[0]->GetNodeChildren()[0].TargetIndex);
+		int32 NodeIndex;
+		while (Queue.Dequeue(NodeIndex))
+		{
+			if (!Nodes.IsValidIndex(NodeIndex))
+			{
+				AddError(FString::Printf(TEXT("Seed = %d has an invalid target index = %d"), Seed, NodeIndex));
+				continue;
+			}
+			if (Visited[NodeIndex])
+			{
+				continue;
+			}
+			Visited[NodeIndex] = true;
+
+			if (const UDlgNode_Proxy* Proxy = Cast<UDlgNode_Proxy>(Nodes[NodeIndex]))
+			{
+				Queue.Enqueue(Proxy->GetTargetNodeIndex());
+			}
+			for (const FDlgEdge& Edge : Nodes[NodeIndex]->GetNodeChildren())
+			{
+				Queue.Enqueue(Edge.TargetIndex);
+			}
+		}
+		TestFalse(FString::Printf(TEXT("Seed = %d every node is reachable"), Seed), Visited.Contains(false));
+	}
+
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,199 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+
+#include "CoreTypes.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+
+#include "DlgSystem/DlgContext.h"
+#include "DlgSystem/DlgDialogue.h"
+#include "DlgSystem/DlgDialogueGenerator.h"
+#include "DlgSystem/Nodes/DlgNode_Selector.h"
+
+#include "DlgBenchmarkTypes.h"
+
+// The cooked data only exists in the editor
+#if WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
+
+namespace DlgFoldForCook
+{
+	static constexpr int32 NumWalks = 16;
+	static constexpr int32 NumSteps = 32;
+
+	/**
+	 * HasSatisfiedChild conditions on the edges, the generator does not add any.
+	 * They only check nodes after their own node and the selectors (they check their children on evaluation) get none,
+	 * so the evaluation can not recurse forever. Some check a node past the last one, those are never satisfied.
+	 * A condition on node N depends on the folding of the nodes after N, which needs more than one pass.
+	 */
+	static void AddHasSatisfiedChildConditions(UDlgDialogue& Dialogue, int32 Seed)
+	{
+		FRandomStream Stream(Seed);
+		const TArray<UDlgNode*>& Nodes = Dialogue.GetNodes();
+		for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); NodeIndex++)
+		{
+			UDlgNode* Node = Nodes[NodeIndex];
+			if (Node->IsA<UDlgNode_Selector>())
+			{
+				continue;
+			}
+
+			// The first edge keeps the graph connected, same as the generator
+			for (int32 EdgeIndex = 1; EdgeIndex < Node->GetNumNodeChildren(); EdgeIndex++)
+			{
+				if (Stream.FRand() < 0.5f)
+				{
+					continue;
+				}
+
+				FDlgCondition Condition;
+				Condition.ConditionType = EDlgConditionType::HasSatisfiedChild;
+				Condition.Strength = Stream.FRand() < 0.25f ? EDlgConditionStrength::Weak : EDlgConditionStrength::Strong;
+				Condition.bBoolValue = Stream.FRand() < 0.75f;
+				Condition.IntValue = Stream.RandRange(NodeIndex + 1, Nodes.Num());
+				Condition.GUID = Dialogue.GetNodeGUIDForIndex(Condition.IntValue);
+				Node->GetMutableNodeChildAt(EdgeIndex)->Conditions.Add(Condition);
+			}
+		}
+	}
+
+	static TArray<UDlgNode*> GetAllNodes(const UDlgDialogue& Dialogue)
+	{
+		TArray<UDlgNode*> AllNodes = Dialogue.GetNodes();
+		AllNodes.Append(Dialogue.GetStartNodes());
+		return AllNodes;
+	}
+
+	// Active node, option lists and the result of every edge of the dialogue after every step of every walk
+	static TArray<int32> Walk(FDlgBenchmarkFixture& Fixture)
+	{
+		const TArray<UDlgNode*> AllNodes = GetAllNodes(*Fixture.Dialogue);
+		FDlgBenchmarkWalkOptions Options;
+		Options.NumWalks = NumWalks;
+		Options.NumSteps = NumSteps;
+		return Fixture.Walk(Options, [&AllNodes](const UDlgContext& Context, TArray<int32>& Trace)
+		{
+			Trace.Add(Context.GetActiveNodeIndex());
+			for (const FDlgEdge& Edge : Context.GetOptionsArray())
+			{
+				Trace.Add(Edge.TargetIndex);
+			}
+			for (const FDlgEdgeData& EdgeData : Context.GetAllOptionsArray())
+			{
+				Trace.Add(EdgeData.GetEdge().TargetIndex);
+				Trace.Add(EdgeData.IsSatisfied() ? 1 : 0);
+			}
+			for (const UDlgNode* Node : AllNodes)
+			{
+				for (const FDlgEdge& Edge : Node->GetNodeChildren())
+				{
+					Trace.Add(Edge.Evaluate(Context, {}, Node) ? 1 : 0);
+				}
+			}
+		});
+	}
+
+	static int32 CountConditions(const UDlgNode& Node, TOptional<EDlgConditionType> ConditionType = {})
+	{
+		auto Count = [&ConditionType](const TArray<FDlgCondition>& Conditions)
+		{
+			int32 Num = 0;
+			for (const FDlgCondition& Condition : Conditions)
+			{
+				Num += !ConditionType.IsSet() || Condition.ConditionType == ConditionType.GetValue() ? 1 : 0;
+			}
+			return Num;
+		};
+
+		int32 Num = Count(Node.GetNodeEnterConditions());
+		for (const FDlgEdge& Edge : Node.GetNodeChildren())
+		{
+			Num += Count(Edge.Conditions);
+		}
+		return Num;
+	}
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgFoldForCookTest,
+	"DlgSystem.Dialogue.FoldForCook",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter
+)
+
+bool FDlgFoldForCookTest::RunTest(const FString& Parameters)
+{
+	using namespace DlgFoldForCook;
+
+	FDlgDialogueGeneratorOptions Options;
+	Options.Seed = FDlgBenchmarkFixture::DefaultSeed;
+	Options.NumNodes = 100;
+	Options.ConditionDensity = 0.5f;
+	// See AddHasSatisfiedChildConditions, a speech node checking its children could recurse forever
+	Options.CheckChildrenOnEvaluationRatio = 0.f;
+	FDlgBenchmarkFixture Fixture(Options);
+	AddHasSatisfiedChildConditions(*Fixture.Dialogue, Options.Seed);
+	const TArray<UDlgNode*> AllNodes = GetAllNodes(*Fixture.Dialogue);
+
+	const TArray<int32> Expected = Walk(Fixture);
+	int32 NumConditionsBefore = 0;
+	int32 NumHasSatisfiedChildBefore = 0;
+	for (const UDlgNode* Node : AllNodes)
+	{
+		NumConditionsBefore += CountConditions(*Node);
+		NumHasSatisfiedChildBefore += CountConditions(*Node, EDlgConditionType::HasSatisfiedChild);
+	}
+
+	// Same swap as UDlgNode::Serialize while saving the cooked package
+	Fixture.Dialogue->FoldConstantConditionsForCook(true);
+	int32 NumWithoutCookedData = 0;
+	for (UDlgNode* Node : AllNodes)
+	{
+		NumWithoutCookedData += Node->HasCookedData() ? 0 : 1;
+		Node->SwapCookedData();
+	}
+	TestEqual(TEXT("Every node has cooked data"), NumWithoutCookedData, 0);
+
+	int32 NumConditionsAfter = 0;
+	int32 NumHasSatisfiedChildAfter = 0;
+	int32 NumAlwaysSatisfiedEdges = 0;
+	for (const UDlgNode* Node : AllNodes)
+	{
+		NumConditionsAfter += CountConditions(*Node);
+		NumHasSatisfiedChildAfter += CountConditions(*Node, EDlgConditionType::HasSatisfiedChild);
+		for (const FDlgEdge& Edge : Node->GetNodeChildren())
+		{
+			NumAlwaysSatisfiedEdges += Edge.bAlwaysSatisfied ? 1 : 0;
+		}
+	}
+	TestTrue(TEXT("Some HasSatisfiedChild conditions are folded"), NumHasSatisfiedChildAfter < NumHasSatisfiedChildBefore);
+	TestTrue(TEXT("Fewer conditions are cooked"), NumConditionsAfter < NumConditionsBefore);
+	TestTrue(TEXT("Some edges are always satisfied"), NumAlwaysSatisfiedEdges > 0);
+	TestTrue(TEXT("Same walks and edge results with the cooked data"), Walk(Fixture) == Expected);
+
+	// Back to the authored data
+	for (UDlgNode* Node : AllNodes)
+	{
+		Node->SwapCookedData();
+	}
+	Fixture.Dialogue->FoldConstantConditionsForCook(false);
+	int32 NumWithCookedData = 0;
+	int32 NumConditionsAuthored = 0;
+	NumAlwaysSatisfiedEdges = 0;
+	for (const UDlgNode* Node : AllNodes)
+	{
+		NumWithCookedData += Node->HasCookedData() ? 1 : 0;
+		NumConditionsAuthored += CountConditions(*Node);
+		for (const FDlgEdge& Edge : Node->GetNodeChildren())
+		{
+			NumAlwaysSatisfiedEdges += Edge.bAlwaysSatisfied ? 1 : 0;
+		}
+	}
+	TestEqual(TEXT("Cooked data is reset"), NumWithCookedData, 0);
+	TestEqual(TEXT("Authored conditions are not modified"), NumConditionsAuthored, NumConditionsBefore);
+	TestEqual(TEXT("Authored edges are never always satisfied"), NumAlwaysSatisfiedEdges, 0);
+	TestTrue(TEXT("Same walks with the authored data"), Walk(Fixture) == Expected);
+
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
@@ -9,6 +9,8 @@
 #include "DlgSystem/IO/DlgConfigParser.h"
 #include "DlgSystem/IO/DlgJsonParser.h"
 #include "DlgSystem/IO/DlgJsonWriter.h"
+#include "DlgSystem/IO/DlgBinaryWriter.h"
+#include "DlgSystem/IO/DlgBinaryParser.h"
 
 DECLARE_LOG_CATEGORY_EXTERN(LogDlgIOTester, All, All);
 DEFINE_LOG_CATEGORY(LogDlgIOTester);
@@ -38,6 +40,17 @@ public:
 		const FString NameWriterType = FString(),
 		const FString NameParserType = FString()
 	);
+
+	// Text formats are read back from the written string, the binary format from the written bytes
+	static void InitializeParserFromWriter(IDlgParser& Parser, const IDlgWriter& Writer)
+	{
+		Parser.InitializeParserFromString(Writer.GetAsString());
+	}
+	static void InitializeParserFromWriter(FDlgBinaryParser& Parser, const FDlgBinaryWriter& Writer)
+	{
+		TArray<uint8> Bytes = Writer.GetAsBytes();
+		Parser.InitializeParserFromBytes(MoveTemp(Bytes));
+	}
 };
 
 
@@ -90,7 +103,7 @@ bool FDlgIOTester::TestStruct(
 	// Read struct
 	ConfigParserType Parser;
 	//Parser.SetLogVerbose(true);
-	Parser.InitializeParserFromString(WriterString);
+	InitializeParserFromWriter(Parser, Writer);
 	Parser.ReadAllProperty(StructType::StaticStruct(), &ImportedStruct);
 
 	// Should be the same
@@ -139,6 +152,9 @@ bool FDlgIOTester::TestAllParsers(FAutomationTestBase& Test)
 	Options.bSupportsUObjectValueInMap = false;
 	bAllSucceeded &= TestParser<FDlgConfigWriter, FDlgConfigParser>(Test, Options, TEXT("FDlgConfigWriter"), TEXT("FDlgConfigParser"));
 
+	Options = {};
+	bAllSucceeded &= TestParser<FDlgBinaryWriter, FDlgBinaryParser>(Test, Options, TEXT("FDlgBinaryWriter"), TEXT("FDlgBinaryParser"));
+
 	return bAllSucceeded;
 }
 
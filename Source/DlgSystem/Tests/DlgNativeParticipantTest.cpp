@@ -0,0 +1,108 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+
+#include "CoreTypes.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+
+#include "DlgSystem/DlgCondition.h"
+#include "DlgSystem/DlgConditionProgram.h"
+#include "DlgSystem/DlgContext.h"
+#include "DlgSystem/DlgDialogue.h"
+#include "DlgSystem/DlgManager.h"
+
+#include "DlgBenchmarkTypes.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace DlgNativeParticipant
+{
+	static FDlgCondition Make(EDlgConditionType ConditionType, const FGameplayTag& ParticipantTag, EDlgConditionStrength Strength = EDlgConditionStrength::Strong)
+	{
+		FDlgCondition Condition;
+		Condition.Strength = Strength;
+		Condition.ConditionType = ConditionType;
+		Condition.ParticipantTag = ParticipantTag;
+		Condition.CallbackName = TEXT("Value");
+		Condition.IntValue = 5;
+		Condition.FloatValue = 5.0;
+		Condition.NameValue = TEXT("Value");
+		return Condition;
+	}
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgNativeParticipantTest,
+	"DlgSystem.Conditions.NativeParticipant",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter
+)
+
+bool FDlgNativeParticipantTest::RunTest(const FString& Parameters)
+{
+	using namespace DlgNativeParticipant;
+
+	FDlgBenchmarkFixture Fixture(20, 1);
+	const FGameplayTag ParticipantTag = Fixture.Dialogue->GetParticipantTags().First();
+	UDlgBenchmarkNativeParticipant* Native = NewObject<UDlgBenchmarkNativeParticipant>(GetTransientPackage(), NAME_None, RF_Transient);
+	Native->SetParticipantTag(ParticipantTag);
+	Native->AddToRoot();
+
+	const UDlgContext* BlueprintContext = Fixture.StartDialogue();
+	const UDlgContext* NativeContext = UDlgManager::StartDialogue(Fixture.Dialogue, { Native });
+	if (!TestNotNull(TEXT("Blueprint Context"), BlueprintContext) || !TestNotNull(TEXT("Native Context"), NativeContext))
+	{
+		Native->RemoveFromRoot();
+		return false;
+	}
+
+	FDlgCondition Event = Make(EDlgConditionType::EventCall, ParticipantTag);
+	FDlgCondition Bool = Make(EDlgConditionType::BoolCall, ParticipantTag);
+	FDlgCondition Int = Make(EDlgConditionType::IntCall, ParticipantTag);
+	FDlgCondition Float = Make(EDlgConditionType::FloatCall, ParticipantTag);
+	Float.Operation = EDlgOperation::Greater;
+	Float.FloatValue = 4.0;
+	FDlgCondition Name = Make(EDlgConditionType::NameCall, ParticipantTag);
+	FDlgCondition NotBool = Make(EDlgConditionType::BoolCall, ParticipantTag, EDlgConditionStrength::Weak);
+	NotBool.bBoolValue = false;
+	FDlgCondition IntToVariable = Make(EDlgConditionType::IntCall, ParticipantTag, EDlgConditionStrength::Weak);
+	IntToVariable.CompareType = EDlgCompare::ToVariable;
+	IntToVariable.OtherParticipantTag = ParticipantTag;
+	IntToVariable.OtherVariableName = TEXT("Other");
+	FDlgCondition WrongName = Make(EDlgConditionType::NameCall, ParticipantTag);
+	WrongName.NameValue = TEXT("Wrong");
+
+	const TArray<TArray<FDlgCondition>> ConditionArrays = {
+		{ Event, Bool, Int, Float, Name },
+		{ Event, NotBool },
+		{ Int, NotBool, IntToVariable },
+		{ Float, WrongName },
+		{ NotBool }
+	};
+	for (int32 ArrayIndex = 0; ArrayIndex < ConditionArrays.Num(); ArrayIndex++)
+	{
+		const TArray<FDlgCondition>& Conditions = ConditionArrays[ArrayIndex];
+		const bool bExpected = FDlgCondition::EvaluateArray(*BlueprintContext, Conditions);
+		TestEqual(FString::Printf(TEXT("Array %d in order"), ArrayIndex), FDlgCondition::EvaluateArray(*NativeContext, Conditions), bExpected);
+
+		TSharedPtr<const FDlgConditionProgram> Program;
+		TestEqual(FString::Printf(TEXT("Array %d compiled"), ArrayIndex), FDlgConditionProgram::EvaluateCached(Program, *NativeContext, Conditions), bExpected);
+	}
+
+	// Every value of the array in one call, CheckCondition in its own call
+	Native->NumGetDialogueValuesCalls = 0;
+	Native->NumValuesRead = 0;
+	TestTrue(TEXT("Values are satisfied"), FDlgCondition::EvaluateArray(*NativeContext, ConditionArrays[0]));
+	TestEqual(TEXT("One call for the values and one for CheckCondition"), Native->NumGetDialogueValuesCalls, 2);
+	TestEqual(TEXT("Every value is read"), Native->NumValuesRead, ConditionArrays[0].Num());
+
+	// CheckCondition is skipped after a failing strong condition
+	Native->NumGetDialogueValuesCalls = 0;
+	Native->NumValuesRead = 0;
+	TestFalse(TEXT("Wrong name is not satisfied"), FDlgCondition::EvaluateArray(*NativeContext, { WrongName, Event }));
+	TestEqual(TEXT("CheckCondition is not called"), Native->NumValuesRead, 1);
+
+	Native->RemoveFromRoot();
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
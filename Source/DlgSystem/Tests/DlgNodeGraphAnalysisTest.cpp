@@ -0,0 +1,115 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+
+#include "CoreTypes.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+
+#include "DlgSystem/DlgConstants.h"
+#include "DlgSystem/DlgContext.h"
+#include "DlgSystem/DlgDialogue.h"
+#include "DlgSystem/Nodes/DlgNode_Selector.h"
+#include "DlgSystem/Nodes/DlgNode_Speech.h"
+#include "DlgSystem/Nodes/DlgNode_Start.h"
+
+#include "DlgBenchmarkTypes.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace DlgNodeGraphAnalysis
+{
+	static constexpr int32 NumWalks = 32;
+	static constexpr int32 NumSteps = 64;
+
+	// Start -> Node 0 (speech) -> Node 1 (selector) -> Node 2 (speech) -> Node 1, Node 3 (speech) is not reachable
+	static UDlgDialogue* MakeDialogue()
+	{
+		UDlgDialogue* Dialogue = NewObject<UDlgDialogue>(GetTransientPackage(), NAME_None, RF_Transient);
+		TArray<UDlgNode*> Nodes;
+		for (const int32 TargetIndex : { 1, INDEX_NONE, 1, 0 })
+		{
+			UDlgNode* Node = nullptr;
+			if (TargetIndex == INDEX_NONE)
+			{
+				Node = Dialogue->ConstructDialogueNode<UDlgNode_Selector>();
+				Node->AddNodeChild(FDlgEdge(2));
+			}
+			else
+			{
+				auto* Speech = Dialogue->ConstructDialogueNode<UDlgNode_Speech>();
+				Speech->SetNodeText(FText::FromString(TEXT("Speech")), {});
+				Speech->AddNodeChild(FDlgEdge(TargetIndex));
+				Node = Speech;
+			}
+			Node->SetNodeParticipantTag(TAG_Dlg_Hero);
+			Node->RegenerateGUID();
+			Nodes.Add(Node);
+		}
+
+		auto* StartNode = Dialogue->ConstructDialogueNode<UDlgNode_Start>();
+		StartNode->AddNodeChild(FDlgEdge(0));
+		StartNode->RegenerateGUID();
+
+		Dialogue->EmptyNodesGUIDToIndexMap();
+		Dialogue->SetNodes(Nodes);
+		Dialogue->SetStartNodes({ StartNode });
+		Dialogue->UpdateAndRefreshData(true);
+		return Dialogue;
+	}
+
+	// Active node and number of options after every step of every walk
+	static TArray<int32> Walk(FDlgBenchmarkFixture& Fixture)
+	{
+		FDlgBenchmarkWalkOptions Options;
+		Options.NumWalks = NumWalks;
+		Options.NumSteps = NumSteps;
+		return Fixture.Walk(Options, [](const UDlgContext& Context, TArray<int32>& Trace)
+		{
+			Trace.Add(Context.GetActiveNodeIndex());
+			Trace.Add(Context.GetOptionsNum());
+		});
+	}
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgNodeGraphAnalysisTest,
+	"DlgSystem.Dialogue.NodeGraphAnalysis",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter
+)
+
+bool FDlgNodeGraphAnalysisTest::RunTest(const FString& Parameters)
+{
+	using namespace DlgNodeGraphAnalysis;
+
+	UDlgDialogue* Dialogue = MakeDialogue();
+	const TArray<UDlgNode*>& Nodes = Dialogue->GetNodes();
+	TestFalse(TEXT("Node 0 can not be reached again"), Nodes[0]->IsInEvaluationCycle());
+	TestFalse(TEXT("Selector can not be reached again, Node 2 does not check its children"), Nodes[1]->IsInEvaluationCycle());
+	TestTrue(TEXT("Node 2 is reached again through the selector"), Nodes[2]->IsInEvaluationCycle());
+	TestTrue(TEXT("Node 3 is the only unreachable node"), Dialogue->GetUnreachableNodeIndices() == TArray<int32>({ 3 }));
+
+	// Every mutable access to the children can add a cycle
+	Nodes[0]->GetMutableNodeChildAt(0);
+	TestTrue(TEXT("GetMutableNodeChildAt tracks the node again"), Nodes[0]->IsInEvaluationCycle());
+	Nodes[1]->GetMutableNodeChildForTargetIndex(Nodes[1]->GetNodeChildAt(0).TargetIndex);
+	TestTrue(TEXT("GetMutableNodeChildForTargetIndex tracks the node again"), Nodes[1]->IsInEvaluationCycle());
+	Nodes[0]->SetInEvaluationCycle(false);
+	Nodes[0]->RemoveChildAt(Nodes[0]->GetNumNodeChildren() - 1);
+	TestTrue(TEXT("RemoveChildAt tracks the node again"), Nodes[0]->IsInEvaluationCycle());
+
+	// Tracking every node must not change anything
+	FDlgBenchmarkFixture Fixture(200);
+	const TArray<int32> Expected = Walk(Fixture);
+	int32 NumInEvaluationCycle = 0;
+	for (UDlgNode* Node : Fixture.Dialogue->GetNodes())
+	{
+		NumInEvaluationCycle += Node->IsInEvaluationCycle() ? 1 : 0;
+		Node->SetInEvaluationCycle(true);
+	}
+	TestTrue(TEXT("Some nodes are not tracked"), NumInEvaluationCycle < Fixture.Dialogue->GetNodes().Num());
+	TestTrue(TEXT("Same walks when every node is tracked"), Walk(Fixture) == Expected);
+
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,50 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+
+#include "CoreTypes.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+#include "Engine/BlueprintGeneratedClass.h"
+
+#include "DlgSystem/DlgConstants.h"
+#include "DlgSystem/DlgManager.h"
+#include "DlgSystem/NYEngineVersionHelpers.h"
+
+#include "DlgBenchmarkTypes.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgParticipantClassesIndexTest,
+	"DlgSystem.Manager.ParticipantClassesIndex",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter
+)
+
+bool FDlgParticipantClassesIndexTest::RunTest(const FString& Parameters)
+{
+	const FGameplayTag ParticipantTag = TAG_Dlg_Critter;
+
+	// Builds the index
+	if (UDlgManager::GetDefaultParticipantClass(ParticipantTag) != nullptr)
+	{
+		AddWarning(FString::Printf(TEXT("A participant class with the tag `%s` already exists, nothing to test"), *ParticipantTag.ToString()));
+		return true;
+	}
+
+	// Same as a blueprint participant class loaded after the index was built
+	UBlueprintGeneratedClass* Class = NewObject<UBlueprintGeneratedClass>(GetTransientPackage(), TEXT("DlgLateParticipant_C"), RF_Public | RF_Transient);
+	Class->SetSuperStruct(UDlgBenchmarkParticipant::StaticClass());
+	Class->Bind();
+	Class->StaticLink(true);
+#if NY_ENGINE_VERSION < 504
+	Class->AssembleReferenceTokenStream(true);
+#endif
+	CastChecked<UDlgBenchmarkParticipant>(Class->GetDefaultObject())->SetParticipantTag(ParticipantTag);
+
+	TestTrue(TEXT("Class loaded later is in the index"), UDlgManager::GetDefaultParticipantClass(ParticipantTag) == Class);
+
+	// The class is garbage collected, it is not referenced by anything
+	UDlgManager::InvalidateParticipantClassesIndex();
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,87 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+
+#include "CoreTypes.h"
+#include "Misc/AutomationTest.h"
+
+#include "DlgSystem/DlgCondition.h"
+#include "DlgSystem/DlgContext.h"
+#include "DlgSystem/DlgDialogue.h"
+#include "DlgSystem/DlgEvent.h"
+#include "DlgSystem/DlgSystemSettings.h"
+
+#include "DlgBenchmarkTypes.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgParticipantValueCacheTest,
+	"DlgSystem.Context.ParticipantValueCache",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter
+)
+
+bool FDlgParticipantValueCacheTest::RunTest(const FString& Parameters)
+{
+	FDlgBenchmarkFixture Fixture(20, 1);
+	UDlgContext* Context = Fixture.StartDialogue();
+	if (!TestNotNull(TEXT("Context"), Context))
+	{
+		return false;
+	}
+
+	UDlgBenchmarkParticipant* Participant = CastChecked<UDlgBenchmarkParticipant>(Fixture.Participants[0]);
+	const FGameplayTag ParticipantTag = Participant->ParticipantTag;
+
+	FDlgCondition IntCall;
+	IntCall.ConditionType = EDlgConditionType::IntCall;
+	IntCall.ParticipantTag = ParticipantTag;
+	IntCall.CallbackName = TEXT("Value");
+	IntCall.IntValue = 5;
+	const TArray<FDlgCondition> Conditions = { IntCall, IntCall, IntCall };
+
+	auto CountReads = [&]()
+	{
+		Participant->NumGetIntValueCalls = 0;
+		TestTrue(TEXT("Conditions are satisfied"), FDlgCondition::EvaluateArray(*Context, Conditions));
+		return Participant->NumGetIntValueCalls;
+	};
+
+	UDlgSystemSettings* Settings = GetMutableDefault<UDlgSystemSettings>();
+	const bool bOldCacheParticipantValuesPerStep = Settings->bCacheParticipantValuesPerStep;
+	const TArray<FName> OldVolatileParticipantValues = Settings->VolatileParticipantValues;
+	Settings->bCacheParticipantValuesPerStep = true;
+	Settings->VolatileParticipantValues.Reset();
+
+	TestEqual(TEXT("Every value is read outside of a step"), CountReads(), Conditions.Num());
+
+	Context->BeginStep();
+	TestEqual(TEXT("Value is read once per step"), CountReads(), 1);
+	TestEqual(TEXT("Value is cached for the rest of the step"), CountReads(), 0);
+
+	Context->InvalidateParticipantValueCache();
+	TestEqual(TEXT("Value is read again after invalidating"), CountReads(), 1);
+
+	FDlgEvent ModifyInt;
+	ModifyInt.EventType = EDlgEventType::ModifyInt;
+	ModifyInt.ParticipantTag = ParticipantTag;
+	ModifyInt.EventName = TEXT("Value");
+	ModifyInt.Call(*Context, TEXT("ParticipantValueCacheTest"), Participant);
+	TestEqual(TEXT("Value is read again after an event"), CountReads(), 1);
+	Context->EndStep();
+
+	Settings->VolatileParticipantValues.Add(TEXT("Value"));
+	Context->BeginStep();
+	TestEqual(TEXT("Volatile value is never cached"), CountReads(), Conditions.Num());
+	Context->EndStep();
+	Settings->VolatileParticipantValues.Reset();
+
+	Settings->bCacheParticipantValuesPerStep = false;
+	Context->BeginStep();
+	TestEqual(TEXT("Nothing is cached if disabled"), CountReads(), Conditions.Num());
+	Context->EndStep();
+
+	Settings->bCacheParticipantValuesPerStep = bOldCacheParticipantValuesPerStep;
+	Settings->VolatileParticipantValues = OldVolatileParticipantValues;
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,122 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+
+#include "CoreTypes.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+
+#include "DlgSystem/DlgConstants.h"
+#include "DlgSystem/DlgContext.h"
+#include "DlgSystem/DlgDialogue.h"
+#include "DlgSystem/DlgManager.h"
+#include "DlgSystem/DlgMemory.h"
+#include "DlgSystem/Nodes/DlgNode_Proxy.h"
+#include "DlgSystem/Nodes/DlgNode_Speech.h"
+#include "DlgSystem/Nodes/DlgNode_Start.h"
+
+#include "DlgBenchmarkTypes.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace DlgProxyChain
+{
+	// Start -> Node 0 (proxy) -> Node 1 (proxy) -> Node 2 (proxy) -> Node 3 (speech), Node 4 and 5 are proxies pointing to each other
+	static UDlgDialogue* MakeDialogue()
+	{
+		UDlgDialogue* Dialogue = NewObject<UDlgDialogue>(GetTransientPackage(), NAME_None, RF_Transient);
+		TArray<UDlgNode*> Nodes;
+		for (const int32 TargetIndex : { 1, 2, 3 })
+		{
+			auto* Proxy = Dialogue->ConstructDialogueNode<UDlgNode_Proxy>();
+			Proxy->SetTargetNodeIndex(TargetIndex);
+			Nodes.Add(Proxy);
+		}
+
+		auto* Speech = Dialogue->ConstructDialogueNode<UDlgNode_Speech>();
+		Speech->SetNodeText(FText::FromString(TEXT("Final")), {});
+		Speech->AddNodeChild(FDlgEdge(0));
+		Nodes.Add(Speech);
+
+		for (const int32 TargetIndex : { 5, 4 })
+		{
+			auto* Proxy = Dialogue->ConstructDialogueNode<UDlgNode_Proxy>();
+			Proxy->SetTargetNodeIndex(TargetIndex);
+			Nodes.Add(Proxy);
+		}
+
+		for (UDlgNode* Node : Nodes)
+		{
+			Node->SetNodeParticipantTag(TAG_Dlg_Hero);
+			Node->RegenerateGUID();
+		}
+
+		auto* StartNode = Dialogue->ConstructDialogueNode<UDlgNode_Start>();
+		StartNode->AddNodeChild(FDlgEdge(0));
+		StartNode->RegenerateGUID();
+
+		Dialogue->EmptyNodesGUIDToIndexMap();
+		Dialogue->SetNodes(Nodes);
+		Dialogue->SetStartNodes({ StartNode });
+		Dialogue->UpdateAndRefreshData(true);
+		return Dialogue;
+	}
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgProxyChainTest,
+	"DlgSystem.Nodes.ProxyChain",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter
+)
+
+bool FDlgProxyChainTest::RunTest(const FString& Parameters)
+{
+	AddExpectedError(TEXT("part of a cycle of proxies"), EAutomationExpectedErrorFlags::Contains, 0);
+	UDlgDialogue* Dialogue = DlgProxyChain::MakeDialogue();
+	Dialogue->AddToRoot();
+
+	const auto* First = CastChecked<UDlgNode_Proxy>(Dialogue->GetNodes()[0]);
+	TestTrue(TEXT("Chain is resolved"), First->HasResolvedProxyChain());
+	TestEqual(TEXT("Resolved node"), First->GetResolvedNodeIndex(), 3);
+	TestTrue(TEXT("Proxies in between"), First->GetResolvedProxyChain() == TArray<int32>({ 1, 2 }));
+
+	const auto* Last = CastChecked<UDlgNode_Proxy>(Dialogue->GetNodes()[2]);
+	TestEqual(TEXT("Last proxy of the chain resolves to its target"), Last->GetResolvedNodeIndex(), 3);
+	TestEqual(TEXT("Last proxy of the chain has nothing in between"), Last->GetResolvedProxyChain().Num(), 0);
+
+	TestFalse(TEXT("Cycle is not resolved"), CastChecked<UDlgNode_Proxy>(Dialogue->GetNodes()[4])->HasResolvedProxyChain());
+
+	UDlgBenchmarkParticipant* Participant = NewObject<UDlgBenchmarkParticipant>(GetTransientPackage(), NAME_None, RF_Transient);
+	Participant->SetParticipantTag(TAG_Dlg_Hero);
+	UDlgContext* Context = UDlgManager::StartDialogue(Dialogue, { Participant });
+	if (TestNotNull(TEXT("Context"), Context))
+	{
+		TestEqual(TEXT("Active node is the end of the chain"), Context->GetActiveNodeIndex(), 3);
+		for (int32 NodeIndex = 0; NodeIndex <= 3; NodeIndex++)
+		{
+			TestTrue(FString::Printf(TEXT("Node %d is visited"), NodeIndex), Context->WasNodeIndexVisitedInThisContext(NodeIndex));
+		}
+
+		// Back to the start of the chain
+		TestTrue(TEXT("Option leading to the chain"), Context->ChooseOption(0));
+		TestEqual(TEXT("Active node after choosing the option"), Context->GetActiveNodeIndex(), 3);
+	}
+
+	// Written without SetTargetNodeIndex, the chain of node 0 still has node 2 in it
+	UDlgNode_Proxy* Middle = CastChecked<UDlgNode_Proxy>(Dialogue->GetNodes()[1]);
+	FIntProperty* NodeIndexProperty = FindFProperty<FIntProperty>(UDlgNode_Proxy::StaticClass(), UDlgNode_Proxy::GetMemberNameNodeIndex());
+	NodeIndexProperty->SetPropertyValue_InContainer(Middle, 3);
+	FDlgMemory::Get().Empty();
+	Context = UDlgManager::StartDialogue(Dialogue, { Participant });
+	if (TestNotNull(TEXT("Context after the target changed"), Context))
+	{
+		TestEqual(TEXT("Active node after the target changed"), Context->GetActiveNodeIndex(), 3);
+		TestTrue(TEXT("Changed proxy is visited"), Context->WasNodeIndexVisitedInThisContext(1));
+		TestFalse(TEXT("Proxy no longer in the chain is not visited"), Context->WasNodeIndexVisitedInThisContext(2));
+	}
+
+	FDlgMemory::Get().Empty();
+	Dialogue->RemoveFromRoot();
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,547 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+
+#include "CoreTypes.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+
+#include "DlgSystem/DlgCondition.h"
+#include "DlgSystem/DlgConditionProgram.h"
+#include "DlgSystem/DlgConstants.h"
+#include "DlgSystem/DlgContext.h"
+#include "DlgSystem/DlgDialogue.h"
+#include "DlgSystem/DlgEvent.h"
+#include "DlgSystem/DlgManager.h"
+#include "DlgSystem/DlgMemory.h"
+#include "DlgSystem/NYReflectionHelper.h"
+#include "DlgSystem/Nodes/DlgNode_Selector.h"
+#include "DlgSystem/Nodes/DlgNode_Speech.h"
+#include "DlgSystem/Nodes/DlgNode_Start.h"
+#include "DlgSystem/IO/DlgConfigParser.h"
+#include "DlgSystem/IO/DlgConfigWriter.h"
+#include "DlgSystem/IO/DlgJsonParser.h"
+#include "DlgSystem/IO/DlgJsonWriter.h"
+
+#include "DlgBenchmarkReport.h"
+#include "DlgBenchmarkTypes.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgConditionBenchmarkTest,
+	"DlgSystem.Benchmarks.Conditions",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter
+)
+
+bool FDlgConditionBenchmarkTest::RunTest(const FString& Parameters)
+{
+	static constexpr int64 Iterations = 200000;
+
+	FDlgBenchmarkFixture Fixture(100);
+	const UDlgContext* Context = Fixture.StartDialogue();
+	if (!TestNotNull(TEXT("Context"), Context))
+	{
+		return false;
+	}
+
+	const FGameplayTag ParticipantTag = Fixture.Dialogue->GetParticipantTags().First();
+	FDlgMemory::Get().SetNodeVisited(Fixture.Dialogue->GetGUID(), 0, Fixture.Dialogue->GetNodes()[0]->GetGUID());
+
+	FDlgBenchmarkReport Report(TEXT("Conditions"));
+	int64 NumSatisfied = 0;
+	for (int32 TypeIndex = 0; TypeIndex <= static_cast<int32>(EDlgConditionType::Custom); TypeIndex++)
+	{
+		const EDlgConditionType ConditionType = static_cast<EDlgConditionType>(TypeIndex);
+
+		FDlgCondition Condition;
+		Condition.ConditionType = ConditionType;
+		Condition.ParticipantTag = ParticipantTag;
+		Condition.CallbackName = TEXT("Value");
+		Condition.IntValue = 5;
+		Condition.FloatValue = 5.0;
+		Condition.NameValue = TEXT("Value");
+		switch (ConditionType)
+		{
+			case EDlgConditionType::ClassIntVariable:
+				Condition.CallbackName = GET_MEMBER_NAME_CHECKED(UDlgBenchmarkParticipant, IntVariable);
+				break;
+			case EDlgConditionType::ClassFloatVariable:
+				Condition.CallbackName = GET_MEMBER_NAME_CHECKED(UDlgBenchmarkParticipant, FloatVariable);
+				break;
+			case EDlgConditionType::ClassBoolVariable:
+				Condition.CallbackName = GET_MEMBER_NAME_CHECKED(UDlgBenchmarkParticipant, bBoolVariable);
+				break;
+			case EDlgConditionType::ClassNameVariable:
+				Condition.CallbackName = GET_MEMBER_NAME_CHECKED(UDlgBenchmarkParticipant, NameVariable);
+				break;
+			case EDlgConditionType::WasNodeVisited:
+			case EDlgConditionType::HasSatisfiedChild:
+				Condition.IntValue = 0;
+				break;
+			case EDlgConditionType::Custom:
+				Condition.CustomCondition = NewObject<UDlgBenchmarkConditionCustom>(GetTransientPackage(), NAME_None, RF_Transient);
+				break;
+			default:
+				break;
+		}
+
+		const TArray<FDlgCondition> Conditions = { Condition };
+		Report.Run(FDlgCondition::ConditionTypeToString(ConditionType), Iterations, [&]()
+		{
+			NumSatisfied += FDlgCondition::EvaluateArray(*Context, Conditions) ? 1 : 0;
+		});
+	}
+
+	TestTrue(TEXT("Some conditions are satisfied"), NumSatisfied > 0);
+
+	// Mixed array authored expensive first, the compiled program runs the cheap failing WasNodeVisited first
+	{
+		FDlgCondition Custom;
+		Custom.ConditionType = EDlgConditionType::Custom;
+		Custom.ParticipantTag = ParticipantTag;
+		Custom.CustomCondition = NewObject<UDlgBenchmarkConditionCustom>(GetTransientPackage(), NAME_None, RF_Transient);
+
+		FDlgCondition IntCall;
+		IntCall.ConditionType = EDlgConditionType::IntCall;
+		IntCall.ParticipantTag = ParticipantTag;
+		IntCall.CallbackName = TEXT("Value");
+		IntCall.IntValue = 5;
+
+		// Node 0 is visited, this always fails
+		FDlgCondition NotVisited;
+		NotVisited.ConditionType = EDlgConditionType::WasNodeVisited;
+		NotVisited.IntValue = 0;
+		NotVisited.bBoolValue = false;
+
+		FDlgCondition WeakVisited;
+		WeakVisited.Strength = EDlgConditionStrength::Weak;
+		WeakVisited.ConditionType = EDlgConditionType::WasNodeVisited;
+		WeakVisited.IntValue = 0;
+
+		for (const bool bSatisfiable : { false, true })
+		{
+			TArray<FDlgCondition> Conditions = { Custom, IntCall, IntCall, WeakVisited };
+			if (!bSatisfiable)
+			{
+				Conditions.Add(NotVisited);
+			}
+
+			TSharedPtr<const FDlgConditionProgram> Program;
+			const bool bExpected = FDlgCondition::EvaluateArray(*Context, Conditions);
+			TestEqual(TEXT("Compiled conditions have the same result"), FDlgConditionProgram::EvaluateCached(Program, *Context, Conditions), bExpected);
+			TestEqual(TEXT("Result of the mixed conditions"), bExpected, bSatisfiable);
+
+			const FString Suffix = bSatisfiable ? TEXT(" Satisfied") : TEXT(" Unsatisfied");
+			Report.Run(TEXT("MixedInOrder") + Suffix, Iterations, [&]()
+			{
+				NumSatisfied += FDlgCondition::EvaluateArray(*Context, Conditions) ? 1 : 0;
+			});
+			Report.Run(TEXT("MixedCompiled") + Suffix, Iterations, [&]()
+			{
+				NumSatisfied += FDlgConditionProgram::EvaluateCached(Program, *Context, Conditions) ? 1 : 0;
+			});
+		}
+	}
+
+	return Report.Save();
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgEventBenchmarkTest,
+	"DlgSystem.Benchmarks.Events",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter
+)
+
+bool FDlgEventBenchmarkTest::RunTest(const FString& Parameters)
+{
+	static constexpr int64 Iterations = 200000;
+
+	FDlgBenchmarkFixture Fixture(100);
+	UDlgContext* Context = Fixture.StartDialogue();
+	if (!TestNotNull(TEXT("Context"), Context))
+	{
+		return false;
+	}
+
+	UDlgBenchmarkParticipant* Participant = CastChecked<UDlgBenchmarkParticipant>(Fixture.Participants[0]);
+	FDlgBenchmarkReport Report(TEXT("Events"));
+	for (int32 TypeIndex = 0; TypeIndex <= static_cast<int32>(EDlgEventType::UnrealFunction); TypeIndex++)
+	{
+		const EDlgEventType EventType = static_cast<EDlgEventType>(TypeIndex);
+
+		FDlgEvent Event;
+		Event.EventType = EventType;
+		Event.ParticipantTag = Participant->ParticipantTag;
+		Event.EventName = TEXT("Value");
+		Event.IntValue = 1;
+		Event.FloatValue = 1.0;
+		Event.NameValue = TEXT("Value");
+		Event.bDelta = true;
+		Event.bValue = true;
+		switch (EventType)
+		{
+			case EDlgEventType::ModifyClassIntVariable:
+				Event.EventName = GET_MEMBER_NAME_CHECKED(UDlgBenchmarkParticipant, IntVariable);
+				break;
+			case EDlgEventType::ModifyClassFloatVariable:
+				Event.EventName = GET_MEMBER_NAME_CHECKED(UDlgBenchmarkParticipant, FloatVariable);
+				break;
+			case EDlgEventType::ModifyClassBoolVariable:
+				Event.EventName = GET_MEMBER_NAME_CHECKED(UDlgBenchmarkParticipant, bBoolVariable);
+				break;
+			case EDlgEventType::ModifyClassNameVariable:
+				Event.EventName = GET_MEMBER_NAME_CHECKED(UDlgBenchmarkParticipant, NameVariable);
+				break;
+			case EDlgEventType::Custom:
+				Event.CustomEvent = NewObject<UDlgBenchmarkEventCustom>(GetTransientPackage(), NAME_None, RF_Transient);
+				break;
+			case EDlgEventType::UnrealFunction:
+				Event.EventName = GET_FUNCTION_NAME_CHECKED(UDlgBenchmarkParticipant, BenchmarkFunction);
+				break;
+			default:
+				break;
+		}
+
+		Report.Run(FDlgEvent::EventTypeToString(EventType), Iterations, [&]()
+		{
+			Event.Call(*Context, TEXT("Benchmark"), Participant);
+		});
+	}
+
+	TestTrue(TEXT("Unreal function was called"), Participant->NumBenchmarkFunctionCalls > 0);
+	return Report.Save();
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgReflectionBenchmarkTest,
+	"DlgSystem.Benchmarks.Reflection",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter
+)
+
+bool FDlgReflectionBenchmarkTest::RunTest(const FString& Parameters)
+{
+	static constexpr int64 Iterations = 500000;
+
+	UDlgBenchmarkParticipant* Participant = NewObject<UDlgBenchmarkParticipant>(GetTransientPackage(), NAME_None, RF_Transient);
+	const FName IntName = GET_MEMBER_NAME_CHECKED(UDlgBenchmarkParticipant, IntVariable);
+	const FName FloatName = GET_MEMBER_NAME_CHECKED(UDlgBenchmarkParticipant, FloatVariable);
+	const FName BoolName = GET_MEMBER_NAME_CHECKED(UDlgBenchmarkParticipant, bBoolVariable);
+	const FName NameName = GET_MEMBER_NAME_CHECKED(UDlgBenchmarkParticipant, NameVariable);
+
+	FDlgBenchmarkReport Report(TEXT("Reflection"));
+	int64 Sum = 0;
+	Report.Run(TEXT("GetVariable.Int"), Iterations, [&]()
+	{
+		Sum += FNYReflectionHelper::GetVariable<FIntProperty, int32>(Participant, IntName);
+	});
+	Report.Run(TEXT("GetVariable.Float"), Iterations, [&]()
+	{
+		Sum += static_cast<int64>(FNYReflectionHelper::GetVariable<FDoubleProperty, double>(Participant, FloatName));
+	});
+	Report.Run(TEXT("GetVariable.Bool"), Iterations, [&]()
+	{
+		Sum += FNYReflectionHelper::GetVariable<FBoolProperty, bool>(Participant, BoolName) ? 1 : 0;
+	});
+	Report.Run(TEXT("GetVariable.Name"), Iterations, [&]()
+	{
+		Sum += FNYReflectionHelper::GetVariable<FNameProperty, FName>(Participant, NameName).IsNone() ? 0 : 1;
+	});
+	Report.Run(TEXT("SetVariable.Int"), Iterations, [&]()
+	{
+		FNYReflectionHelper::SetVariable<FIntProperty>(Participant, IntName, 5);
+	});
+	Report.Run(TEXT("ModifyVariable.Int"), Iterations, [&]()
+	{
+		FNYReflectionHelper::ModifyVariable<FIntProperty>(Participant, IntName, 0, true);
+	});
+
+	TestTrue(TEXT("Variables were read"), Sum > 0);
+	return Report.Save();
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgContextBenchmarkTest,
+	"DlgSystem.Benchmarks.Context",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter
+)
+
+bool FDlgContextBenchmarkTest::RunTest(const FString& Parameters)
+{
+	static constexpr int32 MaxSteps = 64;
+
+	FDlgBenchmarkReport Report(TEXT("Context"));
+	for (const int32 NumNodes : { 100, 1000 })
+	{
+		FDlgBenchmarkFixture Fixture(NumNodes);
+		const int64 Iterations = 200000 / NumNodes;
+
+		Report.Run(FString::Printf(TEXT("StartDialogue.%d"), NumNodes), Iterations, [&]()
+		{
+			Fixture.StartDialogue();
+			FDlgMemory::Get().Empty();
+		});
+
+		// Same seed for every run, so the same paths are walked
+		UDlgContext* Context = nullptr;
+		FRandomStream Stream(FDlgBenchmarkFixture::DefaultSeed);
+		int64 NumSteps = 0;
+		const double StartTime = FPlatformTime::Seconds();
+		for (int64 Walk = 0; Walk < Iterations; Walk++)
+		{
+			Context = Fixture.StartDialogue();
+			for (int32 Step = 0; Context && Step < MaxSteps && !Context->HasDialogueEnded() && Context->GetOptionsNum() > 0; Step++)
+			{
+				Context->ChooseOption(Stream.RandHelper(Context->GetOptionsNum()));
+				NumSteps++;
+			}
+			FDlgMemory::Get().Empty();
+		}
+		Report.AddResult(FString::Printf(TEXT("ChooseOption.%d"), NumNodes), NumSteps, FPlatformTime::Seconds() - StartTime);
+
+		Context = Fixture.StartDialogue();
+		if (TestNotNull(TEXT("Context"), Context))
+		{
+			Report.Run(FString::Printf(TEXT("ReevaluateOptions.%d"), NumNodes), Iterations * 10, [&]()
+			{
+				Context->ReevaluateOptions();
+			});
+		}
+		TestTrue(TEXT("Walked some steps"), NumSteps > 0);
+	}
+
+	return Report.Save();
+}
+
+
+namespace DlgSelectorBenchmark
+{
+	/**
+	 * Start -> root selector, every selector has Branching selector children down to Depth and the leaves are speech nodes
+	 * leading back to the root selector, so every step enters (and every reevaluation checks) the whole chain of selectors.
+	 * Only the last leaf of every selector is satisfied, the first satisfied selector has to look at all its children.
+	 */
+	static UDlgDialogue* MakeNestedSelectorDialogue(int32 Depth, int32 Branching, EDlgNodeSelectorType SelectorType)
+	{
+		UDlgDialogue* Dialogue = NewObject<UDlgDialogue>(GetTransientPackage(), NAME_None, RF_Transient);
+		TArray<UDlgNode*> Nodes;
+		auto AddNode = [&Nodes](UDlgNode* Node)
+		{
+			Node->SetNodeParticipantTag(TAG_Dlg_Hero);
+			Node->RegenerateGUID();
+			return Nodes.Add(Node);
+		};
+
+		auto* Root = Dialogue->ConstructDialogueNode<UDlgNode_Selector>();
+		Root->SetSelectorType(SelectorType);
+		TArray<int32> Level = { AddNode(Root) };
+		for (int32 LevelIndex = 0; LevelIndex < Depth; LevelIndex++)
+		{
+			const bool bLeaves = LevelIndex == Depth - 1;
+			TArray<int32> NextLevel;
+			for (const int32 ParentIndex : Level)
+			{
+				for (int32 ChildIndex = 0; ChildIndex < Branching; ChildIndex++)
+				{
+					UDlgNode* Node = nullptr;
+					if (bLeaves)
+					{
+						FDlgCondition Condition;
+						Condition.ConditionType = EDlgConditionType::IntCall;
+						Condition.ParticipantTag = TAG_Dlg_Hero;
+						Condition.CallbackName = TEXT("Value");
+						Condition.IntValue = ChildIndex == Branching - 1 ? 5 : 6;
+
+						auto* Speech = Dialogue->ConstructDialogueNode<UDlgNode_Speech>();
+						Speech->SetNodeText(FText::FromString(TEXT("Leaf")), {});
+						Speech->SetNodeEnterConditions({ Condition });
+						Speech->AddNodeChild(FDlgEdge(0));
+						Node = Speech;
+					}
+					else
+					{
+						auto* Selector = Dialogue->ConstructDialogueNode<UDlgNode_Selector>();
+						Selector->SetSelectorType(SelectorType);
+						Node = Selector;
+					}
+
+					const int32 NodeIndex = AddNode(Node);
+					Nodes[ParentIndex]->AddNodeChild(FDlgEdge(NodeIndex));
+					NextLevel.Add(NodeIndex);
+				}
+			}
+			Level = MoveTemp(NextLevel);
+		}
+
+		auto* StartNode = Dialogue->ConstructDialogueNode<UDlgNode_Start>();
+		StartNode->AddNodeChild(FDlgEdge(0));
+		StartNode->RegenerateGUID();
+
+		Dialogue->EmptyNodesGUIDToIndexMap();
+		Dialogue->SetNodes(Nodes);
+		Dialogue->SetStartNodes({ StartNode });
+		Dialogue->UpdateAndRefreshData(true);
+		return Dialogue;
+	}
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgSelectorBenchmarkTest,
+	"DlgSystem.Benchmarks.Selectors",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter
+)
+
+bool FDlgSelectorBenchmarkTest::RunTest(const FString& Parameters)
+{
+	static constexpr int64 Iterations = 2000;
+
+	UDlgBenchmarkParticipant* Participant = NewObject<UDlgBenchmarkParticipant>(GetTransientPackage(), NAME_None, RF_Transient);
+	Participant->SetParticipantTag(TAG_Dlg_Hero);
+	Participant->AddToRoot();
+
+	FDlgBenchmarkReport Report(TEXT("Selectors"));
+	for (const EDlgNodeSelectorType SelectorType : { EDlgNodeSelectorType::First, EDlgNodeSelectorType::Random })
+	{
+		const TCHAR* TypeName = SelectorType == EDlgNodeSelectorType::First ? TEXT("First") : TEXT("Random");
+		for (const int32 Depth : { 2, 3, 4 })
+		{
+			static constexpr int32 Branching = 4;
+			UDlgDialogue* Dialogue = DlgSelectorBenchmark::MakeNestedSelectorDialogue(Depth, Branching, SelectorType);
+			Dialogue->AddToRoot();
+
+			UDlgContext* Context = UDlgManager::StartDialogueWithRandomSeed(Dialogue, { Participant }, FDlgBenchmarkFixture::DefaultSeed);
+			if (TestNotNull(TEXT("Context"), Context))
+			{
+				Context->AddToRoot();
+				int64 NumLeaves = 0;
+				Report.Run(FString::Printf(TEXT("ChooseOption.%s.Depth%d"), TypeName, Depth), Iterations, [&]()
+				{
+					Context->ChooseOption(0);
+					const UDlgNode* ActiveNode = Context->GetActiveNode();
+					NumLeaves += ActiveNode && ActiveNode->IsA<UDlgNode_Speech>() ? 1 : 0;
+				});
+				Report.Run(FString::Printf(TEXT("ReevaluateOptions.%s.Depth%d"), TypeName, Depth), Iterations, [&]()
+				{
+					Context->ReevaluateOptions();
+				});
+				TestEqual(FString::Printf(TEXT("%s Depth = %d: every step ends on a leaf"), TypeName, Depth), NumLeaves, Iterations);
+				Context->RemoveFromRoot();
+			}
+
+			FDlgMemory::Get().Empty();
+			Dialogue->RemoveFromRoot();
+		}
+	}
+
+	Participant->RemoveFromRoot();
+	return Report.Save();
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgMemoryBenchmarkTest,
+	"DlgSystem.Benchmarks.Memory",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter
+)
+
+bool FDlgMemoryBenchmarkTest::RunTest(const FString& Parameters)
+{
+	static constexpr int64 Iterations = 500000;
+	static constexpr int32 NumDialogues = 256;
+	static constexpr int32 NumNodesPerDialogue = 1024;
+
+	// Own instance so the global memory is not touched
+	FDlgMemory Memory;
+	FRandomStream Stream(FDlgBenchmarkFixture::DefaultSeed);
+	TArray<FGuid> DialogueGUIDs;
+	TArray<FGuid> NodeGUIDs;
+	for (int32 DialogueIndex = 0; DialogueIndex < NumDialogues; DialogueIndex++)
+	{
+		DialogueGUIDs.Add(FGuid(Stream.GetUnsignedInt(), Stream.GetUnsignedInt(), Stream.GetUnsignedInt(), Stream.GetUnsignedInt()));
+	}
+	for (int32 NodeIndex = 0; NodeIndex < NumNodesPerDialogue; NodeIndex++)
+	{
+		NodeGUIDs.Add(FGuid(Stream.GetUnsignedInt(), Stream.GetUnsignedInt(), Stream.GetUnsignedInt(), Stream.GetUnsignedInt()));
+	}
+
+	FDlgBenchmarkReport Report(TEXT("Memory"));
+	Report.Run(TEXT("SetNodeVisited"), Iterations, [&]()
+	{
+		const int32 NodeIndex = Stream.RandHelper(NumNodesPerDialogue);
+		Memory.SetNodeVisited(DialogueGUIDs[Stream.RandHelper(NumDialogues)], NodeIndex, NodeGUIDs[NodeIndex]);
+	});
+
+	int64 NumVisited = 0;
+	Report.Run(TEXT("IsNodeVisited"), Iterations, [&]()
+	{
+		const int32 NodeIndex = Stream.RandHelper(NumNodesPerDialogue);
+		NumVisited += Memory.IsNodeVisited(DialogueGUIDs[Stream.RandHelper(NumDialogues)], NodeIndex, NodeGUIDs[NodeIndex]) ? 1 : 0;
+	});
+	Report.Run(TEXT("IsNodeIndexVisited"), Iterations, [&]()
+	{
+		NumVisited += Memory.IsNodeIndexVisited(DialogueGUIDs[Stream.RandHelper(NumDialogues)], Stream.RandHelper(NumNodesPerDialogue)) ? 1 : 0;
+	});
+	Report.Run(TEXT("IsNodeGUIDVisited"), Iterations, [&]()
+	{
+		NumVisited += Memory.IsNodeGUIDVisited(DialogueGUIDs[Stream.RandHelper(NumDialogues)], NodeGUIDs[Stream.RandHelper(NumNodesPerDialogue)]) ? 1 : 0;
+	});
+
+	TestTrue(TEXT("Some nodes are visited"), NumVisited > 0);
+	return Report.Save();
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgIOBenchmarkTest,
+	"DlgSystem.Benchmarks.IO",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter
+)
+
+bool FDlgIOBenchmarkTest::RunTest(const FString& Parameters)
+{
+	static constexpr int64 Iterations = 20;
+	static constexpr int32 NumNodes = 1000;
+
+	FDlgBenchmarkFixture Fixture(NumNodes);
+	const UDlgDialogue* Dialogue = Fixture.Dialogue;
+	FDlgBenchmarkReport Report(TEXT("IO"));
+
+	FString JsonString;
+	Report.Run(FString::Printf(TEXT("JsonWrite.%d"), NumNodes), Iterations, [&]()
+	{
+		FDlgJsonWriter Writer;
+		Writer.Write(Dialogue->GetClass(), Dialogue);
+		JsonString = Writer.GetAsString();
+	});
+	Report.Run(FString::Printf(TEXT("JsonParse.%d"), NumNodes), Iterations, [&]()
+	{
+		UDlgDialogue* Imported = NewObject<UDlgDialogue>(GetTransientPackage(), NAME_None, RF_Transient);
+		FDlgJsonParser Parser;
+		Parser.InitializeParserFromString(JsonString);
+		Parser.ReadAllProperty(Imported->GetClass(), Imported, Imported);
+	});
+
+	FString ConfigString;
+	Report.Run(FString::Printf(TEXT("ConfigWrite.%d"), NumNodes), Iterations, [&]()
+	{
+		FDlgConfigWriter Writer(TEXT("Dlg"));
+		Writer.Write(Dialogue->GetClass(), Dialogue);
+		ConfigString = Writer.GetAsString();
+	});
+	Report.Run(FString::Printf(TEXT("ConfigParse.%d"), NumNodes), Iterations, [&]()
+	{
+		UDlgDialogue* Imported = NewObject<UDlgDialogue>(GetTransientPackage(), NAME_None, RF_Transient);
+		FDlgConfigParser Parser(TEXT("Dlg"));
+		Parser.InitializeParserFromString(ConfigString);
+		Parser.ReadAllProperty(Imported->GetClass(), Imported, Imported);
+	});
+
+	TestFalse(TEXT("Json is written"), JsonString.IsEmpty());
+	TestFalse(TEXT("Config is written"), ConfigString.IsEmpty());
+	return Report.Save();
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
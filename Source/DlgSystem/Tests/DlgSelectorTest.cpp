@@ -0,0 +1,223 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+
+#include "CoreTypes.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+
+#include "DlgSystem/DlgConstants.h"
+#include "DlgSystem/DlgContext.h"
+#include "DlgSystem/DlgDialogue.h"
+#include "DlgSystem/DlgManager.h"
+#include "DlgSystem/DlgMemory.h"
+#include "DlgSystem/Nodes/DlgNode_End.h"
+#include "DlgSystem/Nodes/DlgNode_Selector.h"
+#include "DlgSystem/Nodes/DlgNode_Speech.h"
+#include "DlgSystem/Nodes/DlgNode_Start.h"
+
+#include "DlgBenchmarkTypes.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace DlgSelector
+{
+	static constexpr int32 SelectorIndex = 0;
+	static constexpr int32 BlockedIndex = 1;
+	static constexpr int32 EndIndex = 4;
+
+	// Start -> Node 0 (selector) -> Node 1 (blocked by its edge condition), Node 2, Node 3 (speeches) -> Node 4 (end)
+	static UDlgDialogue* MakeDialogue(EDlgNodeSelectorType SelectorType)
+	{
+		UDlgDialogue* Dialogue = NewObject<UDlgDialogue>(GetTransientPackage(), NAME_None, RF_Transient);
+		TArray<UDlgNode*> Nodes;
+
+		auto* Selector = Dialogue->ConstructDialogueNode<UDlgNode_Selector>();
+		Selector->SetSelectorType(SelectorType);
+
+		// Counted by UDlgBenchmarkParticipant::NumBenchmarkFunctionCalls
+		FDlgEvent EnterEvent;
+		EnterEvent.EventType = EDlgEventType::UnrealFunction;
+		EnterEvent.ParticipantTag = TAG_Dlg_Hero;
+		EnterEvent.EventName = GET_FUNCTION_NAME_CHECKED(UDlgBenchmarkParticipant, BenchmarkFunction);
+		Selector->SetNodeEnterEvents({ EnterEvent });
+
+		// The end node is never visited while the selector is entered
+		FDlgCondition NeverSatisfied;
+		NeverSatisfied.ConditionType = EDlgConditionType::WasNodeVisited;
+		NeverSatisfied.IntValue = EndIndex;
+		NeverSatisfied.bBoolValue = true;
+
+		FDlgEdge BlockedEdge(BlockedIndex);
+		BlockedEdge.Conditions.Add(NeverSatisfied);
+		Selector->AddNodeChild(BlockedEdge);
+		Selector->AddNodeChild(FDlgEdge(2));
+		Selector->AddNodeChild(FDlgEdge(3));
+		Nodes.Add(Selector);
+
+		for (int32 SpeechIndex = 1; SpeechIndex <= 3; SpeechIndex++)
+		{
+			auto* Speech = Dialogue->ConstructDialogueNode<UDlgNode_Speech>();
+			Speech->SetNodeText(FText::FromString(FString::Printf(TEXT("Speech %d"), SpeechIndex)), {});
+			Speech->AddNodeChild(FDlgEdge(EndIndex));
+			Nodes.Add(Speech);
+		}
+		Nodes.Add(Dialogue->ConstructDialogueNode<UDlgNode_End>());
+
+		for (UDlgNode* Node : Nodes)
+		{
+			Node->SetNodeParticipantTag(TAG_Dlg_Hero);
+			Node->RegenerateGUID();
+		}
+
+		auto* StartNode = Dialogue->ConstructDialogueNode<UDlgNode_Start>();
+		StartNode->AddNodeChild(FDlgEdge(SelectorIndex));
+		StartNode->RegenerateGUID();
+
+		Dialogue->EmptyNodesGUIDToIndexMap();
+		Dialogue->SetNodes(Nodes);
+		Dialogue->SetStartNodes({ StartNode });
+		Dialogue->UpdateAndRefreshData(true);
+		return Dialogue;
+	}
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgSelectorTest,
+	"DlgSystem.Nodes.Selector",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter
+)
+
+bool FDlgSelectorTest::RunTest(const FString& Parameters)
+{
+	using namespace DlgSelector;
+	static constexpr int32 NumSeeds = 16;
+
+	UDlgBenchmarkParticipant* Participant = NewObject<UDlgBenchmarkParticipant>(GetTransientPackage(), NAME_None, RF_Transient);
+	Participant->SetParticipantTag(TAG_Dlg_Hero);
+	Participant->AddToRoot();
+
+	// First satisfied child
+	{
+		UDlgDialogue* Dialogue = MakeDialogue(EDlgNodeSelectorType::First);
+		Dialogue->AddToRoot();
+		TestEqual(TEXT("First selector text"), Dialogue->GetNodes()[SelectorIndex]->GetNodeText().ToString(), FString(TEXT("First Satisfied")));
+
+		// Counted by UDlgBenchmarkParticipant::NumGetIntValueCalls, the child after the first satisfied one is never evaluated
+		FDlgCondition IntCall;
+		IntCall.ConditionType = EDlgConditionType::IntCall;
+		IntCall.ParticipantTag = TAG_Dlg_Hero;
+		IntCall.CallbackName = TEXT("Value");
+		IntCall.IntValue = 5;
+		Dialogue->GetNodes()[SelectorIndex]->GetMutableNodeChildAt(2)->Conditions.Add(IntCall);
+		Participant->NumGetIntValueCalls = 0;
+
+		const UDlgContext* Context = UDlgManager::StartDialogue(Dialogue, { Participant });
+		if (TestNotNull(TEXT("First selector context"), Context))
+		{
+			TestEqual(TEXT("First satisfied child is entered"), Context->GetActiveNodeIndex(), 2);
+			TestTrue(TEXT("Selector is visited"), Context->WasNodeIndexVisitedInThisContext(SelectorIndex));
+		}
+		TestEqual(TEXT("First selector fires its enter events"), Participant->NumBenchmarkFunctionCalls, 1);
+		TestEqual(TEXT("First selector stops at the first satisfied child"), Participant->NumGetIntValueCalls, 0);
+		Dialogue->RemoveFromRoot();
+	}
+
+	// Random satisfied child
+	{
+		UDlgDialogue* Dialogue = MakeDialogue(EDlgNodeSelectorType::Random);
+		Dialogue->AddToRoot();
+		TestTrue(TEXT("Random selector text"), Dialogue->GetNodes()[SelectorIndex]->GetNodeText().ToString().StartsWith(TEXT("Random Satisfied")));
+
+		Participant->NumBenchmarkFunctionCalls = 0;
+		TSet<int32> EnteredNodes;
+		for (int32 Seed = 0; Seed < NumSeeds; Seed++)
+		{
+			const UDlgContext* Context = UDlgManager::StartDialogueWithRandomSeed(Dialogue, { Participant }, Seed);
+			if (TestNotNull(TEXT("Random selector context"), Context))
+			{
+				EnteredNodes.Add(Context->GetActiveNodeIndex());
+			}
+		}
+		TestFalse(TEXT("Unsatisfied child is never entered"), EnteredNodes.Contains(BlockedIndex));
+		TestTrue(TEXT("Both satisfied children are entered"), EnteredNodes.Num() == 2 && EnteredNodes.Contains(2) && EnteredNodes.Contains(3));
+		TestEqual(TEXT("Random selector fires its enter events"), Participant->NumBenchmarkFunctionCalls, NumSeeds);
+		Dialogue->RemoveFromRoot();
+	}
+
+	FDlgMemory::Get().Empty();
+	Participant->RemoveFromRoot();
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDlgSelectorSavedDataTest,
+	"DlgSystem.Nodes.SelectorSavedData",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter
+)
+
+bool FDlgSelectorSavedDataTest::RunTest(const FString& Parameters)
+{
+	using namespace DlgSelector;
+	static constexpr int32 NumSeeds = 16;
+
+	UDlgBenchmarkParticipant* Participant = NewObject<UDlgBenchmarkParticipant>(GetTransientPackage(), NAME_None, RF_Transient);
+	Participant->SetParticipantTag(TAG_Dlg_Hero);
+	Participant->AddToRoot();
+
+	UDlgDialogue* Dialogue = MakeDialogue(EDlgNodeSelectorType::Random);
+	Dialogue->AddToRoot();
+	UDlgNode_Selector* Selector = CastChecked<UDlgNode_Selector>(Dialogue->GetNodes()[SelectorIndex]);
+	Selector->SetCycleThroughSatisfiedOptionsWithoutRepetition(true);
+	const TArray<FDlgEdge> Children = Selector->GetNodeChildren();
+	auto GetSavedData = [Dialogue, Selector]() -> FDlgNodeSavedData&
+	{
+		return FDlgMemory::Get().FindOrAddEntry(Dialogue->GetGUID()).GetNodeData(Selector->GetGUID());
+	};
+
+	// Old save, node 2 was already picked
+	for (int32 Seed = 0; Seed < NumSeeds; Seed++)
+	{
+		FDlgMemory::Get().Empty();
+		GetSavedData().GUIDList = { Dialogue->GetNodeGUIDForIndex(2) };
+
+		const UDlgContext* Context = UDlgManager::StartDialogueWithRandomSeed(Dialogue, { Participant }, Seed);
+		if (TestNotNull(TEXT("Old save context"), Context))
+		{
+			TestEqual(TEXT("Node picked in the old save is not picked again"), Context->GetActiveNodeIndex(), 3);
+		}
+		TestEqual(TEXT("GUIDList is converted"), GetSavedData().GUIDList.Num(), 0);
+	}
+
+	// The used edges must follow their target nodes, not their positions
+	TArray<FDlgEdge> ReorderedChildren = Children;
+	ReorderedChildren.Swap(1, 2);
+	for (int32 Seed = 0; Seed < NumSeeds; Seed++)
+	{
+		FDlgMemory::Get().Empty();
+		Selector->SetNodeChildren(Children);
+		UDlgManager::StartDialogueWithRandomSeed(Dialogue, { Participant }, Seed);
+
+		Selector->SetNodeChildren(ReorderedChildren);
+		const UDlgContext* Context = UDlgManager::StartDialogueWithRandomSeed(Dialogue, { Participant }, Seed);
+		if (!TestNotNull(TEXT("Reordered context"), Context))
+		{
+			continue;
+		}
+
+		const FDlgNodeSavedData& SavedData = GetSavedData();
+		const int32 NumUsedEdges = (SavedData.IsEdgeUsed(1) ? 1 : 0) + (SavedData.IsEdgeUsed(2) ? 1 : 0);
+		const int32 EnteredEdgeIndex = ReorderedChildren.IndexOfByPredicate([Context](const FDlgEdge& Edge)
+		{
+			return Edge.TargetIndex == Context->GetActiveNodeIndex();
+		});
+		TestEqual(TEXT("Only the node picked after the reorder is used"), NumUsedEdges, 1);
+		TestTrue(TEXT("Used edge leads to the entered node"), SavedData.IsEdgeUsed(EnteredEdgeIndex));
+	}
+
+	Dialogue->RemoveFromRoot();
+	FDlgMemory::Get().Empty();
+	Participant->RemoveFromRoot();
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
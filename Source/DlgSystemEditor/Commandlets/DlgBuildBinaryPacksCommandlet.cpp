@@ -0,0 +1,159 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+
+#include "DlgBuildBinaryPacksCommandlet.h"
+
+#include "Misc/Paths.h"
+#include "DlgSystem/NYEngineVersionHelpers.h"
+
+#if NY_ENGINE_VERSION >= 500
+    #include "HAL/PlatformFileManager.h"
+#else
+    #include "HAL/PlatformFilemanager.h"
+#endif
+
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "UObject/Package.h"
+
+#include "DlgSystem/DlgManager.h"
+#include "DlgSystem/DlgDialogue.h"
+#include "DlgSystem/DlgHelper.h"
+#include "DlgSystem/Nodes/DlgNode.h"
+#include "DlgSystem/IO/DlgBinaryPack.h"
+#include "DlgSystem/IO/DlgBinaryParser.h"
+
+
+DEFINE_LOG_CATEGORY(LogDlgBuildBinaryPacksCommandlet);
+
+
+UDlgBuildBinaryPacksCommandlet::UDlgBuildBinaryPacksCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+	ShowErrorCount = true;
+}
+
+
+int32 UDlgBuildBinaryPacksCommandlet::Main(const FString& Params)
+{
+	UE_LOG(LogDlgBuildBinaryPacksCommandlet, Display, TEXT("Starting"));
+
+	// Parse command line - we're interested in the param vals
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> ParamVals;
+	UCommandlet::ParseCommandLine(*Params, Tokens, Switches, ParamVals);
+
+	bVerify = Switches.Contains(TEXT("Verify"));
+
+	// Set the output directory
+	const FString* OutputDirectoryVal = ParamVals.Find(FString(TEXT("OutputDirectory")));
+	if (OutputDirectoryVal == nullptr)
+	{
+		UE_LOG(LogDlgBuildBinaryPacksCommandlet, Error, TEXT("Did not provide argument -OutputDirectory=<Path>"));
+		return -1;
+	}
+	OutputDirectory = *OutputDirectoryVal;
+
+	if (OutputDirectory.IsEmpty())
+	{
+		UE_LOG(LogDlgBuildBinaryPacksCommandlet, Error, TEXT("OutputDirectory is empty, please provide a non empty one with -OutputDirectory=<Path>"));
+		return -1;
+	}
+
+	// Make it absolute
+	if (FPaths::IsRelative(OutputDirectory))
+	{
+		OutputDirectory = FPaths::Combine(FPaths::ProjectDir(), OutputDirectory);
+	}
+
+	// Create destination directory
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	if (!PlatformFile.DirectoryExists(*OutputDirectory) && PlatformFile.CreateDirectoryTree(*OutputDirectory))
+	{
+		UE_LOG(LogDlgBuildBinaryPacksCommandlet, Display, TEXT("Creating OutputDirectory = `%s`"), *OutputDirectory);
+	}
+
+	UDlgManager::LoadAllDialoguesIntoMemory();
+	UE_LOG(LogDlgBuildBinaryPacksCommandlet, Display, TEXT("Building binary packs to = `%s`"), *OutputDirectory);
+
+	int32 NumBuilt = 0;
+	int32 NumFailed = 0;
+	const TArray<UDlgDialogue*> AllDialogues = UDlgManager::GetAllDialoguesFromMemory();
+	for (const UDlgDialogue* Dialogue : AllDialogues)
+	{
+		UPackage* Package = Dialogue->GetOutermost();
+		check(Package);
+		const FString OriginalDialoguePath = Package->GetPathName();
+		FString DialoguePath = OriginalDialoguePath;
+
+		// Only export game dialogues
+		if (!FDlgHelper::IsPathInProjectDirectory(DialoguePath))
+		{
+			UE_LOG(LogDlgBuildBinaryPacksCommandlet, Warning, TEXT("Dialogue = `%s` is not in the game directory, ignoring"), *DialoguePath);
+			continue;
+		}
+
+		verify(DialoguePath.RemoveFromStart(TEXT("/Game")));
+		const FString FileName = FPaths::GetBaseFilename(DialoguePath);
+		const FString Directory = FPaths::GetPath(DialoguePath);
+
+		// Ensure directory tree
+		const FString FileSystemDirectoryPath = OutputDirectory / Directory;
+		if (!PlatformFile.DirectoryExists(*FileSystemDirectoryPath) && PlatformFile.CreateDirectoryTree(*FileSystemDirectoryPath))
+		{
+			UE_LOG(LogDlgBuildBinaryPacksCommandlet, Display, TEXT("Creating directory = `%s`"), *FileSystemDirectoryPath);
+		}
+		const FString FileSystemFilePath = FileSystemDirectoryPath / FileName + TEXT(".") + FDlgBinaryPack::FileExtension;
+
+		if (!Dialogue->ExportToBinaryPack(FileSystemFilePath))
+		{
+			UE_LOG(LogDlgBuildBinaryPacksCommandlet, Error, TEXT("FAILED to write binary pack for Dialogue = `%s` to file = `%s`"), *OriginalDialoguePath, *FileSystemFilePath);
+			NumFailed++;
+			continue;
+		}
+
+		if (bVerify && !VerifyBinaryPack(*Dialogue, FileSystemFilePath))
+		{
+			NumFailed++;
+			continue;
+		}
+
+		UE_LOG(LogDlgBuildBinaryPacksCommandlet, Display, TEXT("Dialogue = `%s` Built binary pack = `%s`"), *OriginalDialoguePath, *FileSystemFilePath);
+		NumBuilt++;
+	}
+
+	UE_LOG(LogDlgBuildBinaryPacksCommandlet, Display, TEXT("Built %d binary packs, %d failed"), NumBuilt, NumFailed);
+	return NumFailed > 0 ? -1 : 0;
+}
+
+bool UDlgBuildBinaryPacksCommandlet::VerifyBinaryPack(const UDlgDialogue& Dialogue, const FString& FilePath) const
+{
+	// Read it directly, ImportFromBinaryPack would complain about the duplicate GUID
+	FDlgBinaryParser Parser(FilePath);
+	if (!Parser.IsValidFile())
+	{
+		UE_LOG(LogDlgBuildBinaryPacksCommandlet, Error, TEXT("Verify FAILED, could not read binary pack = `%s`"), *FilePath);
+		return false;
+	}
+
+	UDlgDialogue* ImportedDialogue = NewObject<UDlgDialogue>(GetTransientPackage(), NAME_None, RF_Transient);
+	Parser.ReadAllProperty(UDlgDialogue::StaticClass(), ImportedDialogue, ImportedDialogue);
+
+	const TArray<UDlgNode*>& Nodes = Dialogue.GetNodes();
+	const TArray<UDlgNode*>& ImportedNodes = ImportedDialogue->GetNodes();
+	bool bIsValid = Nodes.Num() == ImportedNodes.Num() && Dialogue.GetStartNodes().Num() == ImportedDialogue->GetStartNodes().Num();
+	for (int32 NodeIndex = 0; bIsValid && NodeIndex < Nodes.Num(); NodeIndex++)
+	{
+		bIsValid = Nodes[NodeIndex]->GetClass() == ImportedNodes[NodeIndex]->GetClass() &&
+				   Nodes[NodeIndex]->GetGUID() == ImportedNodes[NodeIndex]->GetGUID() &&
+				   Nodes[NodeIndex]->GetNodeChildren().Num() == ImportedNodes[NodeIndex]->GetNodeChildren().Num();
+	}
+
+	if (!bIsValid)
+	{
+		UE_LOG(LogDlgBuildBinaryPacksCommandlet, Error, TEXT("Verify FAILED, binary pack = `%s` does not match Dialogue = `%s`"), *FilePath, *Dialogue.GetPathName());
+	}
+	return bIsValid;
+}
@@ -0,0 +1,39 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+
+#include "DlgBuildBinaryPacksCommandlet.generated.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogDlgBuildBinaryPacksCommandlet, All, All);
+
+
+class UDlgDialogue;
+
+
+/**
+ * Builds a binary pack (see FDlgBinaryWriter) for every game dialogue.
+ * Usage: -run=DlgBuildBinaryPacks -OutputDirectory=<Path> [-Verify]
+ *	-OutputDirectory: where the packs are written, the content directory structure is kept
+ *	-Verify: reads every pack back into a transient dialogue and compares it with the asset
+ */
+UCLASS()
+class UDlgBuildBinaryPacksCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UDlgBuildBinaryPacksCommandlet();
+
+public:
+
+	//~ UCommandlet interface
+	int32 Main(const FString& Params) override;
+
+	// Reads the pack at FilePath and checks that it matches the Dialogue
+	bool VerifyBinaryPack(const UDlgDialogue& Dialogue, const FString& FilePath) const;
+
+protected:
+	FString OutputDirectory;
+	bool bVerify = false;
+};
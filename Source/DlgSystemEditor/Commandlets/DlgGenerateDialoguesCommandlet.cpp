@@ -0,0 +1,108 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+
+#include "DlgGenerateDialoguesCommandlet.h"
+
+#include "FileHelpers.h"
+#include "UObject/Package.h"
+#include "UObject/UnrealType.h"
+
+#include "DlgSystem/DlgDialogue.h"
+#include "DlgSystem/DlgDialogueGenerator.h"
+#include "DlgSystem/NYEngineVersionHelpers.h"
+#include "DlgSystemEditor/DlgEditorUtilities.h"
+
+
+DEFINE_LOG_CATEGORY(LogDlgGenerateDialoguesCommandlet);
+
+
+UDlgGenerateDialoguesCommandlet::UDlgGenerateDialoguesCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+	ShowErrorCount = true;
+}
+
+
+int32 UDlgGenerateDialoguesCommandlet::Main(const FString& Params)
+{
+	UE_LOG(LogDlgGenerateDialoguesCommandlet, Display, TEXT("Starting"));
+
+	// Parse command line - we're interested in the param vals
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> ParamVals;
+	UCommandlet::ParseCommandLine(*Params, Tokens, Switches, ParamVals);
+
+	FString OutputPath = TEXT("/Game/Generated");
+	if (const FString* Value = ParamVals.Find(TEXT("OutputPath")))
+	{
+		OutputPath = *Value;
+		OutputPath.RemoveFromEnd(TEXT("/"));
+	}
+	if (!OutputPath.StartsWith(TEXT("/Game")))
+	{
+		UE_LOG(LogDlgGenerateDialoguesCommandlet, Error, TEXT("OutputPath = `%s` must be inside /Game"), *OutputPath);
+		return -1;
+	}
+
+	int32 Count = 1;
+	if (const FString* Value = ParamVals.Find(TEXT("Count")))
+	{
+		Count = FMath::Max(1, FCString::Atoi(**Value));
+	}
+
+	FString Prefix = TEXT("GeneratedDialogue");
+	if (const FString* Value = ParamVals.Find(TEXT("Prefix")))
+	{
+		Prefix = *Value;
+	}
+
+	// Every property of the options can be set from the command line
+	FDlgDialogueGeneratorOptions Options;
+	for (TFieldIterator<FProperty> It(FDlgDialogueGeneratorOptions::StaticStruct()); It; ++It)
+	{
+		const FProperty* Property = *It;
+		if (const FString* Value = ParamVals.Find(Property->GetName()))
+		{
+			void* ValuePtr = Property->ContainerPtrToValuePtr<void>(&Options);
+#if NY_ENGINE_VERSION >= 501
+			if (Property->ImportText_Direct(**Value, ValuePtr, nullptr, PPF_None) == nullptr)
+#else
+			if (Property->ImportText(**Value, ValuePtr, PPF_None, nullptr) == nullptr)
+#endif
+			{
+				UE_LOG(LogDlgGenerateDialoguesCommandlet, Error, TEXT("Invalid value = `%s` for -%s"), **Value, *Property->GetName());
+				return -1;
+			}
+		}
+	}
+
+	const int32 BaseSeed = Options.Seed;
+	TArray<UPackage*> PackagesToSave;
+	for (int32 Index = 0; Index < Count; Index++)
+	{
+		Options.Seed = BaseSeed + Index;
+		const FString AssetName = FString::Printf(TEXT("%s_%d"), *Prefix, Index);
+		UDlgDialogue* Dialogue = FDlgEditorUtilities::CreateGeneratedDialogue(OutputPath, AssetName, Options);
+		if (!Dialogue)
+		{
+			return -1;
+		}
+
+		UE_LOG(LogDlgGenerateDialoguesCommandlet, Display, TEXT("Generated Dialogue = `%s` with %d nodes (Seed = %d)"),
+			*Dialogue->GetPathName(), Dialogue->GetNodes().Num(), Options.Seed);
+		PackagesToSave.Add(Dialogue->GetOutermost());
+	}
+
+	static constexpr bool bCheckDirty = false;
+	if (!UEditorLoadingAndSavingUtils::SavePackages(PackagesToSave, bCheckDirty))
+	{
+		UE_LOG(LogDlgGenerateDialoguesCommandlet, Error, TEXT("FAILED to save the generated dialogues"));
+		return -1;
+	}
+
+	UE_LOG(LogDlgGenerateDialoguesCommandlet, Display, TEXT("Generated %d dialogues in `%s`"), PackagesToSave.Num(), *OutputPath);
+	return 0;
+}
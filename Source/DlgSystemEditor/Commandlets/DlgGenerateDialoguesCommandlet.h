@@ -0,0 +1,31 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+
+#include "DlgGenerateDialoguesCommandlet.generated.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogDlgGenerateDialoguesCommandlet, All, All);
+
+
+/**
+ * Generates and saves Dialogue assets with a configurable shape, used for scalability benchmarks.
+ * Usage: -run=DlgGenerateDialogues [-OutputPath=/Game/Generated] [-Count=<N>] [-Prefix=<Name>] [-<Option>=<Value> ...]
+ *	-OutputPath: long package path where the dialogues are created, must be inside /Game
+ *	-Count: number of dialogues, dialogue K uses Seed + K, default 1
+ *	-Prefix: asset name prefix, default GeneratedDialogue
+ *	-<Option>: any property of FDlgDialogueGeneratorOptions, e.g. -NumNodes=1000 -BranchingFactor=4 -ConditionDensity=0.5
+ */
+UCLASS()
+class UDlgGenerateDialoguesCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UDlgGenerateDialoguesCommandlet();
+
+public:
+
+	//~ UCommandlet interface
+	int32 Main(const FString& Params) override;
+};
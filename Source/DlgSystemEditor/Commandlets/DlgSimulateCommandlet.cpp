@@ -0,0 +1,407 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+
+#include "DlgSimulateCommandlet.h"
+
+#include "HAL/PlatformTime.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+
+#include "DlgSystem/DlgManager.h"
+#include "DlgSystem/DlgDialogue.h"
+#include "DlgSystem/DlgContext.h"
+#include "DlgSystem/DlgHelper.h"
+
+
+DEFINE_LOG_CATEGORY(LogDlgSimulateCommandlet);
+
+// Number of walks between garbage collections, every walk creates a new UDlgContext
+static constexpr int32 WalksPerGarbageCollection = 4096;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// UDlgSimulationParticipant
+void UDlgSimulationParticipant::ResetForWalk(FRandomStream* InStream)
+{
+	Stream = InStream;
+	FloatValues.Reset();
+	IntValues.Reset();
+	BoolValues.Reset();
+	NameValues.Reset();
+}
+
+bool UDlgSimulationParticipant::CheckCondition_Implementation(const UDlgContext* Context, FName ConditionName) const
+{
+	if (ValueMode == EDlgSimulationValueMode::Random && Stream)
+	{
+		return Stream->FRand() < 0.5f;
+	}
+
+	return true;
+}
+
+float UDlgSimulationParticipant::GetFloatValue_Implementation(FName ValueName) const
+{
+	if (ValueMode == EDlgSimulationValueMode::Random && Stream)
+	{
+		return Stream->FRandRange(-100.f, 100.f);
+	}
+
+	const float* Value = FloatValues.Find(ValueName);
+	return Value ? *Value : 0.f;
+}
+
+int32 UDlgSimulationParticipant::GetIntValue_Implementation(FName ValueName) const
+{
+	if (ValueMode == EDlgSimulationValueMode::Random && Stream)
+	{
+		return Stream->RandRange(-100, 100);
+	}
+
+	const int32* Value = IntValues.Find(ValueName);
+	return Value ? *Value : 0;
+}
+
+bool UDlgSimulationParticipant::GetBoolValue_Implementation(FName ValueName) const
+{
+	if (ValueMode == EDlgSimulationValueMode::Random && Stream)
+	{
+		return Stream->FRand() < 0.5f;
+	}
+
+	const bool* Value = BoolValues.Find(ValueName);
+	return Value ? *Value : false;
+}
+
+FName UDlgSimulationParticipant::GetNameValue_Implementation(FName ValueName) const
+{
+	// There is no sensible random name, the stored one is used in both modes
+	const FName* Value = NameValues.Find(ValueName);
+	return Value ? *Value : NAME_None;
+}
+
+bool UDlgSimulationParticipant::ModifyFloatValue_Implementation(FName ValueName, bool bDelta, float Value)
+{
+	float& StoredValue = FloatValues.FindOrAdd(ValueName);
+	StoredValue = bDelta ? StoredValue + Value : Value;
+	return true;
+}
+
+bool UDlgSimulationParticipant::ModifyIntValue_Implementation(FName ValueName, bool bDelta, int32 Value)
+{
+	int32& StoredValue = IntValues.FindOrAdd(ValueName);
+	StoredValue = bDelta ? StoredValue + Value : Value;
+	return true;
+}
+
+bool UDlgSimulationParticipant::ModifyBoolValue_Implementation(FName ValueName, bool bNewValue)
+{
+	BoolValues.FindOrAdd(ValueName) = bNewValue;
+	return true;
+}
+
+bool UDlgSimulationParticipant::ModifyNameValue_Implementation(FName ValueName, FName NameValue)
+{
+	NameValues.FindOrAdd(ValueName) = NameValue;
+	return true;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// FDlgSimulationStats
+int32 FDlgSimulationStats::GetNumVisitedNodes() const
+{
+	int32 NumVisited = 0;
+	for (const int64 Visits : NodeVisits)
+	{
+		if (Visits > 0)
+		{
+			NumVisited++;
+		}
+	}
+	return NumVisited;
+}
+
+float FDlgSimulationStats::GetCoveragePercent() const
+{
+	return NodeVisits.Num() > 0 ? 100.f * GetNumVisitedNodes() / NodeVisits.Num() : 100.f;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// UDlgSimulateCommandlet
+UDlgSimulateCommandlet::UDlgSimulateCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+	ShowErrorCount = true;
+}
+
+int32 UDlgSimulateCommandlet::Main(const FString& Params)
+{
+	UE_LOG(LogDlgSimulateCommandlet, Display, TEXT("Starting"));
+
+	// Parse command line - we're interested in the param vals
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> ParamVals;
+	UCommandlet::ParseCommandLine(*Params, Tokens, Switches, ParamVals);
+
+	if (const FString* Value = ParamVals.Find(TEXT("Walks")))
+	{
+		NumWalks = FMath::Max(1, FCString::Atoi(**Value));
+	}
+	if (const FString* Value = ParamVals.Find(TEXT("MaxSteps")))
+	{
+		MaxSteps = FMath::Max(1, FCString::Atoi(**Value));
+	}
+	if (const FString* Value = ParamVals.Find(TEXT("Seed")))
+	{
+		Seed = FCString::Atoi(**Value);
+	}
+	if (const FString* Value = ParamVals.Find(TEXT("ValueMode")))
+	{
+		if (Value->Equals(TEXT("Stateful"), ESearchCase::IgnoreCase))
+		{
+			ValueMode = EDlgSimulationValueMode::Stateful;
+		}
+		else if (!Value->Equals(TEXT("Random"), ESearchCase::IgnoreCase))
+		{
+			UE_LOG(LogDlgSimulateCommandlet, Error, TEXT("Unknown -ValueMode = `%s`, expected Random or Stateful"), **Value);
+			return -1;
+		}
+	}
+	if (const FString* Value = ParamVals.Find(TEXT("Dialogue")))
+	{
+		DialogueFilter = *Value;
+	}
+	if (const FString* Value = ParamVals.Find(TEXT("MinStepsPerSecond")))
+	{
+		MinStepsPerSecond = FCString::Atod(**Value);
+	}
+
+	LatencySamples.Reset();
+	NumLatencySamplesSeen = 0;
+	bLatencySamplesSorted = false;
+	SamplingStream.Initialize(Seed);
+
+	UDlgManager::LoadAllDialoguesIntoMemory();
+	const TArray<UDlgDialogue*> AllDialogues = UDlgManager::GetAllDialoguesFromMemory();
+	UE_LOG(LogDlgSimulateCommandlet, Display, TEXT("Simulating %d walks per Dialogue, MaxSteps = %d, Seed = %d, ValueMode = %s"),
+		NumWalks, MaxSteps, Seed, ValueMode == EDlgSimulationValueMode::Random ? TEXT("Random") : TEXT("Stateful"));
+
+	int32 NumSimulatedDialogues = 0;
+	int64 TotalSteps = 0;
+	int64 TotalDeadEnds = 0;
+	double TotalSeconds = 0.0;
+	for (UDlgDialogue* Dialogue : AllDialogues)
+	{
+		UPackage* Package = Dialogue->GetOutermost();
+		check(Package);
+		const FString OriginalDialoguePath = Package->GetPathName();
+
+		// Only simulate game dialogues
+		if (!FDlgHelper::IsPathInProjectDirectory(OriginalDialoguePath))
+		{
+			UE_LOG(LogDlgSimulateCommandlet, Verbose, TEXT("Dialogue = `%s` is not in the game directory, ignoring"), *OriginalDialoguePath);
+			continue;
+		}
+		if (!DialogueFilter.IsEmpty() && !Dialogue->GetDialogueName().Contains(DialogueFilter))
+		{
+			continue;
+		}
+
+		FDlgSimulationStats Stats;
+		if (!SimulateDialogue(*Dialogue, Stats))
+		{
+			continue;
+		}
+
+		NumSimulatedDialogues++;
+		TotalSteps += Stats.NumSteps;
+		TotalDeadEnds += Stats.NumDeadEnds;
+		TotalSeconds += Stats.Seconds;
+
+		const double StepsPerSecond = Stats.Seconds > 0.0 ? Stats.NumSteps / Stats.Seconds : 0.0;
+		UE_LOG(LogDlgSimulateCommandlet, Display,
+			TEXT("Dialogue = `%s`: Walks = %d, Steps = %lld, Steps/sec = %.0f, Coverage = %d/%d nodes (%.1f%%), DeadEnds = %d, FailedStarts = %d, TruncatedWalks = %d"),
+			*OriginalDialoguePath, Stats.NumWalks, Stats.NumSteps, StepsPerSecond,
+			Stats.GetNumVisitedNodes(), Stats.NodeVisits.Num(), Stats.GetCoveragePercent(),
+			Stats.NumDeadEnds, Stats.NumFailedStarts, Stats.NumTruncatedWalks);
+
+		for (int32 NodeIndex = 0; NodeIndex < Stats.NodeVisits.Num(); NodeIndex++)
+		{
+			if (Stats.NodeVisits[NodeIndex] == 0)
+			{
+				UE_LOG(LogDlgSimulateCommandlet, Display, TEXT("\tNode index = %d was never visited"), NodeIndex);
+			}
+		}
+		for (const int32 NodeIndex : Stats.DeadEndNodes)
+		{
+			UE_LOG(LogDlgSimulateCommandlet, Display, TEXT("\tDead end at node index = %d"), NodeIndex);
+		}
+	}
+
+	const double TotalStepsPerSecond = TotalSeconds > 0.0 ? TotalSteps / TotalSeconds : 0.0;
+	UE_LOG(LogDlgSimulateCommandlet, Display,
+		LINE_TERMINATOR TEXT("Simulation:") LINE_TERMINATOR
+		TEXT("Dialogues = %d") LINE_TERMINATOR
+		TEXT("Steps = %lld") LINE_TERMINATOR
+		TEXT("Steps/sec = %.0f") LINE_TERMINATOR
+		TEXT("DeadEnds = %lld") LINE_TERMINATOR
+		TEXT("Step latency p50 = %.3f us, p99 = %.3f us"),
+		NumSimulatedDialogues, TotalSteps, TotalStepsPerSecond, TotalDeadEnds,
+		GetLatencyPercentileMicroseconds(0.5f), GetLatencyPercentileMicroseconds(0.99f));
+
+	// Do not leave the history of the walks behind
+	UDlgManager::ClearDialogueHistory();
+
+	if (MinStepsPerSecond > 0.0 && TotalStepsPerSecond < MinStepsPerSecond)
+	{
+		UE_LOG(LogDlgSimulateCommandlet, Error, TEXT("Steps/sec = %.0f is below -MinStepsPerSecond = %.0f"), TotalStepsPerSecond, MinStepsPerSecond);
+		return -1;
+	}
+
+	return 0;
+}
+
+bool UDlgSimulateCommandlet::SimulateDialogue(UDlgDialogue& Dialogue, FDlgSimulationStats& OutStats)
+{
+	// One mock participant for every participant of the Dialogue
+	TArray<UObject*> Participants;
+	TArray<UDlgSimulationParticipant*> SimulationParticipants;
+	for (const FGameplayTag& ParticipantTag : Dialogue.GetParticipantTags())
+	{
+		auto* Participant = NewObject<UDlgSimulationParticipant>(GetTransientPackage());
+		Participant->Initialize(ParticipantTag, ValueMode);
+		Participant->AddToRoot();
+		SimulationParticipants.Add(Participant);
+		Participants.Add(Participant);
+	}
+	if (Participants.Num() == 0)
+	{
+		UE_LOG(LogDlgSimulateCommandlet, Warning, TEXT("Dialogue = `%s` has no participants, ignoring"), *Dialogue.GetPathName());
+		return false;
+	}
+
+	// The contexts do not reference the Dialogue strongly enough to survive the garbage collection
+	Dialogue.AddToRoot();
+	OutStats.NodeVisits.SetNumZeroed(Dialogue.GetNodes().Num());
+
+	uint64 WalkCycles = 0;
+	for (int32 WalkIndex = 0; WalkIndex < NumWalks; WalkIndex++)
+	{
+		// Every walk is independent and reproducible
+		FRandomStream Stream(Seed + WalkIndex);
+		for (UDlgSimulationParticipant* Participant : SimulationParticipants)
+		{
+			Participant->ResetForWalk(&Stream);
+		}
+		UDlgManager::ClearDialogueHistory();
+		OutStats.NumWalks++;
+
+		const uint64 WalkStartCycles = FPlatformTime::Cycles64();
+		uint64 StepStartCycles = WalkStartCycles;
+		UDlgContext* Context = UDlgManager::StartDialogueWithRandomSeed(&Dialogue, Participants, Seed + WalkIndex);
+		uint64 StepEndCycles = FPlatformTime::Cycles64();
+		AddLatencySample(StepEndCycles - StepStartCycles);
+		if (Context == nullptr)
+		{
+			// Could not start or ended right away
+			OutStats.NumFailedStarts++;
+			WalkCycles += StepEndCycles - WalkStartCycles;
+			continue;
+		}
+		OutStats.NumSteps++;
+
+		for (int32 Step = 0; !Context->HasDialogueEnded(); Step++)
+		{
+			const int32 NumOptions = Context->GetOptionsNum();
+			if (NumOptions == 0)
+			{
+				OutStats.NumDeadEnds++;
+				OutStats.DeadEndNodes.Add(Context->GetActiveNodeIndex());
+				break;
+			}
+			if (Step >= MaxSteps)
+			{
+				OutStats.NumTruncatedWalks++;
+				break;
+			}
+
+			const int32 OptionIndex = Stream.RandHelper(NumOptions);
+			StepStartCycles = FPlatformTime::Cycles64();
+			const bool bStillActive = Context->ChooseOption(OptionIndex);
+			StepEndCycles = FPlatformTime::Cycles64();
+			AddLatencySample(StepEndCycles - StepStartCycles);
+			OutStats.NumSteps++;
+
+			if (!bStillActive)
+			{
+				break;
+			}
+		}
+		WalkCycles += FPlatformTime::Cycles64() - WalkStartCycles;
+
+		// Proxies, selectors and the end nodes are passed through inside a step, the history has every entered node
+		for (const int32 NodeIndex : Context->GetHistoryOfThisContext().VisitedNodeIndices)
+		{
+			if (OutStats.NodeVisits.IsValidIndex(NodeIndex))
+			{
+				OutStats.NodeVisits[NodeIndex]++;
+			}
+		}
+
+		if ((WalkIndex + 1) % WalksPerGarbageCollection == 0)
+		{
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		}
+	}
+	OutStats.Seconds = FPlatformTime::ToSeconds64(WalkCycles);
+
+	for (UDlgSimulationParticipant* Participant : SimulationParticipants)
+	{
+		Participant->ResetForWalk(nullptr);
+		Participant->RemoveFromRoot();
+	}
+	Dialogue.RemoveFromRoot();
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+	return true;
+}
+
+void UDlgSimulateCommandlet::AddLatencySample(uint64 Cycles)
+{
+	// Reservoir sampling
+	NumLatencySamplesSeen++;
+	bLatencySamplesSorted = false;
+	if (LatencySamples.Num() < MaxLatencySamples)
+	{
+		LatencySamples.Add(Cycles);
+		return;
+	}
+
+	const int64 ReplaceIndex = static_cast<int64>(SamplingStream.GetFraction() * NumLatencySamplesSeen);
+	if (ReplaceIndex < MaxLatencySamples)
+	{
+		LatencySamples[ReplaceIndex] = Cycles;
+	}
+}
+
+double UDlgSimulateCommandlet::GetLatencyPercentileMicroseconds(float Percentile)
+{
+	if (LatencySamples.Num() == 0)
+	{
+		return 0.0;
+	}
+
+	if (!bLatencySamplesSorted)
+	{
+		LatencySamples.Sort();
+		bLatencySamplesSorted = true;
+	}
+
+	const int32 Index = FMath::Clamp(FMath::FloorToInt(Percentile * (LatencySamples.Num() - 1)), 0, LatencySamples.Num() - 1);
+	return FPlatformTime::ToSeconds64(LatencySamples[Index]) * 1000000.0;
+}
@@ -0,0 +1,156 @@
+// Copyright Csaba Molnar, Daniel Butum. All Rights Reserved.
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "Math/RandomStream.h"
+#include "GameplayTagContainer.h"
+
+#include "DlgSystem/DlgDialogueParticipant.h"
+
+#include "DlgSimulateCommandlet.generated.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogDlgSimulateCommandlet, All, All);
+
+
+class UDlgDialogue;
+
+
+// How the mock participants answer the dialogue conditions
+enum class EDlgSimulationValueMode : uint8
+{
+	// Every condition and value is drawn from the random stream of the walk
+	Random,
+
+	// Values start at zero/false/None and are only changed by the dialogue events, named conditions are always true
+	Stateful
+};
+
+
+/**
+ * Participant used by UDlgSimulateCommandlet, does not need a world.
+ * Answers the conditions depending on the EDlgSimulationValueMode.
+ */
+UCLASS(Transient)
+class UDlgSimulationParticipant : public UObject, public IDlgDialogueParticipant
+{
+	GENERATED_BODY()
+
+public:
+	void Initialize(const FGameplayTag& InParticipantTag, EDlgSimulationValueMode InValueMode)
+	{
+		ParticipantTag = InParticipantTag;
+		ValueMode = InValueMode;
+	}
+
+	// Starts a new walk, the stream must outlive the walk
+	void ResetForWalk(FRandomStream* InStream);
+
+	// IDlgDialogueParticipant Interface
+	FGameplayTag GetParticipantTag_Implementation() const override { return ParticipantTag; }
+	FText GetParticipantDisplayName_Implementation(const FGameplayTag& ActiveSpeaker) const override { return FText::FromName(ParticipantTag.GetTagName()); }
+	ETextGender GetParticipantGender_Implementation() const override { return ETextGender::Neuter; }
+	UTexture2D* GetParticipantIcon_Implementation(const FGameplayTag& ActiveSpeaker, FName ActiveSpeakerState) const override { return nullptr; }
+
+	bool CheckCondition_Implementation(const UDlgContext* Context, FName ConditionName) const override;
+	float GetFloatValue_Implementation(FName ValueName) const override;
+	int32 GetIntValue_Implementation(FName ValueName) const override;
+	bool GetBoolValue_Implementation(FName ValueName) const override;
+	FName GetNameValue_Implementation(FName ValueName) const override;
+
+	bool OnDialogueEvent_Implementation(UDlgContext* Context, FName EventName) override { return true; }
+	bool ModifyFloatValue_Implementation(FName ValueName, bool bDelta, float Value) override;
+	bool ModifyIntValue_Implementation(FName ValueName, bool bDelta, int32 Value) override;
+	bool ModifyBoolValue_Implementation(FName ValueName, bool bNewValue) override;
+	bool ModifyNameValue_Implementation(FName ValueName, FName NameValue) override;
+
+protected:
+	FGameplayTag ParticipantTag;
+	EDlgSimulationValueMode ValueMode = EDlgSimulationValueMode::Random;
+
+	// Owned by the commandlet
+	FRandomStream* Stream = nullptr;
+
+	// Used by EDlgSimulationValueMode::Stateful
+	TMap<FName, float> FloatValues;
+	TMap<FName, int32> IntValues;
+	TMap<FName, bool> BoolValues;
+	TMap<FName, FName> NameValues;
+};
+
+
+// Results of simulating a single Dialogue
+struct FDlgSimulationStats
+{
+public:
+	int32 NumWalks = 0;
+	int32 NumFailedStarts = 0;
+	int64 NumSteps = 0;
+
+	// Walk stopped on a node that has no satisfied option, the dialogue did not end
+	int32 NumDeadEnds = 0;
+
+	// Walk reached MaxSteps
+	int32 NumTruncatedWalks = 0;
+
+	double Seconds = 0.0;
+
+	// Index is the node index, value is the number of walks that entered the node
+	TArray<int64> NodeVisits;
+
+	// Node indices where the dead ends happened
+	TSet<int32> DeadEndNodes;
+
+	int32 GetNumVisitedNodes() const;
+	float GetCoveragePercent() const;
+};
+
+
+/**
+ * Runs seeded random walks through the dialogues with mock participants, no world or RHI required.
+ * Usage: -run=DlgSimulate [-Walks=<N>] [-MaxSteps=<N>] [-Seed=<N>] [-ValueMode=Random|Stateful] [-Dialogue=<Name>] [-MinStepsPerSecond=<N>]
+ *	-Walks: number of walks for every dialogue, default 100000
+ *	-MaxSteps: a walk is stopped after this many options, default 256
+ *	-Seed: every walk uses Seed + WalkIndex for the option picks, the participant values and the random selectors, so a walk can be reproduced
+ *	-ValueMode: see EDlgSimulationValueMode, default Random
+ *	-Dialogue: only simulate the dialogues whose name contains this
+ *	-MinStepsPerSecond: fails the commandlet if the total throughput is below this, used for gating performance regressions
+ * Reports steps/sec, per node visit coverage, dead ends and the p50/p99 step latency.
+ * Example: UnrealEditor-Cmd <Project> -run=DlgSimulate -nullrhi -unattended -Walks=1000000
+ */
+UCLASS()
+class UDlgSimulateCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UDlgSimulateCommandlet();
+
+public:
+
+	//~ UCommandlet interface
+	int32 Main(const FString& Params) override;
+
+	// Runs NumWalks for the Dialogue
+	bool SimulateDialogue(UDlgDialogue& Dialogue, FDlgSimulationStats& OutStats);
+
+protected:
+	// Keeps a uniform sample of the step latencies, storing millions of them is not needed for the percentiles
+	void AddLatencySample(uint64 Cycles);
+	double GetLatencyPercentileMicroseconds(float Percentile);
+
+protected:
+	int32 NumWalks = 100000;
+	int32 MaxSteps = 256;
+	int32 Seed = 0;
+	EDlgSimulationValueMode ValueMode = EDlgSimulationValueMode::Random;
+	FString DialogueFilter;
+	double MinStepsPerSecond = 0.0;
+
+	static constexpr int32 MaxLatencySamples = 1 << 20;
+	TArray<uint64> LatencySamples;
+	int64 NumLatencySamplesSeen = 0;
+	bool bLatencySamplesSorted = false;
+
+	// Used for the reservoir sampling
+	FRandomStream SamplingStream;
+};
@@ -11,6 +11,7 @@
 #include "Kismet2/SClassPickerDialog.h"
 #include "Runtime/Launch/Resources/Version.h"
 #include "Engine/Blueprint.h"
+#include "AssetRegistry/AssetRegistryModule.h"
 
 #include "DlgSystemEditorModule.h"
 #include "Editor/IDlgEditor.h"
@@ -18,6 +19,7 @@
 #include "Editor/Nodes/DialogueGraphNode_Edge.h"
 #include "DlgSystem/DlgHelper.h"
 #include "DlgSystem/DlgManager.h"
+#include "DlgSystem/DlgDialogueGenerator.h"
 #include "Factories/DlgClassViewerFilters.h"
 #include "Kismet2/KismetEditorUtilities.h"
 #include "K2Node_Event.h"
@@ -49,7 +51,9 @@ void FDlgEditorUtilities::LoadAllDialoguesAndCheckGUIDs()
 	// - duplicated files outside of UE
 	// - somehow loaded from text files?
 	// - the universe hates us? +_+
-	for (UDlgDialogue* Dialogue : UDlgManager::GetDialoguesWithDuplicateGUIDs())
+	// NOTE: uses the GUID index of the UDlgManager, the dialogues are not compared with each other
+	const TArray<UDlgDialogue*> DuplicateDialogues = UDlgManager::GetDialoguesWithDuplicateGUIDs();
+	for (UDlgDialogue* Dialogue : DuplicateDialogues)
 	{
 		UE_LOG(
 			LogDlgSystemEditor,
@@ -63,8 +67,14 @@ void FDlgEditorUtilities::LoadAllDialoguesAndCheckGUIDs()
 
 	// Give it another try, Give up :((
 	// May the math Gods have mercy on us!
-	for (const UDlgDialogue* Dialogue : UDlgManager::GetDialoguesWithDuplicateGUIDs())
+	// Only the regenerated dialogues can still collide
+	for (const UDlgDialogue* Dialogue : DuplicateDialogues)
 	{
+		if (!UDlgManager::HasDialogueDuplicateGUID(Dialogue))
+		{
+			continue;
+		}
+
 		// GUID already exists (╯°□°）╯︵ ┻━┻
 		// Does this break the universe?
 		UE_LOG(
@@ -913,6 +923,42 @@ UDlgDialogue* FDlgEditorUtilities::GetDialogueFromGraphNode(const UEdGraphNode*
 	return nullptr;
 }
 
+UDlgDialogue* FDlgEditorUtilities::CreateGeneratedDialogue(const FString& PackagePath, const FString& AssetName, const FDlgDialogueGeneratorOptions& Options)
+{
+	const FString PackageName = PackagePath / AssetName;
+#if NY_ENGINE_VERSION >= 426
+	UPackage* Package = CreatePackage(*PackageName);
+#else
+	UPackage* Package = CreatePackage(nullptr, *PackageName);
+#endif
+	if (!Package)
+	{
+		UE_LOG(LogDlgSystemEditor, Error, TEXT("CreateGeneratedDialogue - Could not create package = `%s`"), *PackageName);
+		return nullptr;
+	}
+
+	// Regenerate the existing one
+	UDlgDialogue* Dialogue = FindObject<UDlgDialogue>(Package, *AssetName);
+	const bool bIsNewAsset = Dialogue == nullptr;
+	if (bIsNewAsset)
+	{
+		Dialogue = NewObject<UDlgDialogue>(Package, FName(*AssetName), RF_Public | RF_Standalone | RF_Transactional);
+	}
+
+	FDlgDialogueGenerator::Generate(*Dialogue, Options);
+	CheckAndTryToFixDialogue(Dialogue, false);
+
+	// This will trigger the CreateDefaultNodesForGraph in the the GraphSchema, which creates the graph nodes from the dialogue nodes
+	Dialogue->ClearGraph();
+
+	if (bIsNewAsset)
+	{
+		FAssetRegistryModule::AssetCreated(Dialogue);
+	}
+	Dialogue->MarkPackageDirty();
+	return Dialogue;
+}
+
 bool FDlgEditorUtilities::SaveAllDialogues()
 {
 	const TArray<UDlgDialogue*> Dialogues = UDlgManager::GetAllDialoguesFromMemory();
@@ -23,6 +23,7 @@ class UDlgNode;
 class UEdGraph;
 class FSlateRect;
 class UK2Node_Event;
+struct FDlgDialogueGeneratorOptions;
 
 class DLGSYSTEMEDITOR_API FDlgEditorUtilities
 {
@@ -231,6 +232,13 @@ public:
 	// @return True on success or false on failure.
 	static bool DeleteAllDialoguesTextFiles();
 
+	/**
+	 * Creates (or regenerates) the Dialogue asset PackagePath/AssetName with generated nodes, see FDlgDialogueGenerator.
+	 * The graph nodes are rebuilt from the generated dialogue nodes. The package is marked dirty but not saved.
+	 * @return the Dialogue or nullptr if the package could not be created
+	 */
+	static UDlgDialogue* CreateGeneratedDialogue(const FString& PackagePath, const FString& AssetName, const FDlgDialogueGeneratorOptions& Options);
+
 	/***
 	* Pops up a class picker dialog to choose the class that is a child of the Classprovided.
 	*
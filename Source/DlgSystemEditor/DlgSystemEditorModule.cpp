@@ -284,6 +284,17 @@ void FDlgSystemEditorModule::ShutdownModule()
 	{
 		FCoreDelegates::OnPostEngineInit.Remove(OnPostEngineInitHandle);
 	}
+	if (GEditor)
+	{
+		if (OnBlueprintCompiledHandle.IsValid())
+		{
+			GEditor->OnBlueprintCompiled().Remove(OnBlueprintCompiledHandle);
+		}
+		if (OnClassPackageLoadedOrUnloadedHandle.IsValid())
+		{
+			GEditor->OnClassPackageLoadedOrUnloaded().Remove(OnClassPackageLoadedOrUnloadedHandle);
+		}
+	}
 
 	UE_LOG(LogDlgSystemEditor, Log, TEXT("DlgSystemEditorModule: ShutdownModule"));
 }
@@ -332,6 +343,13 @@ void FDlgSystemEditorModule::HandleOnPostEngineInit()
 {
 	bIsEngineInitialized = true;
 	UE_LOG(LogDlgSystemEditor, Log, TEXT("DlgSystemEditorModule::HandleOnPostEngineInit"));
+
+	// Compiled or (un)loaded blueprints can change the participant classes
+	if (GEditor)
+	{
+		OnBlueprintCompiledHandle = GEditor->OnBlueprintCompiled().AddStatic(&UDlgManager::InvalidateParticipantClassesIndex);
+		OnClassPackageLoadedOrUnloadedHandle = GEditor->OnClassPackageLoadedOrUnloaded().AddStatic(&UDlgManager::InvalidateParticipantClassesIndex);
+	}
 }
 
 void FDlgSystemEditorModule::HandleOnBeginPIE(bool bIsSimulating)
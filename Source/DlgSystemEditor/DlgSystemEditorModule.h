@@ -105,6 +105,8 @@ private:
 	FDelegateHandle OnBeginPIEHandle;
 	FDelegateHandle OnPostPIEStartedHandle; // after BeginPlay() has been called
 	FDelegateHandle OnEndPIEHandle;
+	FDelegateHandle OnBlueprintCompiledHandle;
+	FDelegateHandle OnClassPackageLoadedOrUnloadedHandle;
 
 	// Flags
 	bool bIsEngineInitialized = false;